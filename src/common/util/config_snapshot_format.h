@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************
+ *
+ * Layout of the configuration snapshot written by the SCC configurer. The file starts with magic[8] followed by
+ * sources. All numbers are unsigned LEB128 encoded (7 bits per byte, low bits first), signed numbers are zigzag
+ * encoded before.
+ *
+ *   source : input file name, overrides hash, number of files, files, number of values, values
+ *   file   : name, size, hash of the content
+ *   value  : name, type, payload
+ *
+ * A source holds the values read from an input file in the order they have been applied, the files list the input
+ * file itself and all files included while reading it. The overrides hash is the hash of the values set by the
+ * application (e.g. from the command line) before the input file was read, a source is only used by runs applying
+ * the same overrides. Strings are stored as length and characters, the names of
+ * values are stored as the length of the prefix shared with the previous name within the source followed by the
+ * remaining string. The payload depends on the type:
+ *
+ *   BOOL, UINT, UINT64 : the value
+ *   INT, INT64         : the zigzag encoded value
+ *   DOUBLE             : the 8 bytes of the IEEE754 representation, little endian
+ *   STRING, JSON       : the string respectively its JSON representation
+ */
+
+#ifndef _UTIL_CONFIG_SNAPSHOT_FORMAT_H_
+#define _UTIL_CONFIG_SNAPSHOT_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace util {
+namespace config_snapshot {
+//! the file identification, the last byte denotes the version
+static constexpr char magic[8] = {'S', 'C', 'C', 'C', 'F', 'G', 'S', 2};
+
+enum value_type : uint8_t { BOOL = 1, INT = 2, INT64 = 3, UINT = 4, UINT64 = 5, DOUBLE = 6, STRING = 7, JSON = 8 };
+//! appends v LEB128 encoded to buf
+inline void put(std::vector<uint8_t>& buf, uint64_t v) {
+    while(v >= 0x80) {
+        buf.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(static_cast<uint8_t>(v));
+}
+
+inline void put_signed(std::vector<uint8_t>& buf, int64_t v) {
+    put(buf, (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+inline void put_string(std::vector<uint8_t>& buf, std::string const& s) {
+    put(buf, s.size());
+    buf.insert(buf.end(), s.begin(), s.end());
+}
+
+inline void put_double(std::vector<uint8_t>& buf, double d) {
+    uint64_t v;
+    memcpy(&v, &d, sizeof(v));
+    for(unsigned i = 0; i < 8; ++i, v >>= 8)
+        buf.push_back(static_cast<uint8_t>(v));
+}
+/**
+ * @fn bool get(uint8_t const*&, uint8_t const*, uint64_t&)
+ * @brief decodes a LEB128 number and advances p behind it
+ *
+ * @return false if the number is not complete before end
+ */
+inline bool get(uint8_t const*& p, uint8_t const* end, uint64_t& v) {
+    v = 0;
+    for(unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        auto b = *p++;
+        v |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if(!(b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+inline bool get_signed(uint8_t const*& p, uint8_t const* end, int64_t& v) {
+    uint64_t u;
+    if(!get(p, end, u))
+        return false;
+    v = static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+    return true;
+}
+
+inline bool get_string(uint8_t const*& p, uint8_t const* end, std::string& s) {
+    uint64_t len;
+    if(!get(p, end, len) || static_cast<uint64_t>(end - p) < len)
+        return false;
+    s.assign(reinterpret_cast<char const*>(p), len);
+    p += len;
+    return true;
+}
+
+inline bool get_double(uint8_t const*& p, uint8_t const* end, double& d) {
+    if(end - p < 8)
+        return false;
+    uint64_t v = 0;
+    for(unsigned i = 0; i < 8; ++i)
+        v |= static_cast<uint64_t>(*p++) << (8 * i);
+    memcpy(&d, &v, sizeof(d));
+    return true;
+}
+//! the offset basis of the 64bit FNV-1a hash
+static constexpr uint64_t hash_basis = 0xcbf29ce484222325ULL;
+//! continues the 64bit FNV-1a hash over size bytes of data
+inline uint64_t hash_bytes(uint64_t hash, char const* data, size_t size) {
+    for(size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+/**
+ * @fn bool hash_file(const std::string&, uint64_t&, uint64_t&)
+ * @brief calculates the 64bit FNV-1a hash of the content of a file
+ *
+ * @return false if the file cannot be read
+ */
+inline bool hash_file(std::string const& name, uint64_t& size, uint64_t& hash) {
+    std::ifstream ifs(name, std::ios::in | std::ios::binary);
+    if(!ifs.is_open())
+        return false;
+    std::vector<char> buf(64 * 1024);
+    size = 0;
+    hash = hash_basis;
+    while(ifs) {
+        ifs.read(buf.data(), buf.size());
+        auto count = ifs.gcount();
+        hash = hash_bytes(hash, buf.data(), count);
+        size += count;
+    }
+    return !ifs.bad();
+}
+/**
+ * @class hashing_streambuf
+ * @brief an input stream buffer passing the bytes of another stream buffer and calculating their 64bit FNV-1a hash
+ *
+ * As the hash is taken from the very bytes being consumed by a parser it matches the values parsed even if the file
+ * is modified while or after being read.
+ */
+class hashing_streambuf : public std::streambuf {
+public:
+    explicit hashing_streambuf(std::streambuf& src)
+    : src(src) {}
+    //! consumes the remaining bytes of the source so that size and hash cover all of its content
+    void drain() {
+        // the bytes still buffered are hashed already
+        do
+            setg(buf, buf, buf);
+        while(underflow() != traits_type::eof());
+    }
+    //! the number of bytes read so far
+    uint64_t size() const { return count; }
+    //! the hash of the bytes read so far
+    uint64_t hash() const { return hsh; }
+
+protected:
+    int_type underflow() override {
+        if(gptr() < egptr())
+            return traits_type::to_int_type(*gptr());
+        auto n = src.sgetn(buf, sizeof(buf));
+        if(n <= 0)
+            return traits_type::eof();
+        hsh = hash_bytes(hsh, buf, static_cast<size_t>(n));
+        count += n;
+        setg(buf, buf, buf + n);
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    std::streambuf& src;
+    char buf[16 * 1024];
+    uint64_t count{0};
+    uint64_t hsh{hash_basis};
+};
+} // namespace config_snapshot
+} // namespace util
+#endif /* _UTIL_CONFIG_SNAPSHOT_FORMAT_H_ */
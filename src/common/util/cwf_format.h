@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************
+ *
+ * Layout of the columnar waveform format (CWF):
+ *
+ *   header    : magic[8]
+ *   blocks    : LZ4 compressed (or raw if not compressible) columnar blocks, one signal per block
+ *   directory : i8 timescale, u32 #signals {u32 len, name, u32 bits, u8 kind, u32 alias},
+ *               u64 #blocks {u32 signal, u32 count, u64 first time, u64 last time, u64 offset, u32 raw size, u32 size}
+ *   trailer   : u64 directory offset, u64 end time, magic[8]
+ *
+ * A decompressed block holds the LEB128 encoded time deltas of all entries (the first one relative to the first time
+ * of the block) followed by the bit-packed values. All numbers are stored little endian.
+ */
+
+#ifndef _UTIL_CWF_FORMAT_H_
+#define _UTIL_CWF_FORMAT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace util {
+namespace cwf {
+//! the file identification, the last byte denotes the version
+static constexpr char magic[8] = {'S', 'C', 'C', 'C', 'W', 'F', 0, 1};
+//! the default number of value changes per block
+static constexpr unsigned default_block_entries = 4096;
+/**
+ * @enum value_kind
+ * @brief determines how values of a signal are packed
+ */
+enum class value_kind : uint8_t {
+    TWO_STATE = 0,  //!< 1 bit per bit
+    FOUR_STATE = 1, //!< 2 bits per bit (0, 1, x, z)
+    REAL = 2        //!< IEEE 754 double
+};
+/**
+ * @struct signal_desc
+ * @brief description of a signal stored in a CWF file
+ */
+struct signal_desc {
+    std::string name;
+    uint32_t bits{1};
+    value_kind kind{value_kind::TWO_STATE};
+    //! the id of the signal holding the values, equals the own id if the signal is not an alias
+    uint32_t alias{0};
+};
+/**
+ * @struct block_desc
+ * @brief entry of the block index
+ */
+struct block_desc {
+    uint32_t signal{0};
+    uint32_t count{0};
+    uint64_t first_time{0};
+    uint64_t last_time{0};
+    uint64_t offset{0};
+    uint32_t raw_size{0};
+    //! the stored size, equal to raw_size if the block is not compressed
+    uint32_t size{0};
+};
+//! the number of bits a single value occupies in a block
+inline unsigned packed_bits(signal_desc const& s) {
+    switch(s.kind) {
+    case value_kind::FOUR_STATE:
+        return 2 * s.bits;
+    case value_kind::REAL:
+        return 64;
+    default:
+        return s.bits;
+    }
+}
+
+inline void put_varint(std::vector<uint8_t>& buf, uint64_t v) {
+    while(v >= 0x80) {
+        buf.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(static_cast<uint8_t>(v));
+}
+
+inline uint64_t get_varint(uint8_t const*& p, uint8_t const* end) {
+    uint64_t v = 0;
+    for(unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        auto b = *p++;
+        v |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if(!(b & 0x80))
+            break;
+    }
+    return v;
+}
+} // namespace cwf
+} // namespace util
+#endif /* _UTIL_CWF_FORMAT_H_ */
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "cwf_reader.h"
+#include <algorithm>
+#include <cstring>
+#include <lz4.h>
+#include <stdexcept>
+
+namespace util {
+namespace {
+struct dir_parser {
+    uint8_t const* p;
+    uint8_t const* end;
+    template <typename T> T get() {
+        if(end - p < static_cast<ptrdiff_t>(sizeof(T)))
+            throw std::runtime_error("Truncated CWF directory");
+        T v = 0;
+        for(size_t i = 0; i < sizeof(T); ++i)
+            v |= static_cast<T>(*p++) << (8 * i);
+        return v;
+    }
+    std::string get_string(size_t len) {
+        if(end - p < static_cast<ptrdiff_t>(len))
+            throw std::runtime_error("Truncated CWF directory");
+        std::string ret(reinterpret_cast<char const*>(p), len);
+        p += len;
+        return ret;
+    }
+};
+
+inline uint64_t get_bits(uint8_t const* buf, uint64_t& bit_pos, unsigned n) {
+    uint64_t v = 0;
+    for(unsigned shift = 0; n;) {
+        auto ofs = static_cast<unsigned>(bit_pos % 8);
+        auto take = std::min(8U - ofs, n);
+        v |= static_cast<uint64_t>((buf[bit_pos / 8] >> ofs) & ((1U << take) - 1)) << shift;
+        shift += take;
+        n -= take;
+        bit_pos += take;
+    }
+    return v;
+}
+} // namespace
+
+cwf_reader::cwf_reader(std::string const& name)
+: in(name, std::ios::binary) {
+    if(!in.is_open())
+        throw std::runtime_error("Could not open " + name);
+    char head[sizeof(cwf::magic)];
+    in.read(head, sizeof(head));
+    if(!in || memcmp(head, cwf::magic, sizeof(head)) != 0)
+        throw std::runtime_error(name + " is not a CWF file");
+    uint8_t trailer[16 + sizeof(cwf::magic)];
+    in.seekg(-static_cast<std::streamoff>(sizeof(trailer)), std::ios::end);
+    auto trailer_pos = static_cast<uint64_t>(in.tellg());
+    in.read(reinterpret_cast<char*>(trailer), sizeof(trailer));
+    if(!in || memcmp(trailer + 16, cwf::magic, sizeof(cwf::magic)) != 0)
+        throw std::runtime_error(name + " has no valid CWF trailer, the file has not been closed properly");
+    dir_parser tp{trailer, trailer + 16};
+    auto dir_offset = tp.get<uint64_t>();
+    end_time = tp.get<uint64_t>();
+    if(dir_offset > trailer_pos)
+        throw std::runtime_error(name + " has an invalid CWF directory offset");
+    std::vector<uint8_t> dir(trailer_pos - dir_offset);
+    in.seekg(dir_offset);
+    in.read(reinterpret_cast<char*>(dir.data()), dir.size());
+    dir_parser dp{dir.data(), dir.data() + dir.size()};
+    timescale = static_cast<int8_t>(dp.get<uint8_t>());
+    auto sig_count = dp.get<uint32_t>();
+    signals.resize(sig_count);
+    for(auto& s : signals) {
+        s.name = dp.get_string(dp.get<uint32_t>());
+        s.bits = dp.get<uint32_t>();
+        s.kind = static_cast<cwf::value_kind>(dp.get<uint8_t>());
+        s.alias = dp.get<uint32_t>();
+        if(s.alias >= sig_count)
+            throw std::runtime_error(name + " has an invalid alias for " + s.name);
+    }
+    blocks.resize(sig_count);
+    auto blk_count = dp.get<uint64_t>();
+    for(uint64_t i = 0; i < blk_count; ++i) {
+        cwf::block_desc b;
+        b.signal = dp.get<uint32_t>();
+        b.count = dp.get<uint32_t>();
+        b.first_time = dp.get<uint64_t>();
+        b.last_time = dp.get<uint64_t>();
+        b.offset = dp.get<uint64_t>();
+        b.raw_size = dp.get<uint32_t>();
+        b.size = dp.get<uint32_t>();
+        if(b.signal >= sig_count)
+            throw std::runtime_error(name + " has an invalid block index");
+        blocks[b.signal].push_back(b);
+    }
+    // blocks of a signal are written in time order but make sure for files written by other tools
+    for(auto& v : blocks)
+        std::stable_sort(std::begin(v), std::end(v),
+                         [](cwf::block_desc const& a, cwf::block_desc const& b) { return a.first_time < b.first_time; });
+}
+
+int64_t cwf_reader::find_signal(std::string const& name) const {
+    auto it = std::find_if(std::begin(signals), std::end(signals), [&name](cwf::signal_desc const& s) { return s.name == name; });
+    return it == std::end(signals) ? -1 : std::distance(std::begin(signals), it);
+}
+
+void cwf_reader::read(uint32_t id, callback const& cb, uint64_t from, uint64_t to) {
+    auto& sig = signals.at(id);
+    auto& blks = blocks[sig.alias];
+    // the first block of interest is the last one starting at or before from since it holds the value valid at from
+    auto it = std::upper_bound(std::begin(blks), std::end(blks), from,
+                               [](uint64_t t, cwf::block_desc const& b) { return t < b.first_time; });
+    if(it != std::begin(blks))
+        --it;
+    value pending;
+    uint64_t pending_time = 0;
+    bool has_pending = false;
+    for(; it != std::end(blks) && it->first_time <= to; ++it)
+        decode(*it, sig, cb, from, to, pending, pending_time, has_pending);
+    if(has_pending)
+        cb(pending_time, pending);
+}
+
+cwf_reader::cursor::cursor(cwf_reader& rd, uint32_t id, uint64_t from, uint64_t to)
+: rd(rd)
+, sig(rd.signals.at(id))
+, from(from)
+, to(to) {
+    auto& blks = rd.blocks[sig.alias];
+    blk = std::upper_bound(std::begin(blks), std::end(blks), from, [](uint64_t t, cwf::block_desc const& b) { return t < b.first_time; });
+    if(blk != std::begin(blks))
+        --blk;
+    blk_end = std::end(blks);
+}
+
+bool cwf_reader::cursor::next() {
+    if(++pos < changes.size())
+        return true;
+    changes.clear();
+    pos = 0;
+    auto cb = [this](uint64_t t, value const& v) { changes.emplace_back(t, v); };
+    while(changes.empty() && blk != blk_end && blk->first_time <= to)
+        rd.decode(*blk++, sig, cb, from, to, pending, pending_time, has_pending);
+    if(changes.empty() && has_pending) {
+        changes.emplace_back(pending_time, pending);
+        has_pending = false;
+    }
+    return changes.size() > 0;
+}
+
+void cwf_reader::decode(cwf::block_desc const& blk, cwf::signal_desc const& sig, callback const& cb, uint64_t from, uint64_t to,
+                        value& pending, uint64_t& pending_time, bool& has_pending) {
+    raw_buf.resize(blk.raw_size);
+    in.clear();
+    in.seekg(blk.offset);
+    if(blk.size == blk.raw_size) {
+        in.read(reinterpret_cast<char*>(raw_buf.data()), blk.size);
+    } else {
+        comp_buf.resize(blk.size);
+        in.read(comp_buf.data(), blk.size);
+        auto sz = LZ4_decompress_safe(comp_buf.data(), reinterpret_cast<char*>(raw_buf.data()), static_cast<int>(blk.size),
+                                      static_cast<int>(blk.raw_size));
+        if(sz != static_cast<int>(blk.raw_size))
+            throw std::runtime_error("Corrupt CWF block for signal " + sig.name);
+    }
+    if(!in)
+        throw std::runtime_error("Could not read CWF block for signal " + sig.name);
+    ++blocks_read;
+    auto const* p = raw_buf.data();
+    auto const* end = p + raw_buf.size();
+    std::vector<uint64_t> times(blk.count);
+    auto t = blk.first_time;
+    for(auto& e : times) {
+        t += cwf::get_varint(p, end);
+        e = t;
+    }
+    auto entry_bits = cwf::packed_bits(sig);
+    if(static_cast<uint64_t>(end - p) * 8 < static_cast<uint64_t>(entry_bits) * blk.count)
+        throw std::runtime_error("Corrupt CWF block for signal " + sig.name);
+    static char const states[] = {'0', '1', 'x', 'z'};
+    value v;
+    for(uint32_t i = 0; i < blk.count; ++i) {
+        if(times[i] > to)
+            break;
+        uint64_t bit_pos = static_cast<uint64_t>(entry_bits) * i;
+        if(times[i] < from) {
+            // only the last change before from is of interest
+            if(i + 1 < blk.count && times[i + 1] <= from)
+                continue;
+        }
+        if(sig.kind == cwf::value_kind::REAL) {
+            auto raw = get_bits(p, bit_pos, 64);
+            memcpy(&v.real, &raw, sizeof(v.real));
+            v.bits.clear();
+        } else {
+            v.bits.resize(sig.bits);
+            auto width = sig.kind == cwf::value_kind::FOUR_STATE ? 2U : 1U;
+            for(unsigned b = 0; b < sig.bits; ++b)
+                v.bits[sig.bits - 1 - b] = states[get_bits(p, bit_pos, width)];
+        }
+        if(times[i] < from) {
+            pending = v;
+            pending_time = times[i];
+            has_pending = true;
+        } else {
+            if(has_pending) {
+                if(times[i] > from)
+                    cb(pending_time, pending);
+                has_pending = false;
+            }
+            cb(times[i], v);
+        }
+    }
+}
+} // namespace util
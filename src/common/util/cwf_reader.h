@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_CWF_READER_H_
+#define _UTIL_CWF_READER_H_
+
+#include "cwf_format.h"
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace util {
+/**
+ * @class cwf_reader
+ * @brief provides random access to the signals of a columnar waveform (CWF) file
+ *
+ * Only the directory is read when opening a file. Value changes are read per signal and time range where only the
+ * blocks overlapping the requested range are loaded and decompressed.
+ */
+class cwf_reader {
+public:
+    /**
+     * @struct value
+     * @brief a value as delivered by read()
+     */
+    struct value {
+        //! the bits as '0', '1', 'x', 'z' starting with the MSB, empty for real signals
+        std::string bits;
+        //! the value of real signals
+        double real{0.0};
+    };
+    using callback = std::function<void(uint64_t time, value const&)>;
+    /**
+     * @class cursor
+     * @brief iterates over the value changes of a signal in a time range like read() does
+     *
+     * Only the block currently iterated over is held in memory, so many signals can be merged by time without loading
+     * all their changes. The cursor is positioned before the first change, next() has to be called to access it.
+     */
+    class cursor {
+    public:
+        cursor(cwf_reader& rd, uint32_t id, uint64_t from = 0, uint64_t to = std::numeric_limits<uint64_t>::max());
+        //! moves to the next value change, returns false if there is none
+        bool next();
+        //! the time of the current value change
+        uint64_t time() const { return changes[pos].first; }
+        //! the current value
+        value const& get() const { return changes[pos].second; }
+
+    private:
+        cwf_reader& rd;
+        cwf::signal_desc const& sig;
+        std::vector<cwf::block_desc>::const_iterator blk, blk_end;
+        uint64_t from, to;
+        std::vector<std::pair<uint64_t, value>> changes;
+        size_t pos{0};
+        value pending;
+        uint64_t pending_time{0};
+        bool has_pending{false};
+    };
+    /**
+     * @fn  cwf_reader(const std::string&)
+     * @brief opens the file and reads the directory, throws std::runtime_error if this fails
+     */
+    explicit cwf_reader(std::string const& name);
+
+    std::vector<cwf::signal_desc> const& get_signals() const { return signals; }
+    //! the time unit as power of 10 of seconds
+    int8_t get_timescale() const { return timescale; }
+    //! the time of the last value change in the file
+    uint64_t get_end_time() const { return end_time; }
+    //! returns the id of the signal with the given name or -1 if there is none
+    int64_t find_signal(std::string const& name) const;
+    /**
+     * @fn void read(uint32_t, const callback&, uint64_t, uint64_t)
+     * @brief calls cb for each value change of a signal in the time range [from, to]
+     *
+     * If the signal has no change at from, the value being valid at from is reported first (with its original time)
+     */
+    void read(uint32_t id, callback const& cb, uint64_t from = 0, uint64_t to = std::numeric_limits<uint64_t>::max());
+    //! the number of blocks being decompressed so far
+    uint64_t get_blocks_read() const { return blocks_read; }
+
+private:
+    void decode(cwf::block_desc const& blk, cwf::signal_desc const& sig, callback const& cb, uint64_t from, uint64_t to,
+                value& pending, uint64_t& pending_time, bool& has_pending);
+    std::ifstream in;
+    int8_t timescale{0};
+    uint64_t end_time{0};
+    std::vector<cwf::signal_desc> signals;
+    //! the blocks per signal ordered by time
+    std::vector<std::vector<cwf::block_desc>> blocks;
+    std::vector<char> comp_buf;
+    std::vector<uint8_t> raw_buf;
+    uint64_t blocks_read{0};
+};
+} // namespace util
+#endif /* _UTIL_CWF_READER_H_ */
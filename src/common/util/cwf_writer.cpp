@@ -0,0 +1,221 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "cwf_writer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <lz4.h>
+#include <stdexcept>
+
+namespace util {
+namespace {
+template <typename T> void put_le(std::vector<uint8_t>& buf, T v) {
+    for(size_t i = 0; i < sizeof(T); ++i, v >>= 8)
+        buf.push_back(static_cast<uint8_t>(v & 0xff));
+}
+
+inline unsigned char_to_state(char c) {
+    switch(c) {
+    case '1':
+        return 1;
+    case 'x':
+    case 'X':
+        return 2;
+    case 'z':
+    case 'Z':
+        return 3;
+    default:
+        return 0;
+    }
+}
+} // namespace
+
+cwf_writer::cwf_writer(std::string const& name, unsigned block_entries)
+: block_entries(block_entries ? block_entries : cwf::default_block_entries) {
+    out = fopen(name.c_str(), "wb");
+    if(!out)
+        throw std::runtime_error("Could not open " + name + " for writing");
+    write(cwf::magic, sizeof(cwf::magic));
+}
+
+cwf_writer::~cwf_writer() {
+    try {
+        close();
+    } catch(std::runtime_error&) {
+    }
+}
+
+uint32_t cwf_writer::add_signal(std::string const& name, unsigned bits, cwf::value_kind kind) {
+    auto id = static_cast<uint32_t>(signals.size());
+    signals.push_back({name, bits ? bits : 1, kind, id});
+    columns.emplace_back();
+    return id;
+}
+
+uint32_t cwf_writer::add_alias(std::string const& name, uint32_t id) {
+    auto& orig = signals.at(id);
+    auto alias_id = static_cast<uint32_t>(signals.size());
+    signals.push_back({name, orig.bits, orig.kind, orig.alias});
+    columns.emplace_back();
+    return alias_id;
+}
+
+void cwf_writer::column::put_bits(uint64_t v, unsigned n) {
+    while(n) {
+        auto idx = bit_pos / 8;
+        auto ofs = static_cast<unsigned>(bit_pos % 8);
+        auto take = std::min(8U - ofs, n);
+        if(idx >= values.size())
+            values.push_back(0);
+        values[idx] |= static_cast<uint8_t>((v & ((1U << take) - 1)) << ofs);
+        v >>= take;
+        n -= take;
+        bit_pos += take;
+    }
+}
+
+cwf_writer::column& cwf_writer::prepare(uint32_t id, uint64_t time) {
+    auto& c = columns[id];
+    if(c.count == 0) {
+        c.first_time = time;
+        c.last_time = time;
+    }
+    cwf::put_varint(c.times, time - c.last_time);
+    c.last_time = time;
+    if(time > end_time)
+        end_time = time;
+    return c;
+}
+
+void cwf_writer::commit(uint32_t id) {
+    if(++columns[id].count == block_entries)
+        flush(id);
+}
+
+void cwf_writer::emit(uint32_t id, uint64_t time, uint64_t value) {
+    auto& s = signals[id];
+    auto& c = prepare(id, time);
+    switch(s.kind) {
+    case cwf::value_kind::REAL: {
+        double d = static_cast<double>(value);
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        c.put_bits(bits, 64);
+    } break;
+    case cwf::value_kind::FOUR_STATE:
+        for(unsigned i = 0; i < s.bits; ++i)
+            c.put_bits(i < 64 ? (value >> i) & 1 : 0, 2);
+        break;
+    default:
+        if(s.bits <= 64)
+            c.put_bits(value, s.bits);
+        else {
+            c.put_bits(value, 64);
+            for(unsigned i = 64; i < s.bits; i += 64)
+                c.put_bits(0, std::min(64U, s.bits - i));
+        }
+    }
+    commit(id);
+}
+
+void cwf_writer::emit(uint32_t id, uint64_t time, char const* value) {
+    auto& s = signals[id];
+    if(s.kind == cwf::value_kind::REAL) {
+        emit(id, time, strtod(value, nullptr));
+        return;
+    }
+    auto& c = prepare(id, time);
+    auto len = strlen(value);
+    auto width = s.kind == cwf::value_kind::FOUR_STATE ? 2U : 1U;
+    // values are stored LSB first, missing MSBs are extended like in VCD
+    auto ext = len ? char_to_state(value[0]) : 0U;
+    if(ext == 1)
+        ext = 0;
+    for(unsigned i = 0; i < s.bits; ++i) {
+        auto state = i < len ? char_to_state(value[len - 1 - i]) : ext;
+        c.put_bits(width == 2 ? state : state & 1, width);
+    }
+    commit(id);
+}
+
+void cwf_writer::emit(uint32_t id, uint64_t time, double value) {
+    auto& s = signals[id];
+    if(s.kind != cwf::value_kind::REAL) {
+        emit(id, time, static_cast<uint64_t>(value));
+        return;
+    }
+    auto& c = prepare(id, time);
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    c.put_bits(bits, 64);
+    commit(id);
+}
+
+void cwf_writer::flush(uint32_t id) {
+    auto& c = columns[id];
+    if(!c.count)
+        return;
+    raw_buf.clear();
+    raw_buf.insert(raw_buf.end(), c.times.begin(), c.times.end());
+    raw_buf.insert(raw_buf.end(), c.values.begin(), c.values.end());
+    cwf::block_desc blk{id, c.count, c.first_time, c.last_time, offset, static_cast<uint32_t>(raw_buf.size()), 0};
+    comp_buf.resize(LZ4_compressBound(static_cast<int>(raw_buf.size())));
+    auto comp_size = LZ4_compress_default(reinterpret_cast<char const*>(raw_buf.data()), comp_buf.data(),
+                                          static_cast<int>(raw_buf.size()), static_cast<int>(comp_buf.size()));
+    if(comp_size > 0 && static_cast<uint32_t>(comp_size) < blk.raw_size) {
+        blk.size = static_cast<uint32_t>(comp_size);
+        write(comp_buf.data(), blk.size);
+    } else {
+        blk.size = blk.raw_size;
+        write(raw_buf.data(), blk.size);
+    }
+    blocks.push_back(blk);
+    c.times.clear();
+    c.values.clear();
+    c.bit_pos = 0;
+    c.count = 0;
+}
+
+void cwf_writer::write(void const* data, size_t size) {
+    if(fwrite(data, 1, size, out) != size)
+        throw std::runtime_error("Failed to write CWF file");
+    offset += size;
+}
+
+void cwf_writer::close() {
+    if(!out)
+        return;
+    for(uint32_t id = 0; id < columns.size(); ++id)
+        flush(id);
+    auto dir_offset = offset;
+    std::vector<uint8_t> dir;
+    dir.push_back(static_cast<uint8_t>(timescale));
+    put_le<uint32_t>(dir, static_cast<uint32_t>(signals.size()));
+    for(auto& s : signals) {
+        put_le<uint32_t>(dir, static_cast<uint32_t>(s.name.size()));
+        dir.insert(dir.end(), s.name.begin(), s.name.end());
+        put_le<uint32_t>(dir, s.bits);
+        dir.push_back(static_cast<uint8_t>(s.kind));
+        put_le<uint32_t>(dir, s.alias);
+    }
+    put_le<uint64_t>(dir, blocks.size());
+    for(auto& b : blocks) {
+        put_le<uint32_t>(dir, b.signal);
+        put_le<uint32_t>(dir, b.count);
+        put_le<uint64_t>(dir, b.first_time);
+        put_le<uint64_t>(dir, b.last_time);
+        put_le<uint64_t>(dir, b.offset);
+        put_le<uint32_t>(dir, b.raw_size);
+        put_le<uint32_t>(dir, b.size);
+    }
+    put_le<uint64_t>(dir, dir_offset);
+    put_le<uint64_t>(dir, end_time);
+    dir.insert(dir.end(), std::begin(cwf::magic), std::end(cwf::magic));
+    write(dir.data(), dir.size());
+    fclose(out);
+    out = nullptr;
+}
+} // namespace util
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_CWF_WRITER_H_
+#define _UTIL_CWF_WRITER_H_
+
+#include "cwf_format.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace util {
+/**
+ * @class cwf_writer
+ * @brief writes value changes into a columnar waveform (CWF) file
+ *
+ * The value changes of each signal are collected in a column buffer. Once a buffer holds the configured number of
+ * entries it is LZ4 compressed and appended to the file while its location is added to the block index. Index and
+ * signal table are written when the file is closed.
+ */
+class cwf_writer {
+public:
+    /**
+     * @fn  cwf_writer(const std::string&, unsigned)
+     * @brief opens the file, throws std::runtime_error if this fails
+     *
+     * @param name the file name
+     * @param block_entries the number of value changes being collected per signal before a block is written
+     */
+    cwf_writer(std::string const& name, unsigned block_entries = cwf::default_block_entries);
+
+    ~cwf_writer();
+
+    cwf_writer(const cwf_writer&) = delete;
+    cwf_writer(cwf_writer&&) = delete;
+    cwf_writer& operator=(const cwf_writer&) = delete;
+    cwf_writer& operator=(cwf_writer&&) = delete;
+    //! set the time unit as power of 10 of seconds (e.g. -12 for ps)
+    void set_timescale(int8_t exp) { timescale = exp; }
+    //! register a signal and return its id
+    uint32_t add_signal(std::string const& name, unsigned bits, cwf::value_kind kind);
+    //! register a signal sharing the values of signal id
+    uint32_t add_alias(std::string const& name, uint32_t id);
+    // the emit functions expect the id of a signal not being an alias
+    //! record a 2-state value of up to 64 bits
+    void emit(uint32_t id, uint64_t time, uint64_t value);
+    //! record a value given as string of '0', '1', 'x', 'z' starting with the MSB
+    void emit(uint32_t id, uint64_t time, char const* value);
+    //! record a real value
+    void emit(uint32_t id, uint64_t time, double value);
+    //! flush all column buffers and write directory and trailer
+    void close();
+    //! the number of bytes written so far
+    uint64_t size() const { return offset; }
+
+private:
+    struct column {
+        std::vector<uint8_t> times;
+        std::vector<uint8_t> values;
+        uint64_t bit_pos{0};
+        uint32_t count{0};
+        uint64_t first_time{0};
+        uint64_t last_time{0};
+        void put_bits(uint64_t v, unsigned n);
+    };
+    column& prepare(uint32_t id, uint64_t time);
+    void commit(uint32_t id);
+    void flush(uint32_t id);
+    void write(void const* data, size_t size);
+    FILE* out{nullptr};
+    const unsigned block_entries;
+    int8_t timescale{-12};
+    uint64_t offset{0};
+    uint64_t end_time{0};
+    std::vector<cwf::signal_desc> signals;
+    std::vector<column> columns;
+    std::vector<cwf::block_desc> blocks;
+    std::vector<uint8_t> raw_buf;
+    std::vector<char> comp_buf;
+};
+} // namespace util
+#endif /* _UTIL_CWF_WRITER_H_ */
@@ -0,0 +1,280 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_GLOB_TRIE_H_
+#define _UTIL_GLOB_TRIE_H_
+
+#include "ities.h"
+#include <cstddef>
+#include <limits>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace util {
+/**
+ * @class glob_trie
+ * @brief a set of globbing patterns (as understood by glob_to_regex()) and regular expressions matched against
+ * hierarchical names
+ *
+ * The patterns are split at the hierarchy delimiter and stored in a trie. Literal name segments are looked up in a hash
+ * map, segments containing ?, * or character classes are matched segment wise and a trailing ** matches any remaining
+ * hierarchy. Hence matching a name takes time proportional to its length and the number of wildcard segments along its
+ * path instead of the number of patterns. Patterns which cannot be split (regular expressions starting with ^, ** within
+ * the name, escapes, negated classes) are kept as std::regex at the deepest node of their literal prefix and are only evaluated for
+ * names sharing this prefix.
+ *
+ * Each distinct pattern gets an id in insertion order.
+ */
+class glob_trie {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    glob_trie()
+    : nodes(1) {}
+    /**
+     * @fn std::pair<size_t, bool> insert(std::string)
+     * @brief adds a pattern, throws std::regex_error if the pattern is invalid
+     *
+     * @return the id of the pattern and true if it has not been inserted before
+     */
+    std::pair<size_t, bool> insert(std::string pattern) {
+        util::trim(pattern);
+        auto it = ids.find(pattern);
+        if(it != ids.end())
+            return {it->second, false};
+        auto id = ids.size();
+        add(pattern, id);
+        ids.emplace(pattern, id);
+        return {id, true};
+    }
+    //! returns the smallest id of the patterns matching name, npos if none matches
+    size_t find_first(std::string const& name) const {
+        auto best = npos;
+        if(!ids.empty())
+            walk(0, name, 0, true, best, true);
+        return best;
+    }
+    //! returns true if any pattern matches name
+    bool matches(std::string const& name) const {
+        auto best = npos;
+        if(!ids.empty())
+            walk(0, name, 0, true, best, false);
+        return best != npos;
+    }
+
+    size_t size() const { return ids.size(); }
+
+    bool empty() const { return ids.empty(); }
+
+private:
+#ifdef MTI_SYSTEMC
+    static constexpr char delimiter = '/';
+#else
+    static constexpr char delimiter = '.';
+#endif
+    struct node {
+        std::unordered_map<std::string, size_t> literals;
+        std::vector<std::pair<std::string, size_t>> globs;
+        //! patterns ending at this node
+        std::vector<size_t> terminal;
+        //! patterns ending with ** at this node
+        std::vector<size_t> any_suffix;
+        //! patterns being matched as a whole once a name reaches this node
+        std::vector<std::pair<size_t, std::regex>> regexes;
+    };
+    enum segment_kind { LITERAL, GLOB, DOUBLE_STAR, COMPLEX };
+
+    static segment_kind classify(std::string const& seg) {
+        if(seg == "**")
+            return DOUBLE_STAR;
+        auto kind = LITERAL;
+        for(size_t i = 0; i < seg.size(); ++i) {
+            switch(seg[i]) {
+            case '\\':
+                return COMPLEX;
+            case '*':
+                if(i + 1 < seg.size() && seg[i + 1] == '*')
+                    return COMPLEX;
+                kind = GLOB;
+                break;
+            case '?':
+                kind = GLOB;
+                break;
+            case '[': {
+                auto start = i + 1;
+                // negated classes also match the delimiter, they are left to std::regex like empty, unterminated or
+                // nested classes
+                if(start < seg.size() && (seg[start] == '!' || seg[start] == '^'))
+                    return COMPLEX;
+                auto end = seg.find(']', start);
+                if(end == std::string::npos || end == start || seg.find('[', start) < end)
+                    return COMPLEX;
+                i = end;
+                kind = GLOB;
+            } break;
+            default:
+                break;
+            }
+        }
+        return kind;
+    }
+    //! splits at the delimiters outside of character classes, returns false if a class contains a delimiter
+    static bool split(std::string const& pattern, std::vector<std::string>& segments) {
+        segments.assign(1, std::string());
+        bool in_class = false;
+        for(auto c : pattern) {
+            if(in_class) {
+                if(c == delimiter)
+                    return false;
+                in_class = c != ']';
+            } else if(c == '[')
+                in_class = true;
+            else if(c == delimiter) {
+                segments.emplace_back();
+                continue;
+            }
+            segments.back() += c;
+        }
+        return true;
+    }
+
+    void add(std::string const& pattern, size_t id) {
+        size_t cur = 0;
+        std::vector<std::string> segments;
+        if(pattern[0] != '^' && split(pattern, segments)) {
+            for(size_t i = 0; i < segments.size(); ++i) {
+                auto& seg = segments[i];
+                auto kind = classify(seg);
+                if(kind == DOUBLE_STAR && i + 1 == segments.size()) {
+                    nodes[cur].any_suffix.push_back(id);
+                    return;
+                }
+                if(kind == DOUBLE_STAR || kind == COMPLEX)
+                    break;
+                cur = child(cur, seg, kind == GLOB);
+                if(i + 1 == segments.size()) {
+                    nodes[cur].terminal.push_back(id);
+                    return;
+                }
+            }
+        }
+        std::regex re(pattern[0] == '^' ? pattern : util::glob_to_regex(pattern));
+        nodes[cur].regexes.emplace_back(id, std::move(re));
+    }
+
+    size_t child(size_t cur, std::string const& seg, bool glob) {
+        if(glob) {
+            for(auto& g : nodes[cur].globs)
+                if(g.first == seg)
+                    return g.second;
+        } else {
+            auto it = nodes[cur].literals.find(seg);
+            if(it != nodes[cur].literals.end())
+                return it->second;
+        }
+        auto idx = nodes.size();
+        nodes.emplace_back();
+        if(glob)
+            nodes[cur].globs.emplace_back(seg, idx);
+        else
+            nodes[cur].literals.emplace(seg, idx);
+        return idx;
+    }
+    /**
+     * matches the rest of name starting at pos (the delimiter after the segments consumed so far or 0 at the root)
+     * against the patterns below node idx, best is lowered to the smallest matching id. Unless all matches are
+     * needed the walk stops at the first one.
+     */
+    bool walk(size_t idx, std::string const& name, size_t pos, bool root, size_t& best, bool all) const {
+        auto& n = nodes[idx];
+        auto update = [&best, all](size_t id) {
+            if(id < best)
+                best = id;
+            return !all;
+        };
+        for(auto& r : n.regexes)
+            if(r.first < best && std::regex_match(name, r.second) && update(r.first))
+                return true;
+        auto at_end = !root && pos == name.size();
+        if(at_end)
+            for(auto id : n.terminal)
+                if(update(id))
+                    return true;
+        if(at_end)
+            return false;
+        for(auto id : n.any_suffix)
+            if(update(id))
+                return true;
+        auto start = root ? 0 : pos + 1;
+        auto end = name.find(delimiter, start);
+        if(end == std::string::npos)
+            end = name.size();
+        if(!n.literals.empty()) {
+            auto it = n.literals.find(name.substr(start, end - start));
+            if(it != n.literals.end() && walk(it->second, name, end, false, best, all))
+                return true;
+        }
+        for(auto& g : n.globs)
+            if(segment_match(g.first, name.data() + start, name.data() + end) && walk(g.second, name, end, false, best, all))
+                return true;
+        return false;
+    }
+    //! matches a single segment pattern consisting of literals, ?, * and (non-negated) character classes
+    static bool segment_match(std::string const& pattern, char const* s, char const* se) {
+        auto p = pattern.data(), pe = p + pattern.size();
+        char const *star_p = nullptr, *star_s = nullptr;
+        while(s < se) {
+            if(p < pe && *p == '*') {
+                star_p = ++p;
+                star_s = s;
+                continue;
+            }
+            if(p < pe && match_char(p, pe, *s)) {
+                ++s;
+                continue;
+            }
+            if(!star_p)
+                return false;
+            p = star_p;
+            s = ++star_s;
+        }
+        while(p < pe && *p == '*')
+            ++p;
+        return p == pe;
+    }
+    //! matches c against the element at p and advances p behind it on success
+    static bool match_char(char const*& p, char const* pe, char c) {
+        if(*p == '?') {
+            ++p;
+            return true;
+        }
+        if(*p != '[') {
+            if(*p != c)
+                return false;
+            ++p;
+            return true;
+        }
+        auto q = p + 1;
+        auto match = false;
+        for(; *q != ']'; ++q)
+            if(q + 2 < pe && q[1] == '-' && q[2] != ']') {
+                match |= c >= q[0] && c <= q[2];
+                q += 2;
+            } else
+                match |= c == *q;
+        if(!match)
+            return false;
+        p = q + 1;
+        return true;
+    }
+
+    std::vector<node> nodes;
+    std::unordered_map<std::string, size_t> ids;
+};
+} // namespace util
+#endif /* _UTIL_GLOB_TRIE_H_ */
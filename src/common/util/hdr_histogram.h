@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_HDR_HISTOGRAM_H_
+#define _UTIL_HDR_HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace util {
+/**
+ * @class hdr_histogram
+ * @brief a histogram with log-linear buckets covering the full range of 64bit values
+ *
+ * Values below 2^SUB_BITS are counted exactly, above each power of 2 range is split into 2^(SUB_BITS-1) buckets of
+ * equal width. This bounds the relative error of a reported value by 2^-(SUB_BITS-1) while recording a value is a
+ * bit scan and an increment. The bucket array grows with the largest value recorded.
+ */
+template <unsigned SUB_BITS = 5> class hdr_histogram {
+    static_assert(SUB_BITS > 1 && SUB_BITS < 32, "SUB_BITS out of range");
+    static constexpr uint64_t half = 1ULL << (SUB_BITS - 1);
+
+public:
+    void record(uint64_t value, uint64_t count = 1) {
+        auto idx = index(value);
+        if(idx >= counts.size())
+            counts.resize(idx + 1);
+        counts[idx] += count;
+        if(!total || value < min_val)
+            min_val = value;
+        if(!total || value > max_val)
+            max_val = value;
+        total += count;
+        sum += value * count;
+    }
+    //! the number of values recorded
+    uint64_t count() const { return total; }
+
+    uint64_t min() const { return min_val; }
+
+    uint64_t max() const { return max_val; }
+
+    double mean() const { return total ? static_cast<double>(sum) / total : 0.; }
+    /**
+     * @fn uint64_t percentile(double) const
+     * @brief the value below or at which the given percentage of the recorded values lie
+     *
+     * @param pct the percentage in the range 0..100
+     * @return the upper bound of the bucket holding the percentile
+     */
+    uint64_t percentile(double pct) const {
+        if(!total)
+            return 0;
+        auto limit = static_cast<uint64_t>(pct / 100. * total + 0.5);
+        if(limit < 1)
+            limit = 1;
+        uint64_t acc = 0;
+        for(size_t idx = 0; idx < counts.size(); ++idx) {
+            acc += counts[idx];
+            if(acc >= limit) {
+                auto hi = upper_bound(idx);
+                return hi < max_val ? hi : max_val;
+            }
+        }
+        return max_val;
+    }
+    /**
+     * @fn void for_each_bucket(F) const
+     * @brief calls f(lower bound, upper bound, count) for each non-empty bucket in ascending order
+     */
+    template <typename F> void for_each_bucket(F f) const {
+        for(size_t idx = 0; idx < counts.size(); ++idx)
+            if(counts[idx])
+                f(lower_bound(idx), upper_bound(idx), counts[idx]);
+    }
+
+    void reset() {
+        counts.clear();
+        total = sum = min_val = max_val = 0;
+    }
+
+private:
+    static size_t index(uint64_t value) {
+        if(value < 2 * half)
+            return static_cast<size_t>(value);
+        unsigned msb = 63;
+        while(!(value >> msb))
+            --msb;
+        auto e = msb - SUB_BITS + 1;
+        return static_cast<size_t>(e * half + (value >> e));
+    }
+    static uint64_t lower_bound(size_t idx) {
+        if(idx < 2 * half)
+            return idx;
+        auto e = idx / half - 1;
+        return (idx - e * half) << e;
+    }
+    static uint64_t upper_bound(size_t idx) {
+        if(idx < 2 * half)
+            return idx;
+        auto e = idx / half - 1;
+        return lower_bound(idx) + ((1ULL << e) - 1);
+    }
+    std::vector<uint64_t> counts;
+    uint64_t total{0}, sum{0}, min_val{0}, max_val{0};
+};
+} // namespace util
+#endif /* _UTIL_HDR_HISTOGRAM_H_ */
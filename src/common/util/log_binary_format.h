@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************
+ *
+ * Layout of the binary log written by the SCC report handler if a binary log file is configured. The file starts with
+ * magic[8] and a header, followed by frames. All numbers are unsigned LEB128 encoded (7 bits per byte, low bits first).
+ *
+ *   header : time resolution in fs, msg type field width, flags (PRINT_DELTA, PRINT_SEVERITY)
+ *   frame  : thread index, length, bytes
+ *
+ * Each thread emitting log messages writes its own stream of records, a frame carries a piece of the stream of one
+ * thread. Records may span frames, the records of a thread are decoded by concatenating the frames of the thread in
+ * file order. A record is its length followed by a type byte and the payload:
+ *
+ *   STRING  : id, length, characters
+ *   SITE    : id, severity, verbosity, message type string id, file string id, line, report id + 1 (0 if none)
+ *   MESSAGE : site id, time in ticks, delta count, process name string id (0 if none), length, characters
+ *   CYCLE   : cycle base in ticks (0 to print times), applies to the following messages of the thread
+ *   FORMAT  : site id, severity, verbosity, file string id, line, format string id
+ *   ARGS    : site id (of a FORMAT record), message type string id, time in ticks, delta count, argument count,
+ *             arguments each being an arg_type byte followed by the value
+ *   DROPPED : number of messages dropped before this record as the buffer of the thread was full
+ *
+ * String and site ids are local to the thread and are defined before their first use, string ids start at 1. SITE and
+ * FORMAT records share the site ids. ARGS records carry the arguments of the formatting logging macros, the message is
+ * the fmt style format string applied to them. Arguments of type INT are zigzag encoded, DOUBLE is the 8 byte IEEE 754
+ * value and STRING the length followed by the characters, all others are unsigned numbers.
+ */
+
+#ifndef _UTIL_LOG_BINARY_FORMAT_H_
+#define _UTIL_LOG_BINARY_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util {
+namespace log_binary {
+//! the file identification, the last byte denotes the version
+static constexpr char magic[8] = {'S', 'C', 'C', 'L', 'O', 'G', 'B', 2};
+
+enum record_type : uint8_t { STRING = 1, SITE = 2, MESSAGE = 3, CYCLE = 4, FORMAT = 5, ARGS = 6, DROPPED = 7 };
+//! the types of the arguments of ARGS records, they match scc::log_arg::kind_e
+enum arg_type : uint8_t { INT, UINT, DOUBLE, BOOL, CHAR, STRING_ARG, POINTER };
+
+enum header_flags : uint8_t { PRINT_DELTA = 1, PRINT_SEVERITY = 2 };
+//! appends v LEB128 encoded to buf
+inline void put(std::vector<uint8_t>& buf, uint64_t v) {
+    while(v >= 0x80) {
+        buf.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(static_cast<uint8_t>(v));
+}
+//! appends v zigzag and LEB128 encoded to buf
+inline void put_signed(std::vector<uint8_t>& buf, int64_t v) {
+    put(buf, (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+/**
+ * @fn bool get(uint8_t const*&, uint8_t const*, uint64_t&)
+ * @brief decodes a LEB128 number and advances p behind it
+ *
+ * @return false if the number is not complete before end, p is left unchanged in this case
+ */
+inline bool get(uint8_t const*& p, uint8_t const* end, uint64_t& v) {
+    v = 0;
+    auto q = p;
+    for(unsigned shift = 0; q < end && shift < 64; shift += 7) {
+        auto b = *q++;
+        v |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if(!(b & 0x80)) {
+            p = q;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool get_signed(uint8_t const*& p, uint8_t const* end, int64_t& v) {
+    uint64_t u;
+    if(!get(p, end, u))
+        return false;
+    v = static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+    return true;
+}
+} // namespace log_binary
+} // namespace util
+#endif /* _UTIL_LOG_BINARY_FORMAT_H_ */
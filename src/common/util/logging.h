@@ -273,8 +273,14 @@ struct DEFAULT {
 #define FILELOG_DECLSPEC
 #endif // _WIN32
 
+//! the most verbose log level compiled in, more verbose output including its arguments is removed. It follows the
+//! SCC_LOG_LEVEL_MAX CMake cache variable unless being defined explicitly
 #ifndef FILELOG_MAX_LEVEL
-#define FILELOG_MAX_LEVEL ::logging::TRACE
+#ifdef SCC_LOG_LEVEL_MAX
+#define FILELOG_MAX_LEVEL SCC_LOG_LEVEL_MAX
+#else
+#define FILELOG_MAX_LEVEL ::logging::TRACEALL
+#endif
 #endif
 
 #define _LOGGER(CATEGORY) ::logging::Log<::logging::Output2FILE<CATEGORY>>
@@ -284,18 +290,21 @@ struct DEFAULT {
 
 #ifndef LOG
 #define LOG(LEVEL)                                                                                                                         \
-    if(::logging::LEVEL <= LOGGER(DEFAULT)::get_reporting_level() && LOG_OUTPUT(DEFAULT)::stream())                                        \
+    if(::logging::LEVEL <= FILELOG_MAX_LEVEL && ::logging::LEVEL <= LOGGER(DEFAULT)::get_reporting_level() &&                              \
+       LOG_OUTPUT(DEFAULT)::stream())                                                                                                      \
     LOGGER(DEFAULT)().get(::logging::LEVEL)
 #endif
 
 // next few lines are tricky, its macro overloading
 // the one argument version
 #define CPPLOG1(LEVEL)                                                                                                                     \
-    if(::logging::LEVEL <= LOGGER(DEFAULT)::get_reporting_level() && LOG_OUTPUT(DEFAULT)::stream())                                        \
+    if(::logging::LEVEL <= FILELOG_MAX_LEVEL && ::logging::LEVEL <= LOGGER(DEFAULT)::get_reporting_level() &&                              \
+       LOG_OUTPUT(DEFAULT)::stream())                                                                                                      \
     LOGGER(DEFAULT)().get(::logging::LEVEL, __FUNCTION__)
 // the two argument version
 #define CPPLOG2(LEVEL, TYPE)                                                                                                               \
-    if(::logging::LEVEL <= LOGGER(DEFAULT)::get_reporting_level() && LOG_OUTPUT(DEFAULT)::stream())                                        \
+    if(::logging::LEVEL <= FILELOG_MAX_LEVEL && ::logging::LEVEL <= LOGGER(DEFAULT)::get_reporting_level() &&                              \
+       LOG_OUTPUT(DEFAULT)::stream())                                                                                                      \
     LOGGER(DEFAULT)().get(::logging::LEVEL, TYPE)
 // This macro extracts the third argument (NAME) based on how many arguments are passed. It is used to route to the correct implementation.
 #define GET_CPPLOG_MACRO(_1, _2, NAME, ...) NAME
@@ -304,7 +313,8 @@ struct DEFAULT {
 
 #ifndef CLOG
 #define NSCLOG(LEVEL, CATEGORY)                                                                                                            \
-    if(::logging::LEVEL <= _LOGGER(CATEGORY)::get_reporting_level() && _LOG_OUTPUT(CATEGORY)::stream())                                    \
+    if(::logging::LEVEL <= FILELOG_MAX_LEVEL && ::logging::LEVEL <= _LOGGER(CATEGORY)::get_reporting_level() &&                           \
+       _LOG_OUTPUT(CATEGORY)::stream())                                                                                                    \
     _LOGGER(CATEGORY)().get(::logging::LEVEL, CATEGORY::name)
 #define CLOG(LEVEL, CATEGORY) NSCLOG(LEVEL, ::logging::CATEGORY)
 #endif
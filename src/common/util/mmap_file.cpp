@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "mmap_file.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace util {
+namespace {
+size_t page_align(size_t v) {
+    auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return std::max(page, (v + page - 1) / page * page);
+}
+} // namespace
+
+mmap_writer::mmap_writer(std::string const& name, size_t segment_size)
+: fd(::open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644))
+, seg_size(page_align(segment_size)) {
+    if(fd < 0)
+        throw std::runtime_error("could not create " + name);
+    if(ftruncate(fd, seg_size) != 0 ||
+       (seg = static_cast<uint8_t*>(mmap(nullptr, seg_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0))) == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("could not map " + name);
+    }
+}
+
+mmap_writer::~mmap_writer() { close(); }
+
+void mmap_writer::append_slow(uint8_t const* data, size_t len) {
+    while(len) {
+        if(seg_pos == seg_size)
+            map_next();
+        auto n = std::min(len, seg_size - seg_pos);
+        std::copy(data, data + n, seg + seg_pos);
+        seg_pos += n;
+        data += n;
+        len -= n;
+    }
+}
+
+void mmap_writer::map_next() {
+    munmap(seg, seg_size);
+    seg = nullptr;
+    seg_start += seg_size;
+    seg_pos = 0;
+    if(ftruncate(fd, seg_start + seg_size) != 0)
+        throw std::runtime_error("could not extend mapped file");
+    auto p = mmap(nullptr, seg_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, seg_start);
+    if(p == MAP_FAILED)
+        throw std::runtime_error("could not map next file segment");
+    seg = static_cast<uint8_t*>(p);
+}
+
+void mmap_writer::close() {
+    if(fd < 0)
+        return;
+    if(seg)
+        munmap(seg, seg_size);
+    seg = nullptr;
+    auto res = ftruncate(fd, seg_start + seg_pos);
+    ::close(fd);
+    fd = -1;
+    if(res != 0)
+        throw std::runtime_error("could not truncate mapped file");
+}
+
+mmap_reader::mmap_reader(std::string const& name) {
+    auto fd = ::open(name.c_str(), O_RDONLY);
+    if(fd < 0)
+        throw std::runtime_error("could not open " + name);
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("could not stat " + name);
+    }
+    len = static_cast<uint64_t>(st.st_size);
+    if(len) {
+        auto p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(p == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("could not map " + name);
+        }
+        ptr = static_cast<uint8_t*>(p);
+    }
+    ::close(fd);
+}
+
+mmap_reader::~mmap_reader() {
+    if(ptr)
+        munmap(ptr, len);
+}
+} // namespace util
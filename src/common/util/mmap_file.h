@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_MMAP_FILE_H_
+#define _UTIL_MMAP_FILE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace util {
+/**
+ * @class mmap_writer
+ * @brief append-only file written through memory mapped segments
+ *
+ * The file is extended and mapped one segment at a time, appending data is a plain memory copy. When the current
+ * segment is full it is unmapped (leaving the write back to the OS) and the next one is mapped. Closing the file
+ * truncates it to the number of bytes actually appended. Available on POSIX systems only.
+ */
+class mmap_writer {
+public:
+    /**
+     * @fn  mmap_writer(const std::string&, size_t)
+     * @brief creates resp. truncates the file, throws std::runtime_error if this fails
+     *
+     * @param name the file name
+     * @param segment_size the size of the mapped segments, rounded up to a multiple of the page size
+     */
+    mmap_writer(std::string const& name, size_t segment_size = 16 * 1024 * 1024);
+
+    ~mmap_writer();
+
+    mmap_writer(const mmap_writer&) = delete;
+    mmap_writer& operator=(const mmap_writer&) = delete;
+    //! append len bytes and return the file offset they are stored at, throws std::runtime_error on failure
+    uint64_t append(void const* data, size_t len) {
+        auto ret = seg_start + seg_pos;
+        if(seg_pos + len <= seg_size) {
+            std::copy(static_cast<uint8_t const*>(data), static_cast<uint8_t const*>(data) + len, seg + seg_pos);
+            seg_pos += len;
+        } else
+            append_slow(static_cast<uint8_t const*>(data), len);
+        return ret;
+    }
+    //! the number of bytes appended so far
+    uint64_t size() const { return seg_start + seg_pos; }
+    //! unmap the last segment and truncate the file to its final size
+    void close();
+
+private:
+    void append_slow(uint8_t const* data, size_t len);
+    void map_next();
+    int fd{-1};
+    uint8_t* seg{nullptr};
+    size_t seg_size;
+    size_t seg_pos{0};
+    uint64_t seg_start{0};
+};
+/**
+ * @class mmap_reader
+ * @brief maps a complete file read-only, available on POSIX systems only
+ */
+class mmap_reader {
+public:
+    //! maps the file, throws std::runtime_error if this fails
+    explicit mmap_reader(std::string const& name);
+
+    ~mmap_reader();
+
+    mmap_reader(const mmap_reader&) = delete;
+    mmap_reader& operator=(const mmap_reader&) = delete;
+
+    uint8_t const* data() const { return ptr; }
+
+    uint64_t size() const { return len; }
+
+private:
+    uint8_t* ptr{nullptr};
+    uint64_t len{0};
+};
+} // namespace util
+#endif /* _UTIL_MMAP_FILE_H_ */
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_OPEN_HASH_MAP_H_
+#define _UTIL_OPEN_HASH_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace util {
+/**
+ * @class open_hash_map
+ * @brief a hash map with open addressing for non-zero 64bit keys like pointers or ids
+ *
+ * The entries are stored in a single power of 2 sized table using linear probing, the key 0 denotes an empty slot.
+ * Erasing uses backward shifting so no tombstones are left behind. Compared to std::unordered_map neither insertion
+ * nor erasure allocates memory once the table has grown to the working set size. Pointers returned by find() and
+ * references returned by operator[] are invalidated by subsequent insertions and erasures.
+ */
+template <typename T> class open_hash_map {
+public:
+    explicit open_hash_map(size_t initial_capacity = 64) {
+        size_t cap = 8;
+        while(cap < initial_capacity)
+            cap <<= 1;
+        slots.resize(cap);
+    }
+    //! returns the value stored for key or nullptr if there is none
+    T* find(uint64_t key) {
+        for(auto idx = hash(key);; idx = (idx + 1) & mask()) {
+            auto& s = slots[idx];
+            if(s.first == key)
+                return &s.second;
+            if(!s.first)
+                return nullptr;
+        }
+    }
+    //! returns the value stored for key, a default constructed value is inserted if there is none
+    T& operator[](uint64_t key) {
+        if(2 * (count + 1) > slots.size())
+            grow();
+        for(auto idx = hash(key);; idx = (idx + 1) & mask()) {
+            auto& s = slots[idx];
+            if(s.first == key)
+                return s.second;
+            if(!s.first) {
+                s.first = key;
+                ++count;
+                return s.second;
+            }
+        }
+    }
+    //! removes key from the map, returns false if it was not found
+    bool erase(uint64_t key) {
+        auto idx = hash(key);
+        for(;; idx = (idx + 1) & mask()) {
+            if(!slots[idx].first)
+                return false;
+            if(slots[idx].first == key)
+                break;
+        }
+        // shift back the following entries of the cluster which would not be found anymore
+        for(auto next = (idx + 1) & mask(); slots[next].first; next = (next + 1) & mask()) {
+            auto home = hash(slots[next].first);
+            if(((next - home) & mask()) >= ((next - idx) & mask())) {
+                slots[idx] = std::move(slots[next]);
+                idx = next;
+            }
+        }
+        slots[idx].first = 0;
+        slots[idx].second = T();
+        --count;
+        return true;
+    }
+
+    void clear() {
+        for(auto& s : slots)
+            s = slot_type();
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+
+    bool empty() const { return count == 0; }
+
+private:
+    using slot_type = std::pair<uint64_t, T>;
+    size_t mask() const { return slots.size() - 1; }
+    size_t hash(uint64_t key) const {
+        // Fibonacci hashing spreads aligned pointers and sequential ids equally well
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask();
+    }
+    void grow() {
+        std::vector<slot_type> old(slots.size() * 2);
+        old.swap(slots);
+        count = 0;
+        for(auto& s : old)
+            if(s.first)
+                operator[](s.first) = std::move(s.second);
+    }
+    std::vector<slot_type> slots;
+    size_t count{0};
+};
+} // namespace util
+#endif /* _UTIL_OPEN_HASH_MAP_H_ */
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************
+ *
+ * Layout of the binary transaction database written by scv_tr_binary. The database is a directory holding three
+ * append-only files, each starting with magic[8] followed by records of little endian numbers:
+ *
+ *   c (control) : u32 type, payload
+ *                 STRING    : u64 id, u32 length, characters
+ *                 STREAM    : u64 id, u64 name, u64 kind
+ *                 GENERATOR : u64 id, u64 name, u64 stream
+ *                 INFO      : i32 time unit as power of 10 of seconds
+ *   d (data)    : u32 type, payload
+ *                 TX_BEGIN  : u64 id, u64 generator, u64 stream, u32 concurrency level, u64 time
+ *                 ATTRIBUTE : u64 tx id, u16 event, u64 name, u16 data type, u64 value
+ *                 TX_END    : u64 id, u64 time
+ *                 RELATION  : u64 name, u64 stream 1, u64 tx 1, u64 stream 2, u64 tx 2
+ *   t (timing)  : fixed size entries {u32 type (TX_BEGIN or TX_END), u64 time, u64 data file offset}
+ *
+ * Names and string values are references into the string table of the control file. Attribute values are string ids
+ * for string like data types, the IEEE 754 bit pattern for floating point numbers and the (two's complement) integer
+ * otherwise. Times are given in ps. Since the timing entries are written in simulation order they are sorted by time
+ * which allows a binary search for the data file position of any point in time. If the recording was not closed
+ * properly the files are padded with zeros up to the end of the last segment, a record type of 0 denotes the end.
+ */
+
+#ifndef _UTIL_SCV_BINARY_FORMAT_H_
+#define _UTIL_SCV_BINARY_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace util {
+namespace scv_binary {
+//! the file identification, the last byte denotes the version
+static constexpr char magic[8] = {'S', 'C', 'C', 'T', 'X', 'B', 0, 1};
+//! the size of a timing entry
+static constexpr size_t timing_entry_size = 20;
+
+enum control_record : uint32_t { STRING = 1, STREAM = 2, GENERATOR = 3, INFO = 4 };
+
+enum data_record : uint32_t { TX_BEGIN = 1, ATTRIBUTE = 2, TX_END = 3, RELATION = 4 };
+
+enum event_type : uint16_t { BEGIN = 0, RECORD = 1, END = 2 };
+//! the attribute data types, the values match scv_extensions_if::data_type
+enum data_type : uint16_t {
+    BOOLEAN,
+    ENUMERATION,
+    INTEGER,
+    UNSIGNED,
+    FLOATING_POINT_NUMBER,
+    BIT_VECTOR,
+    LOGIC_VECTOR,
+    FIXED_POINT_INTEGER,
+    UNSIGNED_FIXED_POINT_INTEGER,
+    RECORD_TYPE,
+    POINTER,
+    ARRAY,
+    STRING_TYPE
+};
+//! returns true if the value of an attribute of this type is a string id
+inline bool is_string_type(data_type t) {
+    return t == ENUMERATION || t == BIT_VECTOR || t == LOGIC_VECTOR || t == STRING_TYPE;
+}
+
+template <typename T> inline T get(uint8_t const*& p) {
+    T ret;
+    memcpy(&ret, p, sizeof(T));
+    p += sizeof(T);
+    return ret;
+}
+} // namespace scv_binary
+} // namespace util
+#endif /* _UTIL_SCV_BINARY_FORMAT_H_ */
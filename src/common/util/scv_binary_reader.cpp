@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "scv_binary_reader.h"
+#include <stdexcept>
+
+namespace util {
+using namespace scv_binary;
+
+namespace {
+void check_header(mmap_reader const& f, std::string const& name) {
+    if(f.size() < sizeof(magic) || memcmp(f.data(), magic, sizeof(magic)) != 0)
+        throw std::runtime_error(name + " is not a binary transaction database file");
+}
+} // namespace
+
+scv_binary_reader::scv_binary_reader(std::string const& name)
+: c(name + "/c")
+, d(name + "/d")
+, t(name + "/t") {
+    check_header(c, name + "/c");
+    check_header(d, name + "/d");
+    check_header(t, name + "/t");
+    // entries of type 0 can only be found at the end of a file not being closed properly
+    uint64_t lo = 0, hi = (t.size() - sizeof(magic)) / timing_entry_size;
+    while(lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        auto tp = t.data() + sizeof(magic) + mid * timing_entry_size;
+        if(get<uint32_t>(tp) != 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    timing_count = lo;
+    auto p = c.data() + sizeof(magic);
+    auto end = c.data() + c.size();
+    while(p + sizeof(uint32_t) <= end) {
+        switch(get<uint32_t>(p)) {
+        case STRING: {
+            auto id = get<uint64_t>(p);
+            auto len = get<uint32_t>(p);
+            if(p + len > end)
+                throw std::runtime_error("truncated control file");
+            strings[id].assign(reinterpret_cast<char const*>(p), len);
+            p += len;
+        } break;
+        case STREAM: {
+            auto id = get<uint64_t>(p);
+            auto name_id = get<uint64_t>(p);
+            auto kind_id = get<uint64_t>(p);
+            streams.push_back({id, get_string(name_id), get_string(kind_id)});
+        } break;
+        case GENERATOR: {
+            auto id = get<uint64_t>(p);
+            auto name_id = get<uint64_t>(p);
+            auto stream = get<uint64_t>(p);
+            generators.push_back({id, get_string(name_id), stream});
+        } break;
+        case INFO:
+            time_resolution = get<int32_t>(p);
+            break;
+        case 0: // unused space of a file not being closed properly
+            p = end;
+            break;
+        default:
+            throw std::runtime_error("unknown record in control file");
+        }
+    }
+}
+
+std::string const& scv_binary_reader::get_string(uint64_t id) const {
+    static const std::string empty;
+    auto it = strings.find(id);
+    return it == strings.end() ? empty : it->second;
+}
+
+void scv_binary_reader::timing_entry(uint64_t idx, uint64_t& time, uint64_t& offset) const {
+    auto p = t.data() + sizeof(magic) + idx * timing_entry_size + sizeof(uint32_t);
+    time = get<uint64_t>(p);
+    offset = get<uint64_t>(p);
+}
+
+uint64_t scv_binary_reader::get_end_time() const {
+    uint64_t time{0}, offset{0};
+    if(auto n = get_timing_entries())
+        timing_entry(n - 1, time, offset);
+    return time;
+}
+
+uint64_t scv_binary_reader::seek(uint64_t time) const {
+    uint64_t lo = 0, hi = get_timing_entries();
+    uint64_t entry_time, offset;
+    while(lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        timing_entry(mid, entry_time, offset);
+        if(entry_time < time)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if(lo == get_timing_entries())
+        return d.size();
+    timing_entry(lo, entry_time, offset);
+    return offset;
+}
+
+bool scv_binary_reader::next(uint64_t& offset, record& rec) const {
+    static const size_t payload_size[] = {0, 36, 28, 16, 40};
+    if(offset + sizeof(uint32_t) > d.size())
+        return false;
+    auto p = d.data() + offset;
+    rec.type = static_cast<data_record>(get<uint32_t>(p));
+    if(rec.type == 0) // unused space of a file not being closed properly
+        return false;
+    if(rec.type < TX_BEGIN || rec.type > RELATION || offset + sizeof(uint32_t) + payload_size[rec.type] > d.size())
+        throw std::runtime_error("corrupt data file");
+    switch(rec.type) {
+    case TX_BEGIN:
+        rec.id = get<uint64_t>(p);
+        rec.generator = get<uint64_t>(p);
+        rec.stream = get<uint64_t>(p);
+        rec.concurrency = get<uint32_t>(p);
+        rec.time = get<uint64_t>(p);
+        break;
+    case ATTRIBUTE:
+        rec.id = get<uint64_t>(p);
+        rec.event = static_cast<event_type>(get<uint16_t>(p));
+        rec.name = &get_string(get<uint64_t>(p));
+        rec.data_type = static_cast<data_type>(get<uint16_t>(p));
+        rec.value = get<uint64_t>(p);
+        break;
+    case TX_END:
+        rec.id = get<uint64_t>(p);
+        rec.time = get<uint64_t>(p);
+        break;
+    case RELATION:
+        rec.name = &get_string(get<uint64_t>(p));
+        rec.stream = get<uint64_t>(p);
+        rec.id = get<uint64_t>(p);
+        rec.stream2 = get<uint64_t>(p);
+        rec.id2 = get<uint64_t>(p);
+        break;
+    }
+    offset = p - d.data();
+    return true;
+}
+} // namespace util
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_SCV_BINARY_READER_H_
+#define _UTIL_SCV_BINARY_READER_H_
+
+#include "mmap_file.h"
+#include "scv_binary_format.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace util {
+/**
+ * @class scv_binary_reader
+ * @brief provides random access to a binary transaction database written by scv_tr_binary
+ *
+ * All files are memory mapped, only the control file is parsed when opening the database. The data records are
+ * decoded on demand, the timing file allows to locate the first record at or after a given time in O(log n).
+ */
+class scv_binary_reader {
+public:
+    struct stream_desc {
+        uint64_t id;
+        std::string name;
+        std::string kind;
+    };
+    struct generator_desc {
+        uint64_t id;
+        std::string name;
+        uint64_t stream;
+    };
+    /**
+     * @struct record
+     * @brief a decoded data record, only the members belonging to the record type are valid
+     */
+    struct record {
+        scv_binary::data_record type;
+        //! the transaction id, the first transaction of a RELATION
+        uint64_t id;
+        //! the stream of the transaction, the stream of the first transaction of a RELATION
+        uint64_t stream;
+        //! the generator of TX_BEGIN
+        uint64_t generator;
+        //! the time of TX_BEGIN and TX_END
+        uint64_t time;
+        uint32_t concurrency;
+        scv_binary::event_type event;
+        scv_binary::data_type data_type;
+        //! the name of an ATTRIBUTE or RELATION
+        std::string const* name;
+        //! the raw value of an ATTRIBUTE
+        uint64_t value;
+        //! the stream and id of the second transaction of a RELATION
+        uint64_t stream2, id2;
+        //! the value of a string typed ATTRIBUTE
+        std::string const& string_value(scv_binary_reader const& r) const { return r.get_string(value); }
+        //! the value of a floating point ATTRIBUTE
+        double double_value() const {
+            double ret;
+            memcpy(&ret, &value, sizeof(double));
+            return ret;
+        }
+    };
+    /**
+     * @fn  scv_binary_reader(const std::string&)
+     * @brief opens the database directory and reads the control file, throws std::runtime_error if this fails
+     */
+    explicit scv_binary_reader(std::string const& name);
+
+    std::vector<stream_desc> const& get_streams() const { return streams; }
+
+    std::vector<generator_desc> const& get_generators() const { return generators; }
+    //! the time unit of the simulation as power of 10 of seconds
+    int get_time_resolution() const { return time_resolution; }
+    //! returns the string with the given id, an empty string if there is none
+    std::string const& get_string(uint64_t id) const;
+    //! the number of transaction begin and end events
+    uint64_t get_timing_entries() const { return timing_count; }
+    //! the time of the last transaction event
+    uint64_t get_end_time() const;
+    //! the data file offset of the first record
+    uint64_t begin() const { return sizeof(scv_binary::magic); }
+    //! the data file offset of the first transaction event at or after time, end of the data if there is none
+    uint64_t seek(uint64_t time) const;
+    //! decodes the record at offset and advances offset to the next record, returns false at the end of the data
+    bool next(uint64_t& offset, record& rec) const;
+
+private:
+    void timing_entry(uint64_t idx, uint64_t& time, uint64_t& offset) const;
+    mmap_reader c, d, t;
+    int time_resolution{-12};
+    uint64_t timing_count{0};
+    std::unordered_map<uint64_t, std::string> strings;
+    std::vector<stream_desc> streams;
+    std::vector<generator_desc> generators;
+};
+} // namespace util
+#endif /* _UTIL_SCV_BINARY_READER_H_ */
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************
+ *
+ * Layout of the sharded transaction database written by scv_tr_mtc (all numbers little endian):
+ *
+ *   header:  char magic[8], int64 time unit as power of 10 of seconds
+ *   frames:  block_desc followed by the LZ4 compressed block, each holding a sequence of records of one shard
+ *   index:   block_desc[block_count], sorted by kind, stream and first_time
+ *   trailer: uint64_t index offset, uint64_t block_count, char magic[8]
+ *
+ * A shard is either the metadata shard (strings, streams, generators, relations) or the transaction shard of a
+ * single stream. Records are varint encoded (LEB128), the first byte being the record tag. Transaction ids are delta
+ * encoded relative to the previous record in the same block, times relative to the previous time in the block
+ * starting at first_time of the block descriptor. Attribute records belong to the time of the preceding event. So
+ * each block can be decoded on its own once the metadata blocks have been read. As blocks are compressed and written
+ * concurrently their order in the file is arbitrary; the sorted index allows a binary search for the blocks of a
+ * stream covering a given time. As every frame carries its descriptor (whose offset is the position of the data) a
+ * file without index and trailer, e.g. after a crash of the simulation, can still be read by scanning the frames.
+ */
+
+#ifndef _UTIL_SCV_MTC_FORMAT_H_
+#define _UTIL_SCV_MTC_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace util {
+namespace scv_mtc {
+//! the file identification, the last byte denotes the version
+static constexpr char magic[8] = {'S', 'C', 'V', 'M', 'T', 'C', '\0', '\2'};
+//! the size of the file header
+static constexpr size_t header_size = sizeof(magic) + sizeof(int64_t);
+
+enum record_tag : uint8_t {
+    STRING = 1,  // id, length, characters
+    STREAM,      // id, name id, kind id
+    GENERATOR,   // id, name id, stream id
+    RELATION,    // name id, sink tx id, source tx id
+    TX_BEGIN,    // tx id delta (zigzag), generator id, time delta
+    TX_END,      // tx id delta (zigzag), time delta
+    ATTR_STRING, // tx id delta (zigzag), event, name id, data type, string id
+    ATTR_INT,    // tx id delta (zigzag), event, name id, data type, zigzag value
+    ATTR_UINT,   // tx id delta (zigzag), event, name id, data type, value
+    ATTR_DOUBLE, // tx id delta (zigzag), event, name id, data type, 8 byte IEEE 754 value
+};
+
+enum event_type : uint8_t { BEGIN = 0, RECORD = 1, END = 2 };
+
+enum block_kind : uint32_t { META_BLOCK, TX_BLOCK };
+//! entry of the on-disk block index and header of each frame
+struct block_desc {
+    uint64_t stream;     // the stream id for TX_BLOCK, 0 for META_BLOCK
+    uint64_t first_time; // the time of the first transaction event in the block
+    uint64_t last_time;  // the time of the last transaction event in the block
+    uint64_t offset;     // file offset of the compressed data
+    uint32_t comp_size;
+    uint32_t raw_size;
+    uint32_t count; // number of records
+    uint32_t kind;
+};
+static_assert(sizeof(block_desc) == 48, "unexpected padding of block_desc");
+//! decodes a LEB128 number and advances p behind it, returns false if the number is not complete before end
+inline bool get(uint8_t const*& p, uint8_t const* end, uint64_t& v) {
+    v = 0;
+    for(unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        auto b = *p++;
+        v |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if(!(b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+inline bool get_signed(uint8_t const*& p, uint8_t const* end, int64_t& v) {
+    uint64_t u;
+    if(!get(p, end, u))
+        return false;
+    v = static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
+    return true;
+}
+} // namespace scv_mtc
+} // namespace util
+#endif /* _UTIL_SCV_MTC_FORMAT_H_ */
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "scv_mtc_reader.h"
+#include <algorithm>
+#include <lz4.h>
+#include <stdexcept>
+#include <tuple>
+
+namespace util {
+using namespace scv_mtc;
+
+namespace {
+inline void check(bool ok) {
+    if(!ok)
+        throw std::runtime_error("corrupt block in transaction database");
+}
+
+inline uint64_t next(uint8_t const*& p, uint8_t const* end) {
+    uint64_t v;
+    check(get(p, end, v));
+    return v;
+}
+
+//! the order of the index written by scv_tr_mtc
+inline bool index_order(block_desc const& a, block_desc const& b) {
+    return std::tie(a.kind, a.stream, a.first_time, a.offset) < std::tie(b.kind, b.stream, b.first_time, b.offset);
+}
+} // namespace
+
+scv_mtc_reader::scv_mtc_reader(std::string const& name)
+: in(name, std::ios::in | std::ios::binary) {
+    char header[sizeof(magic)];
+    if(!in.is_open() || !in.read(header, sizeof(header)) || memcmp(header, magic, sizeof(magic)) != 0)
+        throw std::runtime_error(name + " is not a sharded transaction database file");
+    int64_t time_unit;
+    if(!in.read(reinterpret_cast<char*>(&time_unit), sizeof(time_unit)))
+        throw std::runtime_error(name + " is truncated");
+    time_resolution = static_cast<int>(time_unit);
+    in.seekg(0, std::ios::end);
+    file_size = static_cast<uint64_t>(in.tellg());
+    std::vector<block_desc> index;
+    // a properly closed file ends with the index and the trailer
+    uint64_t trailer[2];
+    char tail[sizeof(magic)];
+    if(file_size >= header_size + sizeof(trailer) + sizeof(tail)) {
+        in.seekg(file_size - sizeof(trailer) - sizeof(tail));
+        in.read(reinterpret_cast<char*>(trailer), sizeof(trailer));
+        in.read(tail, sizeof(tail));
+        complete = in && memcmp(tail, magic, sizeof(magic)) == 0 &&
+                   trailer[0] + trailer[1] * sizeof(block_desc) + sizeof(trailer) + sizeof(tail) == file_size;
+    }
+    if(complete) {
+        index.resize(trailer[1]);
+        in.seekg(trailer[0]);
+        if(!in.read(reinterpret_cast<char*>(index.data()), index.size() * sizeof(block_desc)))
+            throw std::runtime_error(name + " has a truncated index");
+    } else {
+        // recover the index from the frame headers, a truncated last frame is ignored
+        in.clear();
+        block_desc desc;
+        for(uint64_t pos = header_size; pos + sizeof(block_desc) <= file_size; pos = desc.offset + desc.comp_size) {
+            in.seekg(pos);
+            if(!in.read(reinterpret_cast<char*>(&desc), sizeof(block_desc)) || desc.offset != pos + sizeof(block_desc) ||
+               desc.kind > TX_BLOCK || desc.offset + desc.comp_size > file_size)
+                break;
+            index.push_back(desc);
+        }
+        in.clear();
+        std::sort(index.begin(), index.end(), index_order);
+    }
+    std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> stream_recs, generator_recs;
+    for(auto& desc : index) {
+        if(desc.kind == TX_BLOCK) {
+            blocks.push_back(desc);
+            continue;
+        }
+        auto data = load(desc);
+        uint8_t const* p = data.data();
+        auto end = p + data.size();
+        while(p < end) {
+            switch(*p++) {
+            case STRING: {
+                auto id = next(p, end);
+                auto len = next(p, end);
+                check(len <= static_cast<uint64_t>(end - p));
+                strings[id].assign(reinterpret_cast<char const*>(p), len);
+                p += len;
+            } break;
+            case STREAM: {
+                auto id = next(p, end);
+                auto name_id = next(p, end);
+                stream_recs.emplace_back(id, name_id, next(p, end));
+            } break;
+            case GENERATOR: {
+                auto id = next(p, end);
+                auto name_id = next(p, end);
+                generator_recs.emplace_back(id, name_id, next(p, end));
+            } break;
+            case RELATION: {
+                auto name_id = next(p, end);
+                auto sink = next(p, end);
+                auto source = next(p, end);
+                relations.push_back(relation_desc{name_id, sink, source});
+            } break;
+            default:
+                check(false);
+            }
+        }
+    }
+    // the metadata blocks are not written in order, so the names are resolved once all strings are known
+    std::sort(stream_recs.begin(), stream_recs.end());
+    for(auto& e : stream_recs)
+        streams.push_back({std::get<0>(e), get_string(std::get<1>(e)), get_string(std::get<2>(e))});
+    std::sort(generator_recs.begin(), generator_recs.end());
+    for(auto& e : generator_recs)
+        generators.push_back({std::get<0>(e), get_string(std::get<1>(e)), std::get<2>(e)});
+}
+
+std::string const& scv_mtc_reader::get_string(uint64_t id) const {
+    static const std::string empty;
+    auto it = strings.find(id);
+    return it == strings.end() ? empty : it->second;
+}
+
+std::vector<uint8_t> scv_mtc_reader::load(block_desc const& desc) const {
+    std::vector<char> comp(desc.comp_size);
+    std::vector<uint8_t> data(desc.raw_size);
+    in.seekg(desc.offset);
+    if(!in.read(comp.data(), comp.size()))
+        throw std::runtime_error("truncated block in transaction database");
+    auto size = LZ4_decompress_safe(comp.data(), reinterpret_cast<char*>(data.data()), static_cast<int>(comp.size()),
+                                    static_cast<int>(data.size()));
+    check(size >= 0 && static_cast<uint32_t>(size) == desc.raw_size);
+    return data;
+}
+
+void scv_mtc_reader::read_block(block_desc const& desc, std::vector<record>& recs) const {
+    recs.clear();
+    recs.reserve(desc.count);
+    auto data = load(desc);
+    uint8_t const* p = data.data();
+    auto end = p + data.size();
+    uint64_t id = 0, time = desc.first_time;
+    int64_t delta;
+    record rec{};
+    while(p < end) {
+        rec.type = static_cast<record_tag>(*p++);
+        check(get_signed(p, end, delta));
+        rec.id = id += static_cast<uint64_t>(delta);
+        switch(rec.type) {
+        case TX_BEGIN:
+            rec.generator = next(p, end);
+            rec.time = time += next(p, end);
+            break;
+        case TX_END:
+            rec.time = time += next(p, end);
+            break;
+        case ATTR_STRING:
+        case ATTR_INT:
+        case ATTR_UINT:
+        case ATTR_DOUBLE:
+            rec.time = time;
+            rec.event = static_cast<event_type>(next(p, end));
+            rec.name = &get_string(next(p, end));
+            rec.data_type = static_cast<uint8_t>(next(p, end));
+            if(rec.type == ATTR_DOUBLE) {
+                check(end - p >= static_cast<std::ptrdiff_t>(sizeof(double)));
+                memcpy(&rec.value, p, sizeof(double));
+                p += sizeof(double);
+            } else if(rec.type == ATTR_INT) {
+                int64_t v;
+                check(get_signed(p, end, v));
+                rec.value = static_cast<uint64_t>(v);
+            } else
+                rec.value = next(p, end);
+            break;
+        default:
+            check(false);
+        }
+        recs.push_back(rec);
+    }
+}
+} // namespace util
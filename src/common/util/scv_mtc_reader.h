@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_SCV_MTC_READER_H_
+#define _UTIL_SCV_MTC_READER_H_
+
+#include "scv_mtc_format.h"
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace util {
+/**
+ * @class scv_mtc_reader
+ * @brief reads a sharded transaction database written by scv_tr_mtc
+ *
+ * Opening the database reads the block index (or recovers it by scanning the frames if the file has not been closed
+ * properly) and all metadata blocks. The transaction blocks are decompressed and decoded on demand, they are listed
+ * sorted by stream and time.
+ */
+class scv_mtc_reader {
+public:
+    struct stream_desc {
+        uint64_t id;
+        std::string name;
+        std::string kind;
+    };
+    struct generator_desc {
+        uint64_t id;
+        std::string name;
+        uint64_t stream;
+    };
+    struct relation_desc {
+        uint64_t name;
+        uint64_t sink;
+        uint64_t source;
+    };
+    /**
+     * @struct record
+     * @brief a decoded transaction record, only the members belonging to the record type are valid
+     */
+    struct record {
+        scv_mtc::record_tag type;
+        uint64_t id;
+        //! the generator of TX_BEGIN
+        uint64_t generator;
+        //! the time of TX_BEGIN and TX_END, attributes carry the time of the preceding event
+        uint64_t time;
+        scv_mtc::event_type event;
+        //! the data type of an attribute, the values match scv_extensions_if::data_type
+        uint8_t data_type;
+        //! the name of an attribute
+        std::string const* name;
+        //! the string id of ATTR_STRING, the (two's complement) value of ATTR_INT and ATTR_UINT and the IEEE 754 bit
+        //! pattern of ATTR_DOUBLE
+        uint64_t value;
+        //! the value of ATTR_STRING
+        std::string const& string_value(scv_mtc_reader const& r) const { return r.get_string(value); }
+        //! the value of ATTR_DOUBLE
+        double double_value() const {
+            double ret;
+            memcpy(&ret, &value, sizeof(double));
+            return ret;
+        }
+    };
+    /**
+     * @fn  scv_mtc_reader(const std::string&)
+     * @brief opens the database and reads its index and metadata, throws std::runtime_error if this fails
+     */
+    explicit scv_mtc_reader(std::string const& name);
+
+    std::vector<stream_desc> const& get_streams() const { return streams; }
+
+    std::vector<generator_desc> const& get_generators() const { return generators; }
+
+    std::vector<relation_desc> const& get_relations() const { return relations; }
+    //! the transaction blocks sorted by stream and time
+    std::vector<scv_mtc::block_desc> const& get_blocks() const { return blocks; }
+    //! the time unit of the simulation as power of 10 of seconds
+    int get_time_resolution() const { return time_resolution; }
+    //! false if the file has no index, i.e. the recording has not been closed properly
+    bool is_complete() const { return complete; }
+    //! returns the string with the given id, an empty string if there is none
+    std::string const& get_string(uint64_t id) const;
+    //! decodes the records of a transaction block into recs, throws std::runtime_error if the block is corrupt
+    void read_block(scv_mtc::block_desc const& desc, std::vector<record>& recs) const;
+
+private:
+    std::vector<uint8_t> load(scv_mtc::block_desc const& desc) const;
+    mutable std::ifstream in;
+    uint64_t file_size{0};
+    int time_resolution{-12};
+    bool complete{false};
+    std::vector<scv_mtc::block_desc> blocks;
+    std::unordered_map<uint64_t, std::string> strings;
+    std::vector<stream_desc> streams;
+    std::vector<generator_desc> generators;
+    std::vector<relation_desc> relations;
+};
+} // namespace util
+#endif /* _UTIL_SCV_MTC_READER_H_ */
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_SPSC_RING_H_
+#define _UTIL_SPSC_RING_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace util {
+/**
+ * @class spsc_ring
+ * @brief lock-free byte ring buffer for exactly one producer and one consumer thread
+ *
+ * The read and write positions are free running counters, the buffer size is rounded up to a power of 2. Each side
+ * keeps a cached copy of the position of the other side so that the shared cache lines are only touched if the cached
+ * view does not provide enough space resp. data.
+ */
+class spsc_ring {
+public:
+    explicit spsc_ring(size_t capacity)
+    : buf(round_up(capacity))
+    , mask(buf.size() - 1) {}
+
+    spsc_ring(spsc_ring const&) = delete;
+    spsc_ring& operator=(spsc_ring const&) = delete;
+    /**
+     * @brief copies up to len bytes into the buffer, to be called by the producer only
+     *
+     * @return the number of bytes written
+     */
+    size_t write(void const* data, size_t len) {
+        auto head = wr_pos.load(std::memory_order_relaxed);
+        if(buf.size() - (head - rd_cache) < len)
+            rd_cache = rd_pos.load(std::memory_order_acquire);
+        auto n = std::min(len, buf.size() - (head - rd_cache));
+        if(n) {
+            auto ofs = head & mask;
+            auto first = std::min(n, buf.size() - ofs);
+            memcpy(buf.data() + ofs, data, first);
+            memcpy(buf.data(), static_cast<uint8_t const*>(data) + first, n - first);
+            wr_pos.store(head + n, std::memory_order_release);
+        }
+        return n;
+    }
+    /**
+     * @brief copies up to len bytes out of the buffer, to be called by the consumer only
+     *
+     * @return the number of bytes read
+     */
+    size_t read(void* data, size_t len) {
+        auto tail = rd_pos.load(std::memory_order_relaxed);
+        if(wr_cache - tail < len)
+            wr_cache = wr_pos.load(std::memory_order_acquire);
+        auto n = std::min(len, wr_cache - tail);
+        if(n) {
+            auto ofs = tail & mask;
+            auto first = std::min(n, buf.size() - ofs);
+            memcpy(data, buf.data() + ofs, first);
+            memcpy(static_cast<uint8_t*>(data) + first, buf.data(), n - first);
+            rd_pos.store(tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+    //! the number of bytes currently stored, exact only if called by one of the two sides
+    size_t size() const { return wr_pos.load(std::memory_order_acquire) - rd_pos.load(std::memory_order_acquire); }
+
+    size_t capacity() const { return buf.size(); }
+
+private:
+    static size_t round_up(size_t v) {
+        size_t ret = 64;
+        while(ret < v)
+            ret <<= 1;
+        return ret;
+    }
+    std::vector<uint8_t> buf;
+    const size_t mask;
+    // producer and consumer side are kept in separate cache lines
+    char pad0[64];
+    std::atomic<size_t> wr_pos{0};
+    size_t rd_cache{0};
+    char pad1[64 - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+    std::atomic<size_t> rd_pos{0};
+    size_t wr_cache{0};
+    char pad2[64 - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+};
+} // namespace util
+#endif /* _UTIL_SPSC_RING_H_ */
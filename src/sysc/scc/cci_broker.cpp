@@ -56,20 +56,12 @@ cci_originator cci_broker::get_value_origin(const std::string& parname) const {
 }
 
 void cci_broker::insert_matching_preset_value(const std::string& parname) {
-    bool match = false;
-    for(auto const& e : wildcard_presets) {
-        if(std::regex_match(parname, e.second.rr)) {
-            consuming_broker::set_preset_cci_value(parname, e.second.value, e.second.originator);
-            match = true;
-            break;
-        }
+    auto id = wildcard_preset_index.find_first(parname);
+    if(id != util::glob_trie::npos) {
+        consuming_broker::set_preset_cci_value(parname, wildcard_presets[id].value, wildcard_presets[id].originator);
+        if(wildcard_lock_index.matches(parname))
+            consuming_broker::lock_preset_value(parname);
     }
-    if(match)
-        for(auto const& e : wildcard_locks) {
-            if(std::regex_match(parname, e.second)) {
-                consuming_broker::lock_preset_value(parname);
-            }
-        }
 }
 
 bool cci_broker::has_preset_value(const std::string& parname) const {
@@ -150,12 +142,9 @@ void cci_broker::set_preset_cci_value(const std::string& parname, const cci_valu
         return m_parent.set_preset_cci_value(parname, value, originator);
     } else {
         try {
-            if(parname.find_first_of("*?[") != std::string::npos) {
-                wildcard_presets.insert(std::pair<std::string, wildcard_entry>(
-                    parname, wildcard_entry{std::regex(util::glob_to_regex(parname)), value, originator}));
-            } else if(parname[0] == '^') {
-                wildcard_presets.insert(
-                    std::pair<std::string, wildcard_entry>(parname, wildcard_entry{std::regex(parname), value, originator}));
+            if(parname.find_first_of("*?[") != std::string::npos || parname[0] == '^') {
+                if(wildcard_preset_index.insert(parname).second)
+                    wildcard_presets.push_back(wildcard_entry{value, originator});
             } else
                 consuming_broker::set_preset_cci_value(parname, value, originator);
         } catch(std::regex_error& e) {
@@ -169,10 +158,8 @@ void cci_broker::lock_preset_value(const std::string& parname) {
         m_parent.lock_preset_value(parname);
     } else {
         try {
-            if(parname.find_first_of("*?[") != std::string::npos) {
-                wildcard_locks.insert(std::pair<std::string, std::regex>(parname, std::regex(util::glob_to_regex(parname))));
-            } else if(parname[0] == '^') {
-                wildcard_locks.insert(std::pair<std::string, std::regex>(parname, std::regex(parname)));
+            if(parname.find_first_of("*?[") != std::string::npos || parname[0] == '^') {
+                wildcard_lock_index.insert(parname);
             } else
                 consuming_broker::lock_preset_value(parname);
         } catch(std::regex_error& e) {
@@ -21,10 +21,9 @@
 #if CCI_VERSION_MAJOR == 1 && CCI_VERSION_MINOR == 0 && CCI_VERSION_PATCH == 0
 #include <cci_utils/consuming_broker.h>
 #endif
-#include <regex>
 #include <string>
-#include <unordered_map>
 #include <unordered_set>
+#include <util/glob_trie.h>
 #include <vector>
 
 namespace scc {
@@ -50,12 +49,13 @@ class cci_broker : public cci_utils::consuming_broker {
     void insert_matching_preset_value(const std::string& parname);
 
     struct wildcard_entry {
-        std::regex rr;
         cci::cci_value value;
         cci::cci_originator originator;
     };
-    std::unordered_map<std::string, wildcard_entry> wildcard_presets;
-    std::unordered_map<std::string, std::regex> wildcard_locks;
+    //! the values of the wildcard presets indexed by their id in wildcard_preset_index
+    std::vector<wildcard_entry> wildcard_presets;
+    util::glob_trie wildcard_preset_index;
+    util::glob_trie wildcard_lock_index;
 
 public:
     cci::cci_originator get_value_origin(const std::string& parname) const override;
@@ -77,6 +77,7 @@ public:
      * The globbing supports ?,*,**, and character classes ([a-z] as well as [!a-z]). '.' acts as
      * hierarchy delimiter and is only matched with **
      * Regular expression must start with a carret ('^') so that it can be identified as regex.
+     * If several patterns match a parameter the one being set first applies.
      *
      * The preset value has priority to the default value being set by the owner!
      *
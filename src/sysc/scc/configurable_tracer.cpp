@@ -21,6 +21,8 @@ using namespace sc_core;
 using namespace scc;
 
 #define EN_TRACING_STR "enableTracing"
+#define EVERY_NTH_STR "traceEveryNth"
+#define MIN_INTERVAL_STR "traceMinInterval"
 
 configurable_tracer::configurable_tracer(std::string const&& name, bool enable_tx, bool enable_vcd, sc_core::sc_object* top)
 : tracer(std::move(name), enable_tx ? ENABLE : NONE, enable_vcd ? ENABLE : NONE, top) {}
@@ -41,12 +43,14 @@ scc::configurable_tracer::~configurable_tracer() {
 
 // const std::unordered_set<std::string> traceable_kinds = {};
 void configurable_tracer::descend(const sc_core::sc_object* obj, bool trace) {
-    if(obj == this)
+    if(obj == this || !enter_filter(obj))
         return;
+    if(filter_included())
+        trace = true;
     const std::string kind = obj->kind();
     if((types_to_trace & trace_types::SIGNALS) == trace_types::SIGNALS && kind == "tlm_signal") {
         if(trace)
-            obj->trace(trf);
+            trace_object(obj);
         return;
     } else if(kind == "sc_vector") {
         if(trace)
@@ -54,23 +58,38 @@ void configurable_tracer::descend(const sc_core::sc_object* obj, bool trace) {
                 descend(o, trace);
         return;
     } else if(kind == "sc_module") {
-        auto trace_enable = get_trace_enabled(obj, default_trace_enable_handle.get_cci_value().get<bool>());
-        if(trace_enable)
+        // an explicit include pattern saves the lookup of the per-module attribute
+        auto trace_enable = filter_included() || get_trace_enabled(obj, default_trace_enable_handle.get_cci_value().get<bool>());
+        // the sampling policy is inherited by the subtree of the module
+        auto* sampling_ctrl = dynamic_cast<sampling_control*>(trf);
+        auto parent_sampling = current_sampling;
+        if(sampling_ctrl) {
+            current_sampling = get_sampling_policy(obj, parent_sampling);
+            sampling_ctrl->set_sampling_policy(current_sampling);
+        }
+        if(trace_enable && filter_selected())
             obj->trace(trf);
         for(auto o : obj->get_child_objects())
             descend(o, trace_enable);
+        if(sampling_ctrl) {
+            current_sampling = parent_sampling;
+            sampling_ctrl->set_sampling_policy(parent_sampling);
+        }
     } else if(kind == "sc_variable") {
         if(trace && (types_to_trace & trace_types::VARIABLES) == trace_types::VARIABLES)
-            obj->trace(trf);
+            trace_object(obj);
     } else if(kind == "sc_signal" || kind == "sc_clock" || kind == "sc_buffer" || kind == "sc_signal_rv") {
         if(trace && (types_to_trace & trace_types::SIGNALS) == trace_types::SIGNALS)
-            try_trace(trf, obj, types_to_trace);
+            try_trace_object(obj);
+    } else if(kind == "fifo_w_cb" || kind == "sc_owning_signal") {
+        if(trace && (types_to_trace & trace_types::SIGNALS) == trace_types::SIGNALS)
+            trace_object(obj);
     } else if(kind == "sc_in" || kind == "sc_out" || kind == "sc_inout") {
         if(trace && (types_to_trace & trace_types::PORTS) == trace_types::PORTS)
-            try_trace(trf, obj, types_to_trace);
+            try_trace_object(obj);
     } else if(const auto* tr = dynamic_cast<const scc::traceable*>(obj)) {
         if(tr->is_trace_enabled())
-            obj->trace(trf);
+            trace_object(obj);
         for(auto o : obj->get_child_objects())
             descend(o, tr->is_trace_enabled());
         //    } else if(trace && traceable_kinds.find(kind)!=traceable_kinds.end()) {
@@ -92,6 +111,29 @@ auto scc::configurable_tracer::get_trace_enabled(const sc_core::sc_object* obj,
     return fall_back;
 }
 
+auto scc::configurable_tracer::get_sampling_policy(const sc_core::sc_object* obj, sampling_policy const& fall_back) -> sampling_policy {
+    auto lookup = [this, obj](char const* attr_name) -> cci::cci_value {
+        std::string hier_name{obj->name()};
+        hier_name.append(".").append(attr_name);
+        auto h = cci_broker.get_param_handle(hier_name);
+        if(h.is_valid())
+            return h.get_cci_value();
+        if(cci_broker.has_preset_value(hier_name))
+            return cci_broker.get_preset_cci_value(hier_name);
+        return cci::cci_value();
+    };
+    auto ret = fall_back;
+    auto every_nth = lookup(EVERY_NTH_STR);
+    if(every_nth.is_uint())
+        ret.every_nth = every_nth.get_uint();
+    auto min_interval = lookup(MIN_INTERVAL_STR);
+    if(min_interval.is_string())
+        ret.min_interval = parse_from_string(min_interval.get_string());
+    else if(min_interval.is_number())
+        ret.min_interval = sc_core::sc_time(min_interval.get_number(), sc_core::SC_PS);
+    return ret;
+}
+
 void configurable_tracer::augment_object_hierarchical(sc_core::sc_object* obj, bool trace_enable) {
     if(dynamic_cast<sc_core::sc_module*>(obj) != nullptr || dynamic_cast<scc::traceable*>(obj) != nullptr) {
         auto* attr = obj->get_attribute(EN_TRACING_STR);
@@ -18,6 +18,7 @@
 #define _SCC_CONFIGURABLE_TRACER_H_
 
 #include "tracer.h"
+#include "trace.h"
 /** \ingroup scc-sysc
  *  @{
  */
@@ -30,7 +31,11 @@ namespace scc {
  *
  * This class traverses the SystemC object hierarchy and registers all signals and ports found with the tracing
  * infrastructure. Using a sc_core::sc_attribute or a CCI param named "enableTracing" this can be switch on or off
- * on a per module basis
+ * on a per module basis.
+ *
+ * The CCI params (or preset values) "traceEveryNth" and "traceMinInterval" of a module set a sampling_policy for the
+ * signals of the module and its subtree if the signal trace file supports it. "traceMinInterval" is either a time
+ * string like "10ns" or a number of picoseconds.
  */
 class configurable_tracer : public tracer {
 public:
@@ -130,11 +135,15 @@ protected:
     bool get_trace_enabled(const sc_core::sc_object*, bool = false);
     //! add the 'enableTracing' attribute to sc_module
     void augment_object_hierarchical(sc_core::sc_object*, bool);
+    //! check for 'traceEveryNth' and 'traceMinInterval' of the module and return the policy of the parent otherwise
+    sampling_policy get_sampling_policy(const sc_core::sc_object*, sampling_policy const&);
 
     void end_of_elaboration() override;
     //! array of created cci parameter
     std::vector<cci::cci_param_untyped*> params;
     bool control_added{false};
+    //! the sampling policy of the module currently being descended into
+    sampling_policy current_sampling;
 };
 
 } /* namespace scc */
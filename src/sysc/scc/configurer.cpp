@@ -15,23 +15,31 @@
  *******************************************************************************/
 
 #include "configurer.h"
-#include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
+#include "rapidjson/reader.h"
 #include "report.h"
+#include <algorithm>
 #include <cci_configuration>
 #include <cerrno>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fmt/format.h>
 #include <fstream>
 #include <limits>
+#include <map>
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/prettywriter.h>
+#include <random>
+#include <sstream>
 #include <unordered_map>
+#include <util/config_snapshot_format.h>
+#include <util/glob_trie.h>
 #ifdef HAS_YAMPCPP
+#include <yaml-cpp/eventhandler.h>
 #include <yaml-cpp/exceptions.h>
-#include <yaml-cpp/node/parse.h>
+#include <yaml-cpp/parser.h>
 #include <yaml-cpp/yaml.h>
 
 namespace {
@@ -92,8 +100,251 @@ inline auto get_sc_objects(sc_core::sc_object* obj = nullptr) -> const std::vect
 #define DIR_SEPARATOR '/'
 #endif
 
+/**
+ * the values read from the input files together with the files they depend on and the overrides applied before. It
+ * is kept in a binary file (see util/config_snapshot_format.h) so that subsequent runs can apply the values of
+ * unchanged input files without parsing them. Overrides applied after reading and the sc_attributes being mirrored
+ * during elaboration are derived from the resulting broker state in every run.
+ */
+struct config_snapshot {
+    struct file_info {
+        std::string name;
+        uint64_t size;
+        uint64_t hash;
+    };
+    struct source {
+        std::string name;
+        //! the hash of the overrides applied before the input file was read
+        uint64_t overrides;
+        std::vector<file_info> files;
+        std::vector<std::pair<std::string, cci::cci_value>> values;
+    };
+    std::vector<source> sources;
+
+    //! the hash of the overrides applied so far
+    uint64_t overrides{util::config_snapshot::hash_basis};
+
+    source* find(std::string const& name) {
+        for(auto& src : sources)
+            if(src.name == name && src.overrides == overrides)
+                return &src;
+        return nullptr;
+    }
+    //! returns true if none of the files of the source changed
+    static bool is_current(source const& src) {
+        for(auto& f : src.files) {
+            uint64_t size, hash;
+            if(!util::config_snapshot::hash_file(f.name, size, hash) || size != f.size || hash != f.hash)
+                return false;
+        }
+        return true;
+    }
+    //! adds an override to the hash of the overrides
+    void add_override(std::string const& name, cci::cci_value const& value) {
+        namespace cs = util::config_snapshot;
+        auto json = value.to_json();
+        overrides = cs::hash_bytes(cs::hash_bytes(overrides, name.c_str(), name.size() + 1), json.c_str(), json.size() + 1);
+    }
+
+    static void put_value(std::vector<uint8_t>& buf, cci::cci_value const& v) {
+        namespace cs = util::config_snapshot;
+        if(v.is_bool()) {
+            buf.push_back(cs::BOOL);
+            cs::put(buf, static_cast<uint64_t>(v.get_bool()));
+        } else if(v.is_int()) {
+            buf.push_back(cs::INT);
+            cs::put_signed(buf, v.get_int());
+        } else if(v.is_int64()) {
+            buf.push_back(cs::INT64);
+            cs::put_signed(buf, v.get_int64());
+        } else if(v.is_uint()) {
+            buf.push_back(cs::UINT);
+            cs::put(buf, static_cast<uint64_t>(v.get_uint()));
+        } else if(v.is_uint64()) {
+            buf.push_back(cs::UINT64);
+            cs::put(buf, static_cast<uint64_t>(v.get_uint64()));
+        } else if(v.is_double()) {
+            buf.push_back(cs::DOUBLE);
+            cs::put_double(buf, v.get_double());
+        } else if(v.is_string()) {
+            buf.push_back(cs::STRING);
+            auto str = v.get_string();
+            cs::put_string(buf, std::string(str.c_str(), str.size()));
+        } else {
+            buf.push_back(cs::JSON);
+            cs::put_string(buf, v.to_json());
+        }
+    }
+
+    static bool get_value(uint8_t const*& p, uint8_t const* end, cci::cci_value& v) {
+        namespace cs = util::config_snapshot;
+        if(p == end)
+            return false;
+        uint64_t u;
+        int64_t i;
+        double d;
+        std::string str;
+        switch(*p++) {
+        case cs::BOOL:
+            if(!cs::get(p, end, u))
+                return false;
+            v = cci::cci_value(u != 0);
+            return true;
+        case cs::INT:
+            if(!cs::get_signed(p, end, i))
+                return false;
+            v = cci::cci_value(static_cast<int>(i));
+            return true;
+        case cs::INT64:
+            if(!cs::get_signed(p, end, i))
+                return false;
+            v = cci::cci_value(i);
+            return true;
+        case cs::UINT:
+            if(!cs::get(p, end, u))
+                return false;
+            v = cci::cci_value(static_cast<unsigned>(u));
+            return true;
+        case cs::UINT64:
+            if(!cs::get(p, end, u))
+                return false;
+            v = cci::cci_value(u);
+            return true;
+        case cs::DOUBLE:
+            if(!cs::get_double(p, end, d))
+                return false;
+            v = cci::cci_value(d);
+            return true;
+        case cs::STRING:
+            if(!cs::get_string(p, end, str))
+                return false;
+            v = cci::cci_value(str);
+            return true;
+        case cs::JSON:
+            if(!cs::get_string(p, end, str))
+                return false;
+            v = cci::cci_value::from_json(str);
+            return true;
+        default:
+            return false;
+        }
+    }
+    //! reads the snapshot file, returns false if it does not exist or is malformed
+    bool read(std::string const& file_name) {
+        namespace cs = util::config_snapshot;
+        sources.clear();
+        std::ifstream ifs(file_name, std::ios::in | std::ios::binary);
+        if(!ifs.is_open())
+            return false;
+        std::vector<uint8_t> buf((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        if(buf.size() < sizeof(cs::magic) || memcmp(buf.data(), cs::magic, sizeof(cs::magic)))
+            return false;
+        uint8_t const* p = buf.data() + sizeof(cs::magic);
+        uint8_t const* end = buf.data() + buf.size();
+        while(p < end) {
+            source src;
+            uint64_t count;
+            if(!cs::get_string(p, end, src.name) || !cs::get(p, end, src.overrides) || !cs::get(p, end, count)) {
+                sources.clear();
+                return false;
+            }
+            for(; count; --count) {
+                file_info f;
+                if(!cs::get_string(p, end, f.name) || !cs::get(p, end, f.size) || !cs::get(p, end, f.hash)) {
+                    sources.clear();
+                    return false;
+                }
+                src.files.push_back(std::move(f));
+            }
+            if(!cs::get(p, end, count)) {
+                sources.clear();
+                return false;
+            }
+            std::string name, suffix;
+            for(; count; --count) {
+                uint64_t shared;
+                cci::cci_value value;
+                if(!cs::get(p, end, shared) || shared > name.size() || !cs::get_string(p, end, suffix) || !get_value(p, end, value)) {
+                    sources.clear();
+                    return false;
+                }
+                name.resize(shared);
+                name += suffix;
+                src.values.emplace_back(name, std::move(value));
+            }
+            sources.push_back(std::move(src));
+        }
+        return true;
+    }
+    //! writes the snapshot to a temporary file being renamed so that concurrent runs never see a partial snapshot
+    bool write(std::string const& file_name) const {
+        namespace cs = util::config_snapshot;
+        std::vector<uint8_t> buf(cs::magic, cs::magic + sizeof(cs::magic));
+        for(auto& src : sources) {
+            cs::put_string(buf, src.name);
+            cs::put(buf, src.overrides);
+            cs::put(buf, src.files.size());
+            for(auto& f : src.files) {
+                cs::put_string(buf, f.name);
+                cs::put(buf, f.size);
+                cs::put(buf, f.hash);
+            }
+            cs::put(buf, src.values.size());
+            std::string const* last = nullptr;
+            for(auto& v : src.values) {
+                size_t shared = 0;
+                if(last)
+                    while(shared < last->size() && shared < v.first.size() && (*last)[shared] == v.first[shared])
+                        ++shared;
+                cs::put(buf, shared);
+                cs::put_string(buf, v.first.substr(shared));
+                put_value(buf, v.second);
+                last = &v.first;
+            }
+        }
+        auto tmp_name = fmt::format("{}.{:x}", file_name, std::random_device()());
+        {
+            std::ofstream ofs(tmp_name, std::ios::out | std::ios::binary | std::ios::trunc);
+            if(!ofs.is_open() || !ofs.write(reinterpret_cast<char const*>(buf.data()), buf.size()))
+                return false;
+        }
+        if(std::rename(tmp_name.c_str(), file_name.c_str())) {
+            std::remove(tmp_name.c_str());
+            return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * the input stream of a configuration file. If the values are recorded for the snapshot the bytes are hashed while
+ * being parsed, so the hash matches the values even if the file is modified concurrently.
+ */
+struct config_input {
+    std::filebuf file;
+    util::config_snapshot::hashing_streambuf hashing{file};
+    std::istream is{nullptr};
+    //! the index of the file in the files of the recorded source
+    size_t file_idx{0};
+
+    bool open(std::string const& name, bool hashed) {
+        if(!file.open(name, std::ios::in | std::ios::binary))
+            return false;
+        is.rdbuf(hashed ? static_cast<std::streambuf*>(&hashing) : &file);
+        return true;
+    }
+    //! sets size and hash of the file once it has been parsed
+    void finish(config_snapshot::file_info& info) {
+        hashing.drain();
+        info.size = hashing.size();
+        info.hash = hashing.hash();
+    }
+};
+
 struct config_reader {
     std::vector<std::string> includes{"."};
+    //! if set the values being applied and the files being read are recorded
+    config_snapshot::source* recording{nullptr};
     void add_to_includes(std::string const& path) {
         for(auto& e : includes) {
             if(e == path)
@@ -114,6 +365,121 @@ struct config_reader {
             }
         return file_name;
     }
+    //! opens an included file and lets the reader of the included file inherit the include path and the recording,
+    //! returns false if the file cannot be opened
+    bool open_include(config_input& in, std::string const& file_name, config_reader& sub_reader) {
+        auto full_name = find_in_include_path(file_name);
+        if(!in.open(full_name, recording != nullptr))
+            return false;
+        sub_reader.includes = includes;
+        sub_reader.recording = recording;
+        if(recording) {
+            in.file_idx = recording->files.size();
+            recording->files.push_back(config_snapshot::file_info{full_name, 0, 0});
+        }
+        return true;
+    }
+    //! records size and hash of an included file once it has been parsed
+    void close_include(config_input& in) {
+        if(recording)
+            in.finish(recording->files[in.file_idx]);
+    }
+
+    void record(std::string const& name, cci::cci_value const& value) {
+        if(recording)
+            recording->values.emplace_back(name, value);
+    }
+};
+/**
+ * the parameters known to the broker indexed by name and by the name of their owning object. The index is built once
+ * and kept up to date using the creation and destruction callbacks of the broker so that lookups and dumps do not need
+ * to scan all parameters.
+ */
+struct param_index {
+    using handle_t = cci::cci_param_untyped_handle;
+    configurer::broker_t& broker;
+    //! the parameters sorted by their full name
+    std::map<std::string, handle_t> params;
+    //! the parameters of an object (the top-level ones under the empty name) sorted by name
+    std::unordered_map<std::string, std::vector<handle_t const*>> by_owner;
+    cci::cci_param_create_callback_handle create_cb;
+    cci::cci_param_destroy_callback_handle destroy_cb;
+
+    param_index(configurer::broker_t& broker)
+    : broker(broker) {
+        for(auto& h : broker.get_param_handles())
+            add(h.name());
+        create_cb = broker.register_create_callback(
+            cci::cci_param_create_callback([this](const cci::cci_param_untyped_handle& h) { add(h.name()); }));
+        destroy_cb = broker.register_destroy_callback(
+            cci::cci_param_destroy_callback([this](const cci::cci_param_untyped_handle& h) { remove(h.name()); }));
+    }
+
+    ~param_index() {
+        broker.unregister_create_callback(create_cb);
+        broker.unregister_destroy_callback(destroy_cb);
+    }
+
+    static std::string owner_name(std::string const& name) {
+        auto sep = name.rfind('.');
+        return sep == std::string::npos ? std::string() : name.substr(0, sep);
+    }
+    //! handles are obtained from the broker of the configurer so that writes carry its originator
+    void add(std::string const& name) {
+        auto h = broker.get_param_handle(name);
+        if(!h.is_valid())
+            return;
+        auto res = params.emplace(name, h);
+        if(!res.second)
+            return;
+        auto& owned = by_owner[owner_name(name)];
+        auto pos =
+            std::lower_bound(owned.begin(), owned.end(), name, [](handle_t const* a, std::string const& b) { return a->name() < b; });
+        owned.insert(pos, &res.first->second);
+    }
+
+    void remove(std::string const& name) {
+        auto it = params.find(name);
+        if(it == params.end())
+            return;
+        auto oit = by_owner.find(owner_name(name));
+        if(oit != by_owner.end()) {
+            auto& owned = oit->second;
+            owned.erase(std::remove(owned.begin(), owned.end(), &it->second), owned.end());
+            if(owned.empty())
+                by_owner.erase(oit);
+        }
+        params.erase(it);
+    }
+
+    handle_t* find(std::string const& name) {
+        auto it = params.find(name);
+        return it == params.end() ? nullptr : &it->second;
+    }
+    //! the parameters owned by the object with the given name
+    std::vector<handle_t const*> const* owned_by(std::string const& name) const {
+        auto it = by_owner.find(name);
+        return it == by_owner.end() ? nullptr : &it->second;
+    }
+    //! calls f for all parameters whose name starts with prefix
+    template <typename F> void for_each_with_prefix(std::string const& prefix, F f) {
+        for(auto it = params.lower_bound(prefix); it != params.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+            f(it->second);
+    }
+    /**
+     * calls f for all parameters matching the globbing expression or regular expression (starting with ^), only the
+     * parameters sharing the literal prefix of a globbing expression are visited
+     */
+    template <typename F> void for_each_matching(std::string const& pattern, F f) {
+        util::glob_trie trie;
+        trie.insert(pattern);
+        auto prefix = pattern[0] == '^' ? std::string() : pattern.substr(0, pattern.find_first_of("*?[\\"));
+        util::trim(prefix);
+        for_each_with_prefix(prefix, [&trie, &f](handle_t& h) {
+            if(trie.matches(h.name()))
+                f(h);
+        });
+    }
 };
 /*************************************************************************************************
  * JSON config start
@@ -152,18 +518,11 @@ inline bool start_object(writer_type& writer, char const* key, bool started) {
 struct json_config_dumper {
     configurer::broker_t const& broker;
     std::vector<std::string> const& stop_list;
-    std::unordered_map<std::string, std::vector<cci::cci_param_untyped_handle>> lut;
-    json_config_dumper(configurer::broker_t const& broker, std::vector<std::string> const& stop_list)
+    param_index const& index;
+    json_config_dumper(configurer::broker_t const& broker, std::vector<std::string> const& stop_list, param_index const& index)
     : broker(broker)
-    , stop_list(stop_list) {
-        for(auto& h : broker.get_param_handles()) {
-            auto value = h.get_cci_value();
-            std::string paramname{h.name()};
-            auto sep = paramname.rfind('.');
-            auto basename = paramname.substr(0, sep);
-            lut[basename].push_back(h);
-        }
-    }
+    , stop_list(stop_list)
+    , index(index) {}
 
     void dump_config(sc_core::sc_object* obj, writer_type& writer) {
         auto basename = std::string(obj->basename());
@@ -171,12 +530,11 @@ struct json_config_dumper {
             return;
         auto obj_started = false;
         auto log_lvl_set = false;
-        auto it = lut.find(obj->name());
-        if(it != lut.end())
-            for(auto& h : it->second) {
+        if(auto owned = index.owned_by(obj->name()))
+            for(auto* h : *owned) {
                 obj_started = start_object(writer, obj->basename(), obj_started);
-                auto value = h.get_cci_value();
-                std::string paramname{h.name()};
+                auto value = h->get_cci_value();
+                std::string paramname{h->name()};
                 auto basename = paramname.substr(paramname.rfind('.') + 1);
                 if(basename == SCC_LOG_LEVEL_PARAM_NAME)
                     log_lvl_set = true;
@@ -211,99 +569,138 @@ struct json_config_dumper {
     }
 };
 
-struct json_config_reader : public config_reader {
+/**
+ * a SAX handler applying the leaves of a JSON document to the broker while parsing. The hierarchical name of the
+ * current member is kept in a single buffer and files being referenced by "!include" members are read when they are
+ * encountered.
+ */
+struct json_config_reader : public config_reader, public BaseReaderHandler<UTF8<>, json_config_reader> {
     configurer::broker_t& broker;
-    Document document;
     bool valid{false};
-    bool empty{false};
+    std::string error_msg;
+    //! the hierarchical name of the current member
+    std::string name;
+    //! the length of the name the document is read into
+    size_t const prefix_len;
+    //! the length of the name prefix of each open object
+    std::vector<size_t> levels;
+    //! the nesting depth of the array being skipped
+    unsigned skip{0};
+    bool is_include{false};
 
-    json_config_reader(configurer::broker_t& broker)
-    : broker(broker) {}
+    json_config_reader(configurer::broker_t& broker, std::string const& prefix = "")
+    : broker(broker)
+    , name(prefix)
+    , prefix_len(prefix.size()) {}
 
     void parse(std::istream& is) {
         IStreamWrapper stream(is);
-        document.ParseStream(stream);
-        valid = !document.HasParseError();
-        empty = document.IsNull();
+        Reader reader;
+        error_msg.clear();
+        name.resize(prefix_len);
+        levels.clear();
+        skip = 0;
+        auto res = reader.Parse(stream, *this);
+        if(error_msg.size())
+            throw std::runtime_error(error_msg);
+        valid = !res.IsError();
+        if(!valid) {
+            std::ostringstream os;
+            os << " location " << (unsigned)res.Offset() << ", reason: " << GetParseError_En(res.Code());
+            error_msg = os.str();
+        }
     }
-    std::string get_error_msg() {
-        std::ostringstream os;
-        os << " location " << (unsigned)document.GetErrorOffset() << ", reason: " << GetParseError_En(document.GetParseError());
-        return os.str();
+
+    std::string get_error_msg() { return error_msg; }
+
+    bool StartObject() {
+        if(skip)
+            ++skip;
+        else
+            levels.push_back(name.size());
+        return true;
     }
 
-    inline void configure_cci() { configure_cci_hierarchical(document, ""); }
+    bool Key(const char* str, SizeType length, bool) {
+        if(!skip) {
+            name.resize(levels.back());
+            if(levels.back())
+                name += '.';
+            name.append(str, length);
+            is_include = length == 8 && !strncmp(str, "!include", length);
+        }
+        return true;
+    }
 
-    void configure_cci_hierarchical(Value const& value, std::string prefix) {
-        if(value.IsObject()) {
-            auto o = value.GetObject();
-            for(auto itr = o.MemberBegin(); itr != o.MemberEnd(); ++itr) {
-                if(!itr->name.IsString())
-                    return;
-                std::string key_name = itr->name.GetString();
-                Value const& val = itr->value;
-                auto hier_name = prefix.size() ? prefix + "." + key_name : key_name;
-                if(val.IsNull() || val.IsArray())
-                    return;
-                else if(val.IsObject())
-                    configure_cci_hierarchical(val, hier_name);
-                else {
-                    if(key_name == "!include") {
-                        json_config_reader sub_reader(broker);
-                        std::ifstream ifs(find_in_include_path(val.GetString()));
-                        if(ifs.is_open()) {
-                            sub_reader.parse(ifs);
-                            if(sub_reader.valid) {
-                                sub_reader.configure_cci_hierarchical(sub_reader.document, prefix);
-                            } else {
-                                std::ostringstream os;
-                                os << "Could not parse include file " << val.GetString();
-                                throw std::runtime_error(os.str());
-                            }
-                        } else {
-                            std::ostringstream os;
-                            os << "Could not open include file " << val.GetString();
-                            throw std::runtime_error(os.str());
-                        }
-                    } else {
-                        auto param_handle = broker.get_param_handle(hier_name);
-                        if(param_handle.is_valid()) {
-                            if(val.IsString()) {
-                                param_handle.set_cci_value(cci::cci_value(std::string(val.GetString())));
-                            } else if(val.IsBool()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<bool>()));
-                            } else if(val.IsInt()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<int>()));
-                            } else if(val.IsInt64()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<int64_t>()));
-                            } else if(val.IsUint()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<unsigned>()));
-                            } else if(val.IsUint64()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<uint64_t>()));
-                            } else if(val.IsDouble()) {
-                                param_handle.set_cci_value(cci::cci_value(val.Get<double>()));
-                            }
-                        } else {
-                            if(val.IsString()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(std::string(val.GetString())));
-                            } else if(val.IsBool()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<bool>()));
-                            } else if(val.IsInt()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<int>()));
-                            } else if(val.IsInt64()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<int64_t>()));
-                            } else if(val.IsUint()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<unsigned>()));
-                            } else if(val.IsUint64()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<uint64_t>()));
-                            } else if(val.IsDouble()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(val.Get<double>()));
-                            }
-                        }
-                    }
-                }
-            }
+    bool EndObject(SizeType) {
+        if(skip)
+            --skip;
+        else
+            levels.pop_back();
+        return true;
+    }
+
+    bool StartArray() {
+        ++skip;
+        return true;
+    }
+
+    bool EndArray(SizeType) {
+        --skip;
+        return true;
+    }
+
+    bool Bool(bool b) { return set(cci::cci_value(b)); }
+    // the types are chosen in the same order of preference as they were using the rapidjson DOM
+    bool Int(int i) { return set(cci::cci_value(i)); }
+    bool Uint(unsigned u) {
+        return u <= static_cast<unsigned>(std::numeric_limits<int>::max()) ? set(cci::cci_value(static_cast<int>(u)))
+                                                                           : set(cci::cci_value(static_cast<int64_t>(u)));
+    }
+    bool Int64(int64_t i) { return set(cci::cci_value(i)); }
+    bool Uint64(uint64_t u) {
+        return u <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) ? set(cci::cci_value(static_cast<int64_t>(u)))
+                                                                              : set(cci::cci_value(u));
+    }
+    bool Double(double d) { return set(cci::cci_value(d)); }
+
+    bool String(const char* str, SizeType length, bool) {
+        if(skip || levels.empty())
+            return true;
+        if(is_include)
+            return include(std::string(str, length));
+        return set(cci::cci_value(std::string(str, length)));
+    }
+    //! nulls as well as values outside of an object are ignored
+    bool Default() { return true; }
+
+private:
+    bool set(cci::cci_value&& value) {
+        if(skip || levels.empty() || is_include)
+            return true;
+        auto param_handle = broker.get_param_handle(name);
+        if(param_handle.is_valid())
+            param_handle.set_cci_value(value);
+        else
+            broker.set_preset_cci_value(name, value);
+        record(name, value);
+        return true;
+    }
+    //! reads the included file as part of the current object, errors are reported once the parser returns
+    bool include(std::string const& file_name) {
+        json_config_reader sub_reader(broker, name.substr(0, levels.back()));
+        config_input in;
+        if(!open_include(in, file_name, sub_reader)) {
+            error_msg = "Could not open include file " + file_name;
+            return false;
         }
+        sub_reader.parse(in.is);
+        if(!sub_reader.valid) {
+            error_msg = "Could not parse include file " + file_name;
+            return false;
+        }
+        close_include(in);
+        return true;
     }
 };
 /*************************************************************************************************
@@ -318,28 +715,18 @@ struct yaml_config_dumper {
     bool with_description{false};
     bool complete{true};
     std::vector<std::string> const& stop_list;
-    std::unordered_map<std::string, std::vector<cci::cci_param_untyped_handle>> lut;
-    std::vector<cci::cci_param_untyped_handle> tl_lut;
-    yaml_config_dumper(configurer::broker_t const& broker, bool with_description, bool complete, std::vector<std::string> const& stop_list)
+    param_index const& index;
+    yaml_config_dumper(configurer::broker_t const& broker, bool with_description, bool complete, std::vector<std::string> const& stop_list,
+                       param_index const& index)
     : broker(broker)
     , with_description(with_description)
     , complete(complete)
-    , stop_list(stop_list) {
-        for(auto& h : broker.get_param_handles()) {
-            auto value = h.get_cci_value();
-            std::string paramname{h.name()};
-            auto sep = paramname.rfind('.');
-            if(sep == std::string::npos) {
-                tl_lut.push_back(h);
-            } else {
-                auto basename = paramname.substr(0, sep);
-                lut[basename].push_back(h);
-            }
-        }
-    }
+    , stop_list(stop_list)
+    , index(index) {}
 
     void dump_config(YAML::Node& base_node) {
-        copy2yaml(tl_lut, base_node);
+        if(auto owned = index.owned_by(""))
+            copy2yaml(*owned, base_node);
         for(auto* o : sc_core::sc_get_top_level_objects()) {
             dump_config(o, base_node);
         }
@@ -351,10 +738,9 @@ struct yaml_config_dumper {
             return;
         auto obj_started = false;
         auto log_lvl_set = false;
-        auto it = lut.find(obj->name());
         YAML::Node this_node;
-        if(it != lut.end())
-            log_lvl_set |= copy2yaml(it->second, this_node);
+        if(auto owned = index.owned_by(obj->name()))
+            log_lvl_set |= copy2yaml(*owned, this_node);
         auto mod = dynamic_cast<sc_core::sc_module*>(obj);
         if(!log_lvl_set && mod && complete) {
             auto val = broker.get_preset_cci_value(fmt::format("{}.{}", obj->name(), SCC_LOG_LEVEL_PARAM_NAME));
@@ -370,16 +756,16 @@ struct yaml_config_dumper {
     }
 
 private:
-    bool copy2yaml(const std::vector<cci::cci_param_untyped_handle>& params, YAML::Node& this_node) {
+    bool copy2yaml(const std::vector<param_index::handle_t const*>& params, YAML::Node& this_node) {
         bool log_lvl_set = false;
-        for(auto& h : params) {
-            auto value = h.get_cci_value();
-            std::string paramname{h.name()};
+        for(auto* h : params) {
+            auto value = h->get_cci_value();
+            std::string paramname{h->name()};
             auto basename = paramname.substr(paramname.rfind('.') + 1);
             if(basename == SCC_LOG_LEVEL_PARAM_NAME)
                 log_lvl_set = true;
 
-            auto descr = h.get_description();
+            auto descr = h->get_description();
             if(with_description && descr.size()) {
                 auto descr_name = fmt::format("{}::descr", basename);
                 this_node[descr_name] = descr;
@@ -407,118 +793,216 @@ private:
     }
 };
 
-struct yaml_config_reader : public config_reader {
+/**
+ * an event handler applying the leaves of a YAML document to the broker while parsing. The hierarchical name of the
+ * current key is kept in a single buffer, files being referenced by !include tagged scalars are read when they are
+ * encountered. The events of anchored nodes are kept to be replayed at their aliases.
+ */
+struct yaml_config_reader : public config_reader, public YAML::EventHandler {
     configurer::broker_t& broker;
-    YAML::Node document;
     bool valid{false};
-    bool empty{true};
+    //! the hierarchical name of the current key
+    std::string name;
+    //! the length of the name the document is read into
+    size_t const prefix_len;
 
-    yaml_config_reader(configurer::broker_t& broker)
-    : broker(broker) {}
+    yaml_config_reader(configurer::broker_t& broker, std::string const& prefix = "")
+    : broker(broker)
+    , name(prefix)
+    , prefix_len(prefix.size()) {}
 
     void parse(std::istream& is) {
-        std::string buf((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
-        document = YAML::Load(buf);
-        valid = document.IsDefined() && (document.IsMap() || document.IsNull());
-        empty = document.IsNull();
+        valid = true;
+        name.resize(prefix_len);
+        levels.clear();
+        skip = 0;
+        anchors.clear();
+        recordings.clear();
+        YAML::Parser parser(is);
+        parser.HandleNextDocument(*this);
     }
 
     std::string get_error_msg() { return "YAML file does not start with a map"; }
 
-    inline void configure_cci() {
-        try {
-            configure_cci_hierarchical(document, "");
-        } catch(YAML::ParserException& e) {
-            throw std::runtime_error(e.what());
-        } catch(YAML::BadFile& e) {
-            throw std::runtime_error(e.what());
-        } catch(YAML::Exception& e) {
-            throw std::runtime_error(e.what());
-        }
-    }
-
-    void configure_cci_hierarchical(YAML::Node const& value, std::string const& prefix) {
-        if(value.IsMap()) {
-            for(auto it = value.begin(); it != value.end(); ++it) {
-                auto key_name = it->first.as<std::string>();
-                YAML::Node const& val = it->second;
-                auto hier_name = prefix.size() ? prefix + "." + key_name : key_name;
-                if(!val.IsDefined() || val.IsSequence())
+    void OnDocumentStart(const YAML::Mark&) override {}
+    void OnDocumentEnd() override {}
+    void OnNull(const YAML::Mark&, YAML::anchor_t anchor) override { handle(event{event::NUL}, anchor); }
+    void OnAlias(const YAML::Mark&, YAML::anchor_t anchor) override {
+        auto it = anchors.find(anchor);
+        if(it == anchors.end())
+            throw std::runtime_error("Unknown YAML alias");
+        auto events = it->second;
+        for(auto& e : events)
+            handle(e, YAML::NullAnchor);
+    }
+    void OnScalar(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, const std::string& value) override {
+        handle(event{event::SCALAR, tag, value}, anchor);
+    }
+    void OnSequenceStart(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, YAML::EmitterStyle::value) override {
+        handle(event{event::SEQ_START, tag}, anchor);
+    }
+    void OnSequenceEnd() override { handle(event{event::SEQ_END}, YAML::NullAnchor); }
+    void OnMapStart(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, YAML::EmitterStyle::value) override {
+        handle(event{event::MAP_START, tag}, anchor);
+    }
+    void OnMapEnd() override { handle(event{event::MAP_END}, YAML::NullAnchor); }
+
+private:
+    struct event {
+        enum kind_t { NUL, SCALAR, SEQ_START, SEQ_END, MAP_START, MAP_END } kind;
+        std::string tag;
+        std::string value;
+        event(kind_t kind, std::string const& tag = "", std::string const& value = "")
+        : kind(kind)
+        , tag(tag)
+        , value(value) {}
+    };
+    struct level {
+        //! the length of the name prefix of the map
+        size_t prefix;
+        bool expect_key;
+    };
+    std::vector<level> levels;
+    //! the nesting depth of the sequence being skipped
+    unsigned skip{0};
+    std::unordered_map<YAML::anchor_t, std::vector<event>> anchors;
+    //! the anchors whose nodes are still open and the nesting depth within them
+    std::vector<std::pair<YAML::anchor_t, unsigned>> recordings;
+    //! a node being reused to convert scalars
+    YAML::Node scalar;
+
+    void handle(event const& e, YAML::anchor_t anchor) {
+        auto is_start = e.kind == event::SEQ_START || e.kind == event::MAP_START;
+        auto is_end = e.kind == event::SEQ_END || e.kind == event::MAP_END;
+        for(auto& r : recordings) {
+            anchors[r.first].push_back(e);
+            r.second += is_start;
+            r.second -= is_end;
+        }
+        while(recordings.size() && recordings.back().second == 0)
+            recordings.pop_back();
+        if(anchor != YAML::NullAnchor) {
+            anchors[anchor].assign(1, e);
+            if(is_start)
+                recordings.emplace_back(anchor, 1);
+        }
+        process(e, is_start, is_end);
+    }
+
+    void process(event const& e, bool is_start, bool is_end) {
+        if(skip) {
+            skip += is_start;
+            skip -= is_end;
+            if(!skip && levels.size())
+                levels.back().expect_key = true;
+            return;
+        }
+        if(levels.empty()) {
+            // the document itself
+            if(e.kind == event::MAP_START) {
+                levels.push_back(level{name.size(), true});
+            } else if(e.kind != event::NUL) {
+                valid = false;
+                if(is_start)
+                    skip = 1;
+            }
+            return;
+        }
+        auto& top = levels.back();
+        if(e.kind == event::MAP_END) {
+            levels.pop_back();
+            if(levels.size())
+                levels.back().expect_key = true;
+        } else if(top.expect_key) {
+            if(e.kind != event::SCALAR)
+                throw std::runtime_error("Only scalar keys are supported in YAML configuration files");
+            name.resize(top.prefix);
+            if(top.prefix)
+                name += '.';
+            name += e.value;
+            top.expect_key = false;
+        } else if(e.kind == event::MAP_START) {
+            levels.push_back(level{name.size(), true});
+        } else if(e.kind == event::SEQ_START) {
+            skip = 1;
+        } else {
+            if(e.kind == event::SCALAR)
+                set(e.tag, e.value);
+            top.expect_key = true;
+        }
+    }
+
+    void set(std::string const& tag, std::string const& value) {
+        if(tag == "!include") {
+            include(value);
+        } else if(tag.size() && tag[0] == '?') {
+            scalar = value;
+            auto param_handle = broker.get_param_handle(name);
+            if(param_handle.is_valid()) {
+                auto param = param_handle.get_cci_value();
+                if(param.is_bool()) {
+                    param.set_bool(scalar.as<bool>());
+                } else if(param.is_int()) {
+                    param.set_int(scalar.as<int>());
+                } else if(param.is_uint()) {
+                    param.set_uint(scalar.as<unsigned>());
+                } else if(param.is_int64()) {
+                    param.set_int64(scalar.as<int64_t>());
+                } else if(param.is_uint64()) {
+                    param.set_uint64(scalar.as<uint64_t>());
+                } else if(param.is_double()) {
+                    param.set_double(scalar.as<double>());
+                } else if(param.is_string()) {
+                    param.set_string(value);
+                } else
                     return;
-                else if(val.IsMap())
-                    configure_cci_hierarchical(val, hier_name);
-                else if(val.IsScalar()) {
-                    auto& tag = val.Tag();
-                    if(tag == "!include") {
-                        yaml_config_reader sub_reader(broker);
-                        std::ifstream ifs(find_in_include_path(val.as<std::string>()));
-                        if(ifs.is_open()) {
-                            sub_reader.parse(ifs);
-                            if(sub_reader.valid) {
-                                sub_reader.configure_cci_hierarchical(sub_reader.document, hier_name);
-                            } else {
-                                std::ostringstream os;
-                                os << "Could not parse include file " << val.as<std::string>();
-                                throw std::runtime_error(os.str());
-                            }
-                        } else {
-                            std::ostringstream os;
-                            os << "Could not open include file " << val.as<std::string>();
-                            throw std::runtime_error(os.str());
-                        }
-                    } else if(tag.size() && tag[0] == '?') {
-                        auto param_handle = broker.get_param_handle(hier_name);
-                        if(param_handle.is_valid()) {
-                            auto param = param_handle.get_cci_value();
-                            if(param.is_bool()) {
-                                param.set_bool(val.as<bool>());
-                            } else if(param.is_int()) {
-                                param.set_int(val.as<int>());
-                            } else if(param.is_uint()) {
-                                param.set_uint(val.as<unsigned>());
-                            } else if(param.is_int64()) {
-                                param.set_int64(val.as<int64_t>());
-                            } else if(param.is_uint64()) {
-                                param.set_uint64(val.as<uint64_t>());
-                            } else if(param.is_double()) {
-                                param.set_double(val.as<double>());
-                            } else if(param.is_string()) {
-                                param.set_string(val.as<std::string>());
-                            }
-                        } else {
-                            if(auto res = YAML::as_if<bool, optional<bool>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<int, optional<int>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<int64_t, optional<int64_t>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<unsigned, optional<unsigned>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<uint64_t, optional<uint64_t>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<double, optional<double>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            } else if(auto res = YAML::as_if<std::string, optional<std::string>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            }
-                        }
-                    } else if(tag.size() && tag[0] == '!') {
-                        auto param_handle = broker.get_param_handle(hier_name);
-                        if(param_handle.is_valid()) {
-                            auto param = param_handle.get_cci_value();
-                            if(param.is_string()) {
-                                param.set_string(val.as<std::string>());
-                            }
-                        } else {
-                            if(auto res = YAML::as_if<std::string, optional<std::string>>(val)()) {
-                                broker.set_preset_cci_value(hier_name, cci::cci_value(res.value()));
-                            }
-                        }
-                    }
+                param_handle.set_cci_value(param);
+                record(name, param);
+            } else {
+                if(auto res = YAML::as_if<bool, optional<bool>>(scalar)()) {
+                    preset(cci::cci_value(res.value()));
+                } else if(auto res = YAML::as_if<int, optional<int>>(scalar)()) {
+                    preset(cci::cci_value(res.value()));
+                } else if(auto res = YAML::as_if<int64_t, optional<int64_t>>(scalar)()) {
+                    preset(cci::cci_value(res.value()));
+                } else if(auto res = YAML::as_if<unsigned, optional<unsigned>>(scalar)()) {
+                    preset(cci::cci_value(res.value()));
+                } else if(auto res = YAML::as_if<uint64_t, optional<uint64_t>>(scalar)()) {
+                    preset(cci::cci_value(res.value()));
+                } else if(auto res = YAML::as_if<double, optional<double>>(scalar)()) {
+                    preset(cci::cci_value(res.value()));
+                } else {
+                    preset(cci::cci_value(value));
                 }
             }
+        } else if(tag.size() && tag[0] == '!') {
+            auto param_handle = broker.get_param_handle(name);
+            if(param_handle.is_valid()) {
+                if(param_handle.get_cci_value().is_string()) {
+                    param_handle.set_cci_value(cci::cci_value(value));
+                    record(name, cci::cci_value(value));
+                }
+            } else {
+                preset(cci::cci_value(value));
+            }
         }
     }
+
+    void preset(cci::cci_value const& value) {
+        broker.set_preset_cci_value(name, value);
+        record(name, value);
+    }
+    //! reads the included file as the value of the current key
+    void include(std::string const& file_name) {
+        yaml_config_reader sub_reader(broker, name);
+        config_input in;
+        if(!open_include(in, file_name, sub_reader))
+            throw std::runtime_error("Could not open include file " + file_name);
+        sub_reader.parse(in.is);
+        if(!sub_reader.valid)
+            throw std::runtime_error("Could not parse include file " + file_name);
+        close_include(in);
+    }
 };
 /*************************************************************************************************
  * YAML config end
@@ -663,6 +1147,14 @@ struct configurer::ConfigHolder : public json_config_reader {
     : json_config_reader(broker) {}
 };
 #endif
+struct configurer::ParamIndex : public param_index {
+    ParamIndex(configurer::broker_t& broker)
+    : param_index(broker) {}
+};
+
+struct configurer::ConfigSnapshot : public config_snapshot {
+    std::string file_name;
+};
 
 configurer::configurer(const std::string& filename, unsigned config_phases)
 : configurer(filename, config_phases, "$$$configurer$$$") {}
@@ -672,27 +1164,59 @@ configurer::configurer(const std::string& filename, unsigned config_phases, sc_c
 , config_phases(config_phases)
 , cci_broker(cci::cci_get_broker())
 , cci_originator(cci_broker.get_originator())
-, root(new ConfigHolder(cci_broker)) {
+, root(new ConfigHolder(cci_broker))
+, params(new ParamIndex(cci_broker)) {
+    if(auto snapshot_name = getenv("SCC_CONFIG_SNAPSHOT"))
+        use_config_snapshot(snapshot_name);
     if(filename.length() > 0)
         read_input_file(filename);
 }
 
 configurer::~configurer() {}
 
+void configurer::use_config_snapshot(const std::string& file_name) {
+    snapshot.reset(new ConfigSnapshot);
+    snapshot->file_name = file_name;
+    if(!snapshot->read(file_name) && util::file_exists(file_name))
+        SCCWARN() << "Ignoring malformed configuration snapshot " << file_name;
+}
+
 void configurer::read_input_file(const std::string& filename) {
     root->add_to_includes(util::dir_name(filename));
-    std::ifstream is(filename);
-    if(is.is_open()) {
+    if(snapshot) {
+        auto src = snapshot->find(filename);
+        if(src && config_snapshot::is_current(*src)) {
+            for(auto& v : src->values) {
+                auto param_handle = cci_broker.get_param_handle(v.first);
+                if(param_handle.is_valid())
+                    param_handle.set_cci_value(v.second);
+                else
+                    cci_broker.set_preset_cci_value(v.first, v.second);
+            }
+            return;
+        }
+    }
+    config_input in;
+    if(in.open(filename, snapshot != nullptr)) {
+        config_snapshot::source src{filename, snapshot ? snapshot->overrides : 0, {config_snapshot::file_info{filename, 0, 0}}, {}};
+        root->recording = snapshot ? &src : nullptr;
         try {
-            root->parse(is);
-            if(!root->valid) {
+            root->parse(in.is);
+            if(!root->valid)
                 SCCERR() << "Could not parse input file " << filename << ", " << root->get_error_msg();
-            } else if(!root->empty) {
-                root->configure_cci();
+            else if(snapshot) {
+                in.finish(src.files.front());
+                if(auto old_src = snapshot->find(filename))
+                    *old_src = std::move(src);
+                else
+                    snapshot->sources.push_back(std::move(src));
+                if(!snapshot->write(snapshot->file_name))
+                    SCCWARN() << "Could not write configuration snapshot " << snapshot->file_name;
             }
         } catch(std::runtime_error& e) {
             SCCERR() << "Could not parse input file " << filename << ", reason: " << e.what();
         }
+        root->recording = nullptr;
     } else {
         SCCWARN() << "Could not open input file " << filename;
     }
@@ -702,7 +1226,7 @@ void configurer::dump_configuration(std::ostream& os, bool as_yaml, bool with_de
 #ifdef HAS_YAMPCPP
     if(as_yaml) {
         YAML::Node root; // starts out as null
-        yaml_config_dumper dumper(cci_broker, with_description, complete, stop_list);
+        yaml_config_dumper dumper(cci_broker, with_description, complete, stop_list, *params);
         if(obj)
             for(auto* o : obj->get_child_objects()) {
                 dumper.dump_config(o, root);
@@ -716,7 +1240,7 @@ void configurer::dump_configuration(std::ostream& os, bool as_yaml, bool with_de
     OStreamWrapper stream(os);
     writer_type writer(stream);
     writer.StartObject();
-    json_config_dumper dumper(cci_broker, stop_list);
+    json_config_dumper dumper(cci_broker, stop_list, *params);
     for(auto* o : get_sc_objects(obj)) {
         dumper.dump_config(o, writer);
     }
@@ -730,23 +1254,14 @@ void configurer::set_configuration_value(sc_core::sc_attr_base* attr_base, sc_co
     mirror_sc_attribute(cci_broker, cci2sc_attr, cci_originator, hier_name, attr_base);
 }
 
-inline std::string hier_name_as_regex(std::string const& parname) {
-    if(parname.find_first_of("*?[") != std::string::npos) {
-        return util::glob_to_regex(parname);
-    } else if(parname[0] == '^') {
-        return parname;
-    } else
-        return "";
-}
-
 void configurer::set_value(const std::string& hier_name, cci::cci_value value) {
-    auto regex_str = hier_name_as_regex(hier_name);
-    if(regex_str.length()) {
-        auto rr = std::regex(regex_str);
-        cci::cci_param_predicate pred = [rr](cci::cci_param_untyped_handle const& hndl) { return regex_match(hndl.name(), rr); };
-        for(auto& hndl : cci_broker.get_param_handles(pred)) {
-            hndl.set_cci_value(value);
-        }
+    if(snapshot)
+        snapshot->add_override(hier_name, value);
+    if(hier_name.find_first_of("*?[") != std::string::npos || hier_name[0] == '^') {
+        params->for_each_matching(hier_name, [&value](cci::cci_param_untyped_handle& hndl) { hndl.set_cci_value(value); });
+    } else if(auto hndl = params->find(hier_name)) {
+        hndl->set_cci_value(value);
+        return;
     } else {
         cci::cci_param_handle param_handle = cci_broker.get_param_handle(hier_name);
         if(param_handle.is_valid()) {
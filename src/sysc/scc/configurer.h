@@ -40,6 +40,8 @@ bool init_cci(std::string name = "Global Broker");
  */
 class configurer : public sc_core::sc_module {
     struct ConfigHolder;
+    struct ParamIndex;
+    struct ConfigSnapshot;
 
 public:
     using base_type = sc_core::sc_module;
@@ -66,6 +68,16 @@ public:
     configurer& operator=(configurer&&) = delete;
 
     void read_input_file(std::string const& filename);
+    /**
+     * use a binary snapshot of the values read from input files. The values of an input file are taken from the
+     * snapshot as long as neither the file nor any file included by it changed, otherwise the file is parsed and the
+     * snapshot is updated. Values set using set_value() and sc_attributes are applied as usual, the values set before an
+     * input file is read are part of the key of its snapshot entry so that runs using other overrides do not share it.
+     * If the environment variable SCC_CONFIG_SNAPSHOT is set the constructor uses its value as name of the snapshot file.
+     *
+     * @param file_name the name of the snapshot file
+     */
+    void use_config_snapshot(std::string const& file_name);
     /**
      * configure the design hierarchy using the input file. Apply the values to
      * sc_core::sc_attribute in th edsign hierarchy
@@ -156,6 +168,8 @@ protected:
     cci_param_cln cci2sc_attr;
     cci::cci_originator cci_originator;
     std::unique_ptr<ConfigHolder> root;
+    std::unique_ptr<ParamIndex> params;
+    std::unique_ptr<ConfigSnapshot> snapshot;
 };
 
 } // namespace scc
@@ -0,0 +1,370 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "cwf_trace.hh"
+#include "trace/sampler.hh"
+#include "trace/types.hh"
+#include "utilities.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scc {
+namespace trace {
+using util::cwf::value_kind;
+
+struct cwf_trace {
+
+    cwf_trace(std::string const& nm, value_kind kind, unsigned bits)
+    : name{nm}
+    , bits{bits}
+    , kind{kind} {}
+
+    virtual void record(util::cwf_writer& wr, uint64_t time) = 0;
+
+    virtual void update_and_record(util::cwf_writer& wr, uint64_t time) = 0;
+
+    virtual uintptr_t get_hash() = 0;
+
+    virtual ~cwf_trace(){};
+
+    const std::string name;
+    uint32_t id{0};
+    bool is_alias{false};
+    bool is_triggered{false};
+    const unsigned bits{0};
+    const value_kind kind;
+};
+
+template <typename T> inline value_kind get_kind() { return traits<T>::get_type() == REAL ? value_kind::REAL : value_kind::TWO_STATE; }
+template <> inline value_kind get_kind<sc_dt::sc_logic>() { return value_kind::FOUR_STATE; }
+template <> inline value_kind get_kind<sc_dt::sc_lv_base>() { return value_kind::FOUR_STATE; }
+
+template <typename T, typename OT = T> struct cwf_trace_t : public cwf_trace {
+    cwf_trace_t(const T& object_, const std::string& name, int width = -1)
+    : cwf_trace(name, get_kind<T>(), trace::traits<T>::get_bits(object_))
+    , act_val(object_)
+    , old_val(object_) {}
+
+    uintptr_t get_hash() override { return reinterpret_cast<uintptr_t>(&act_val); }
+
+    inline bool changed() { return !is_alias && old_val != act_val; }
+
+    inline void update() { old_val = act_val; }
+
+    void record(util::cwf_writer& wr, uint64_t time) override;
+
+    void update_and_record(util::cwf_writer& wr, uint64_t time) override {
+        update();
+        record(wr, time);
+    };
+
+    OT old_val;
+    const T& act_val;
+};
+
+template <typename T, typename OT> inline void cwf_trace_t<T, OT>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, static_cast<uint64_t>(old_val));
+}
+template <> void cwf_trace_t<sc_core::sc_time, sc_core::sc_time>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, static_cast<uint64_t>(old_val.value()));
+}
+template <> void cwf_trace_t<bool, bool>::record(util::cwf_writer& wr, uint64_t time) { wr.emit(id, time, uint64_t(old_val ? 1 : 0)); }
+template <> void cwf_trace_t<sc_dt::sc_bit, sc_dt::sc_bit>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, uint64_t(old_val ? 1 : 0));
+}
+template <> void cwf_trace_t<sc_dt::sc_logic, sc_dt::sc_logic>::record(util::cwf_writer& wr, uint64_t time) {
+    char buf[2] = {old_val.to_char(), 0};
+    wr.emit(id, time, buf);
+}
+template <> void cwf_trace_t<float, float>::record(util::cwf_writer& wr, uint64_t time) { wr.emit(id, time, double(old_val)); }
+template <> void cwf_trace_t<double, double>::record(util::cwf_writer& wr, uint64_t time) { wr.emit(id, time, old_val); }
+template <> void cwf_trace_t<sc_dt::sc_int_base, sc_dt::sc_int_base>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, static_cast<uint64_t>(old_val.value()));
+}
+template <> void cwf_trace_t<sc_dt::sc_uint_base, sc_dt::sc_uint_base>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, static_cast<uint64_t>(old_val.value()));
+}
+template <> void cwf_trace_t<sc_dt::sc_signed, sc_dt::sc_signed>::record(util::cwf_writer& wr, uint64_t time) {
+    static std::vector<char> rawdata(1024);
+    if(rawdata.size() < old_val.length() + 1)
+        rawdata.resize(old_val.length() + 1);
+    char* rawdata_ptr = &rawdata[0];
+    for(int bitindex = old_val.length() - 1; bitindex >= 0; --bitindex)
+        *rawdata_ptr++ = '0' + old_val[bitindex].value();
+    *rawdata_ptr = 0;
+    wr.emit(id, time, &rawdata[0]);
+}
+template <> void cwf_trace_t<sc_dt::sc_unsigned, sc_dt::sc_unsigned>::record(util::cwf_writer& wr, uint64_t time) {
+    static std::vector<char> rawdata(1024);
+    if(rawdata.size() < old_val.length() + 1)
+        rawdata.resize(old_val.length() + 1);
+    char* rawdata_ptr = &rawdata[0];
+    for(int bitindex = old_val.length() - 1; bitindex >= 0; --bitindex)
+        *rawdata_ptr++ = '0' + old_val[bitindex].value();
+    *rawdata_ptr = 0;
+    wr.emit(id, time, &rawdata[0]);
+}
+template <> void cwf_trace_t<sc_dt::sc_fxval, sc_dt::sc_fxval>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, old_val.to_double());
+}
+template <> void cwf_trace_t<sc_dt::sc_fxval_fast, sc_dt::sc_fxval_fast>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, old_val.to_double());
+}
+template <> void cwf_trace_t<sc_dt::sc_fxnum, sc_dt::sc_fxval>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, old_val.to_double());
+}
+template <> void cwf_trace_t<sc_dt::sc_fxnum_fast, sc_dt::sc_fxval_fast>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, old_val.to_double());
+}
+template <> void cwf_trace_t<sc_dt::sc_bv_base, sc_dt::sc_bv_base>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, old_val.to_string().c_str());
+}
+template <> void cwf_trace_t<sc_dt::sc_lv_base, sc_dt::sc_lv_base>::record(util::cwf_writer& wr, uint64_t time) {
+    wr.emit(id, time, old_val.to_string().c_str());
+}
+} // namespace trace
+
+cwf_trace_file::cwf_trace_file(const char* name, std::function<bool()>& enable)
+: check_enabled(enable)
+, writer(new util::cwf_writer(std::string(name) + ".cwf")) {
+    writer->set_timescale(-12);
+#if SC_VERSION_MAJOR < 3
+#if defined(WITH_SC_TRACING_PHASE_CALLBACKS)
+    // remove from hierarchy
+    sc_object::detach();
+    // register regular (non-delta) callbacks
+    sc_object::register_simulation_phase_callback(SC_BEFORE_TIMESTEP);
+#else // explicitly register with simcontext
+    sc_core::sc_get_curr_simcontext()->add_trace_file(this);
+#endif
+#endif
+}
+
+cwf_trace_file::~cwf_trace_file() {
+    writer->close();
+    for(auto t : all_traces)
+        delete t.trc;
+}
+
+template <typename T, typename OT = T> bool changed(trace::cwf_trace* trace) {
+    if(reinterpret_cast<trace::cwf_trace_t<T, OT>*>(trace)->changed()) {
+        reinterpret_cast<trace::cwf_trace_t<T, OT>*>(trace)->update();
+        return true;
+    } else
+        return false;
+}
+
+void cwf_trace_file::attach_sampler(trace_entry& e) {
+    if(sampling.active()) {
+        e.smplr = trace::get_sampler(samplers, sampling);
+    }
+}
+
+#define DECL_TRACE_METHOD_A(tp)                                                                                                            \
+    void cwf_trace_file::trace(const tp& object, const std::string& name) {                                                                \
+        all_traces.emplace_back(this, &changed<tp>, new trace::cwf_trace_t<tp>(object, name));                                             \
+        attach_sampler(all_traces.back());                                                                                                 \
+    }
+#define DECL_TRACE_METHOD_B(tp)                                                                                                            \
+    void cwf_trace_file::trace(const tp& object, const std::string& name, int width) {                                                     \
+        all_traces.emplace_back(this, &changed<tp>, new trace::cwf_trace_t<tp>(object, name));                                             \
+        attach_sampler(all_traces.back());                                                                                                 \
+    }
+#define DECL_TRACE_METHOD_C(tp, tpo)                                                                                                       \
+    void cwf_trace_file::trace(const tp& object, const std::string& name) {                                                                \
+        all_traces.emplace_back(this, &changed<tp, tpo>, new trace::cwf_trace_t<tp, tpo>(object, name));                                   \
+        attach_sampler(all_traces.back());                                                                                                 \
+    }
+
+#if(SYSTEMC_VERSION >= 20171012) || defined(NCSC)
+void cwf_trace_file::trace(const sc_core::sc_event& object, const std::string& name) {}
+DECL_TRACE_METHOD_A(sc_core::sc_time)
+#endif
+DECL_TRACE_METHOD_A(bool)
+DECL_TRACE_METHOD_A(sc_dt::sc_bit)
+DECL_TRACE_METHOD_A(sc_dt::sc_logic)
+
+DECL_TRACE_METHOD_B(unsigned char)
+DECL_TRACE_METHOD_B(unsigned short)
+DECL_TRACE_METHOD_B(unsigned int)
+DECL_TRACE_METHOD_B(unsigned long)
+#ifdef SYSTEMC_64BIT_PATCHES
+DECL_TRACE_METHOD_B(unsigned long long)
+#endif
+DECL_TRACE_METHOD_B(char)
+DECL_TRACE_METHOD_B(short)
+DECL_TRACE_METHOD_B(int)
+DECL_TRACE_METHOD_B(long)
+DECL_TRACE_METHOD_B(sc_dt::int64)
+DECL_TRACE_METHOD_B(sc_dt::uint64)
+
+DECL_TRACE_METHOD_A(float)
+DECL_TRACE_METHOD_A(double)
+DECL_TRACE_METHOD_A(sc_dt::sc_int_base)
+DECL_TRACE_METHOD_A(sc_dt::sc_uint_base)
+DECL_TRACE_METHOD_A(sc_dt::sc_signed)
+DECL_TRACE_METHOD_A(sc_dt::sc_unsigned)
+
+DECL_TRACE_METHOD_A(sc_dt::sc_fxval)
+DECL_TRACE_METHOD_A(sc_dt::sc_fxval_fast)
+DECL_TRACE_METHOD_C(sc_dt::sc_fxnum, sc_dt::sc_fxval)
+DECL_TRACE_METHOD_C(sc_dt::sc_fxnum_fast, sc_dt::sc_fxval_fast)
+
+DECL_TRACE_METHOD_A(sc_dt::sc_bv_base)
+DECL_TRACE_METHOD_A(sc_dt::sc_lv_base)
+#undef DECL_TRACE_METHOD_A
+#undef DECL_TRACE_METHOD_B
+#undef DECL_TRACE_METHOD_C
+
+void cwf_trace_file::trace(const unsigned int& object, const std::string& name, const char** enum_literals) {}
+
+#define DECL_REGISTER_METHOD_A(tp)                                                                                                         \
+    observer::notification_handle* cwf_trace_file::observe(const tp& object, const std::string& name) {                                    \
+        all_traces.emplace_back(this, &changed<tp>, new trace::cwf_trace_t<tp>(object, name));                                             \
+        attach_sampler(all_traces.back());                                                                                                 \
+        all_traces.back().trc->is_triggered = all_traces.back().smplr == nullptr;                                                          \
+        return &all_traces.back();                                                                                                         \
+    }
+#define DECL_REGISTER_METHOD_C(tp, tpo)                                                                                                    \
+    observer::notification_handle* cwf_trace_file::observe(const tp& object, const std::string& name) {                                    \
+        all_traces.emplace_back(this, &changed<tp, tpo>, new trace::cwf_trace_t<tp, tpo>(object, name));                                   \
+        attach_sampler(all_traces.back());                                                                                                 \
+        all_traces.back().trc->is_triggered = all_traces.back().smplr == nullptr;                                                          \
+        return &all_traces.back();                                                                                                         \
+    }
+
+#if(SYSTEMC_VERSION >= 20171012)
+observer::notification_handle* cwf_trace_file::observe(const sc_core::sc_event& object, const std::string& name) { return nullptr; }
+DECL_REGISTER_METHOD_A(sc_core::sc_time)
+#endif
+
+DECL_REGISTER_METHOD_A(bool)
+DECL_REGISTER_METHOD_A(sc_dt::sc_bit)
+DECL_REGISTER_METHOD_A(sc_dt::sc_logic)
+
+DECL_REGISTER_METHOD_A(unsigned char)
+DECL_REGISTER_METHOD_A(unsigned short)
+DECL_REGISTER_METHOD_A(unsigned int)
+DECL_REGISTER_METHOD_A(unsigned long)
+#ifdef SYSTEMC_64BIT_PATCHES
+DECL_REGISTER_METHOD_A(unsigned long long)
+#endif
+DECL_REGISTER_METHOD_A(char)
+DECL_REGISTER_METHOD_A(short)
+DECL_REGISTER_METHOD_A(int)
+DECL_REGISTER_METHOD_A(long)
+DECL_REGISTER_METHOD_A(sc_dt::int64)
+DECL_REGISTER_METHOD_A(sc_dt::uint64)
+
+DECL_REGISTER_METHOD_A(float)
+DECL_REGISTER_METHOD_A(double)
+DECL_REGISTER_METHOD_A(sc_dt::sc_int_base)
+DECL_REGISTER_METHOD_A(sc_dt::sc_uint_base)
+DECL_REGISTER_METHOD_A(sc_dt::sc_signed)
+DECL_REGISTER_METHOD_A(sc_dt::sc_unsigned)
+
+DECL_REGISTER_METHOD_A(sc_dt::sc_fxval)
+DECL_REGISTER_METHOD_A(sc_dt::sc_fxval_fast)
+DECL_REGISTER_METHOD_C(sc_dt::sc_fxnum, sc_dt::sc_fxval)
+DECL_REGISTER_METHOD_C(sc_dt::sc_fxnum_fast, sc_dt::sc_fxval_fast)
+
+DECL_REGISTER_METHOD_A(sc_dt::sc_bv_base)
+DECL_REGISTER_METHOD_A(sc_dt::sc_lv_base)
+#undef DECL_REGISTER_METHOD_A
+#undef DECL_REGISTER_METHOD_C
+
+bool cwf_trace_file::trace_entry::notify() {
+    // aliases and sampled traces are not recorded on change, returning false suspends the notifications
+    if(trc->is_alias || !trc->is_triggered)
+        return false;
+    if(compare_and_update(trc))
+        that->triggered_traces.push_back(trc);
+    return true;
+}
+
+void cwf_trace_file::write_comment(const std::string& comment) {}
+
+void cwf_trace_file::init() {
+    std::unordered_map<uintptr_t, uint32_t> alias_map;
+    for(auto& e : all_traces) {
+        auto alias_it = alias_map.find(e.trc->get_hash());
+        e.trc->is_alias = alias_it != std::end(alias_map);
+        if(e.trc->is_alias)
+            e.trc->id = writer->add_alias(e.trc->name, alias_it->second);
+        else {
+            e.trc->id = writer->add_signal(e.trc->name, e.trc->bits, e.trc->kind);
+            alias_map.insert({e.trc->get_hash(), e.trc->id});
+            if(!e.trc->is_triggered)
+                pull_traces.push_back(&e);
+        }
+    }
+    changed_traces.reserve(pull_traces.size());
+    triggered_traces.reserve(all_traces.size());
+}
+
+void cwf_trace_file::cycle(bool delta_cycle) {
+    if(delta_cycle)
+        return;
+    if(last_emitted_ts == std::numeric_limits<uint64_t>::max()) {
+        init();
+        uint64_t time_stamp = trace::to_ps(sc_core::sc_time_stamp());
+        for(auto& e : all_traces)
+            if(!e.trc->is_alias)
+                e.trc->update_and_record(*writer, time_stamp);
+        last_emitted_ts = time_stamp;
+    } else {
+        if(check_enabled && !check_enabled())
+            return;
+        uint64_t time_stamp = trace::to_ps(sc_core::sc_time_stamp());
+        ++sample_step;
+        for(auto e : pull_traces) {
+            if(e->smplr && !e->smplr->due(sample_step, time_stamp, e->last_sample_ps))
+                continue;
+            if(e->compare_and_update(e->trc)) {
+                changed_traces.push_back(e->trc);
+                if(e->smplr)
+                    e->last_sample_ps = time_stamp;
+            }
+        }
+        if(triggered_traces.size() || changed_traces.size()) {
+            if(triggered_traces.size()) {
+                auto end = std::unique(std::begin(triggered_traces), std::end(triggered_traces));
+                triggered_traces.erase(end, triggered_traces.end());
+                for(auto t : triggered_traces)
+                    t->record(*writer, time_stamp);
+                triggered_traces.clear();
+            }
+            if(changed_traces.size()) {
+                for(auto t : changed_traces)
+                    t->record(*writer, time_stamp);
+                changed_traces.clear();
+            }
+            last_emitted_ts = time_stamp;
+        }
+    }
+}
+
+void cwf_trace_file::set_time_unit(double v, sc_core::sc_time_unit tu) {}
+
+sc_core::sc_trace_file* create_cwf_trace_file(const char* name, std::function<bool()> enable) { return new cwf_trace_file(name, enable); }
+
+void close_cwf_trace_file(sc_core::sc_trace_file* tf) { delete static_cast<cwf_trace_file*>(tf); }
+
+} // namespace scc
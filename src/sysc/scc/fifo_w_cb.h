@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include "observer.h"
 #include <deque>
 #include <functional>
 #include <sysc/communication/sc_prim_channel.h>
+#include <sysc/tracing/sc_trace.h>
+#include <vector>
 
 /** \ingroup scc-sysc
  *  @{
@@ -32,6 +35,8 @@ namespace scc {
  *
  * A fifo with callbacks upon running empty or being filled. The registered callbacks are triggered if the fifo is empty
  * or if an element is inserted. This can be used to control the sensitivity of processes reading this fifo.
+ * When traced the number of available elements is recorded. If the trace file is an observer the value is pushed
+ * upon update instead of being compared in every cycle.
  *
  * @tparam T the type name of the elements to be store in the fifo
  */
@@ -45,6 +50,16 @@ public:
 
     virtual ~fifo_w_cb(){};
 
+    const char* kind() const override { return "fifo_w_cb"; }
+
+    void trace(sc_core::sc_trace_file* tf) const override {
+        if(auto* obs = dynamic_cast<observer*>(tf)) {
+            if(auto* h = observe(obs, available, name()))
+                hndl.push_back(h);
+        } else
+            sc_core::sc_trace(tf, available, name());
+    }
+
     void push_back(T& t) {
         in_queue.push_back(t);
         request_update();
@@ -93,17 +108,20 @@ public:
 protected:
     // the update method (does nothing by default)
     virtual void update() {
+        auto last_available = available;
         written = 0;
         available = out_queue.size();
-        if(in_queue.empty())
-            return;
-        written = in_queue.size();
-        out_queue.insert(out_queue.end(), in_queue.begin(), in_queue.end());
-        in_queue.clear();
-        available = out_queue.size();
-        if(avail_cb)
-            avail_cb();
-        data_written_evt.notify(sc_core::SC_ZERO_TIME);
+        if(!in_queue.empty()) {
+            written = in_queue.size();
+            out_queue.insert(out_queue.end(), in_queue.begin(), in_queue.end());
+            in_queue.clear();
+            available = out_queue.size();
+            if(avail_cb)
+                avail_cb();
+            data_written_evt.notify(sc_core::SC_ZERO_TIME);
+        }
+        if(available != last_available)
+            notify_observers(hndl);
     }
 
     std::deque<T> in_queue{};
@@ -113,6 +131,7 @@ protected:
     unsigned available = 0;
     unsigned written = 0;
     sc_core::sc_event data_written_evt{};
+    mutable std::vector<observer::notification_handle*> hndl;
 };
 
 } /* namespace scc */
@@ -16,6 +16,8 @@
 
 #include "fst_trace.hh"
 #include "fstapi.h"
+#include "trace/chunk_index.hh"
+#include "trace/sampler.hh"
 #include "trace/types.hh"
 #include "utilities.h"
 #include <cmath>
@@ -27,6 +29,7 @@
 #include <map>
 #include <sstream>
 #include <stdexcept>
+#include <sys/stat.h>
 #include <unordered_map>
 #include <util/ities.h>
 #include <vector>
@@ -124,6 +127,9 @@ template <typename T, typename OT> inline void fst_trace_t<T, OT>::record(void*
     *s = 0;
     fstWriterEmitValueChange(m_fst, fst_hndl, &rawdata[0]);
 }
+template <> void fst_trace_t<sc_core::sc_time, sc_core::sc_time>::record(void* m_fst) {
+    fstWriterEmitValueChange64(m_fst, fst_hndl, bits, old_val.value());
+}
 template <> void fst_trace_t<bool, bool>::record(void* m_fst) { fstWriterEmitValueChange(m_fst, fst_hndl, old_val ? "1" : "0"); }
 template <> void fst_trace_t<sc_dt::sc_bit, sc_dt::sc_bit>::record(void* m_fst) {
     fstWriterEmitValueChange(m_fst, fst_hndl, old_val ? "1" : "0");
@@ -214,27 +220,10 @@ template <> void fst_trace_t<sc_dt::sc_lv_base, sc_dt::sc_lv_base>::record(void*
 }
 } // namespace trace
 
-fst_trace_file::fst_trace_file(const char* name, std::function<bool()>& enable)
-: check_enabled(enable) {
-    std::stringstream ss;
-    ss << name << ".fst";
-    m_fst = fstWriterCreate(ss.str().c_str(), 1);
-    if(!m_fst) {
-        fprintf(stderr, "Could not open '%s', exiting.\n", ss.str().c_str());
-        exit(255);
-    }
-    fstWriterSetPackType(m_fst, FST_WR_PT_FASTLZ);
-    fstWriterSetRepackOnClose(m_fst, 1);
-    fstWriterSetParallelMode(m_fst, 0);
-    fstWriterSetTimescale(m_fst, -12); // femto seconds 1*10-12
-    fstWriterSetTimezero(m_fst, 0);
-    char tbuf[200];
-    time_t long_time;
-    time(&long_time);
-    struct tm* p_tm = localtime(&long_time);
-    strftime(tbuf, 199, "%b %d, %Y\t%H:%M:%S", p_tm);
-    fstWriterSetDate(m_fst, tbuf);
-    // fstWriterSetFileType(m_fst, FST_FT_VERILOG);
+fst_trace_file::fst_trace_file(const char* name, std::function<bool()>& enable, trace_rotation const& rotation)
+: check_enabled(enable)
+, chunks(new trace::chunk_index(name, "fst", rotation)) {
+    open_writer();
 #if SC_VERSION_MAJOR < 3
 #if defined(WITH_SC_TRACING_PHASE_CALLBACKS)
     // remove from hierarchy
@@ -254,6 +243,29 @@ fst_trace_file::~fst_trace_file() {
         // fstWriterFlushContext(m_fst);
         fstWriterClose(m_fst);
     }
+    chunks->finish(trace::to_ps(sc_core::sc_time_stamp()));
+}
+
+void fst_trace_file::open_writer() {
+    auto file_name = chunks->file_name();
+    m_fst = fstWriterCreate(file_name.c_str(), 1);
+    if(!m_fst) {
+        fprintf(stderr, "Could not open '%s', exiting.\n", file_name.c_str());
+        exit(255);
+    }
+    fstWriterSetPackType(m_fst, FST_WR_PT_FASTLZ);
+    // repacking a chunked trace would make closing a chunk as expensive as closing a monolithic file
+    fstWriterSetRepackOnClose(m_fst, chunks->enabled() ? 0 : 1);
+    fstWriterSetParallelMode(m_fst, 0);
+    fstWriterSetTimescale(m_fst, -12); // femto seconds 1*10-12
+    fstWriterSetTimezero(m_fst, 0);
+    char tbuf[200];
+    time_t long_time;
+    time(&long_time);
+    struct tm* p_tm = localtime(&long_time);
+    strftime(tbuf, 199, "%b %d, %Y\t%H:%M:%S", p_tm);
+    fstWriterSetDate(m_fst, tbuf);
+    // fstWriterSetFileType(m_fst, FST_FT_VERILOG);
 }
 
 template <typename T, typename OT = T> bool changed(trace::fst_trace* trace) {
@@ -263,22 +275,32 @@ template <typename T, typename OT = T> bool changed(trace::fst_trace* trace) {
     } else
         return false;
 }
+
+void fst_trace_file::attach_sampler(trace_entry& e) {
+    if(sampling.active()) {
+        e.smplr = trace::get_sampler(samplers, sampling);
+    }
+}
+
 #define DECL_TRACE_METHOD_A(tp)                                                                                                            \
     void fst_trace_file::trace(const tp& object, const std::string& name) {                                                                \
         all_traces.emplace_back(this, &changed<tp>, new trace::fst_trace_t<tp>(object, name));                                             \
+        attach_sampler(all_traces.back());                                                                                                 \
     }
 #define DECL_TRACE_METHOD_B(tp)                                                                                                            \
     void fst_trace_file::trace(const tp& object, const std::string& name, int width) {                                                     \
         all_traces.emplace_back(this, &changed<tp>, new trace::fst_trace_t<tp>(object, name));                                             \
+        attach_sampler(all_traces.back());                                                                                                 \
     }
 #define DECL_TRACE_METHOD_C(tp, tpo)                                                                                                       \
     void fst_trace_file::trace(const tp& object, const std::string& name) {                                                                \
         all_traces.emplace_back(this, &changed<tp, tpo>, new trace::fst_trace_t<tp, tpo>(object, name));                                   \
+        attach_sampler(all_traces.back());                                                                                                 \
     }
 
 #if(SYSTEMC_VERSION >= 20171012) || defined(NCSC)
 void fst_trace_file::trace(const sc_core::sc_event& object, const std::string& name) {}
-void fst_trace_file::trace(const sc_core::sc_time& object, const std::string& name) {}
+DECL_TRACE_METHOD_A(sc_core::sc_time)
 #endif
 DECL_TRACE_METHOD_A(bool)
 DECL_TRACE_METHOD_A(sc_dt::sc_bit)
@@ -323,19 +345,21 @@ void fst_trace_file::trace(const unsigned int& object, const std::string& name,
 #define DECL_REGISTER_METHOD_A(tp)                                                                                                         \
     observer::notification_handle* fst_trace_file::observe(const tp& object, const std::string& name) {                                    \
         all_traces.emplace_back(this, &changed<tp>, new trace::fst_trace_t<tp>(object, name));                                             \
-        all_traces.back().trc->is_triggered = true;                                                                                        \
+        attach_sampler(all_traces.back());                                                                                                 \
+        all_traces.back().trc->is_triggered = all_traces.back().smplr == nullptr;                                                          \
         return &all_traces.back();                                                                                                         \
     }
 #define DECL_REGISTER_METHOD_C(tp, tpo)                                                                                                    \
     observer::notification_handle* fst_trace_file::observe(const tp& object, const std::string& name) {                                    \
         all_traces.emplace_back(this, &changed<tp, tpo>, new trace::fst_trace_t<tp, tpo>(object, name));                                   \
-        all_traces.back().trc->is_triggered = true;                                                                                        \
+        attach_sampler(all_traces.back());                                                                                                 \
+        all_traces.back().trc->is_triggered = all_traces.back().smplr == nullptr;                                                          \
         return &all_traces.back();                                                                                                         \
     }
 
 #if(SYSTEMC_VERSION >= 20171012)
 observer::notification_handle* fst_trace_file::observe(const sc_core::sc_event& object, const std::string& name) { return nullptr; }
-observer::notification_handle* fst_trace_file::observe(const sc_core::sc_time& object, const std::string& name) { return nullptr; }
+DECL_REGISTER_METHOD_A(sc_core::sc_time)
 #endif
 
 DECL_REGISTER_METHOD_A(bool)
@@ -374,9 +398,12 @@ DECL_REGISTER_METHOD_A(sc_dt::sc_lv_base)
 #undef DECL_REGISTER_METHOD_C
 
 bool fst_trace_file::trace_entry::notify() {
-    if(!trc->is_alias && compare_and_update(trc))
+    // aliases and sampled traces are not recorded on change, returning false suspends the notifications
+    if(trc->is_alias || !trc->is_triggered)
+        return false;
+    if(compare_and_update(trc))
         that->triggered_traces.push_back(trc);
-    return !trc->is_alias;
+    return true;
 }
 
 void fst_trace_file::write_comment(const std::string& comment) {}
@@ -431,19 +458,33 @@ private:
 
 } // namespace
 void fst_trace_file::init() {
-    std::vector<trace_entry*> traces;
-    traces.reserve(all_traces.size());
+    write_scopes();
+    for(auto& e : all_traces)
+        if(!(e.trc->is_alias || e.trc->is_triggered))
+            pull_traces.push_back(&e);
+    changed_traces.reserve(pull_traces.size());
+    triggered_traces.reserve(all_traces.size());
+}
+
+void fst_trace_file::write_scopes() {
     scope_stack scope;
-    for(auto& e : all_traces) {
+    for(auto& e : all_traces)
         scope.add_trace(e.trc);
-        traces.push_back(&e);
-    }
     std::unordered_map<uintptr_t, fstHandle> alias_map;
     scope.writeScopes(m_fst, alias_map);
-    std::copy_if(std::begin(traces), std::end(traces), std::back_inserter(pull_traces),
-                 [](trace_entry const* e) { return !(e->trc->is_alias || e->trc->is_triggered); });
-    changed_traces.reserve(pull_traces.size());
-    triggered_traces.reserve(all_traces.size());
+}
+
+void fst_trace_file::rotate(uint64_t time_stamp) {
+    fstWriterClose(m_fst);
+    chunks->rotate(time_stamp);
+    open_writer();
+    write_scopes();
+    fstWriterEmitTimeChange(m_fst, time_stamp);
+    for(auto& e : all_traces)
+        if(!e.trc->is_alias)
+            e.trc->record(m_fst);
+    triggered_traces.clear();
+    changed_traces.clear();
 }
 
 void fst_trace_file::cycle(bool delta_cycle) {
@@ -451,7 +492,7 @@ void fst_trace_file::cycle(bool delta_cycle) {
         return;
     if(last_emitted_ts == std::numeric_limits<uint64_t>::max()) {
         init();
-        uint64_t time_stamp = sc_core::sc_time_stamp().value() / (1_ps).value();
+        uint64_t time_stamp = trace::to_ps(sc_core::sc_time_stamp());
         fstWriterEmitTimeChange(m_fst, time_stamp);
         for(auto& e : all_traces)
             if(!e.trc->is_alias)
@@ -460,12 +501,32 @@ void fst_trace_file::cycle(bool delta_cycle) {
     } else {
         if(check_enabled && !check_enabled())
             return;
+        uint64_t time_stamp = trace::to_ps(sc_core::sc_time_stamp());
+        ++sample_step;
         for(auto e : pull_traces) {
-            if(e->compare_and_update(e->trc))
+            if(e->smplr && !e->smplr->due(sample_step, time_stamp, e->last_sample_ps))
+                continue;
+            if(e->compare_and_update(e->trc)) {
                 changed_traces.push_back(e->trc);
+                if(e->smplr)
+                    e->last_sample_ps = time_stamp;
+            }
         }
         if(triggered_traces.size() || changed_traces.size()) {
-            uint64_t time_stamp = sc_core::sc_time_stamp().value() / (1_ps).value();
+            if(chunks->enabled() && last_emitted_ts < time_stamp) {
+                uint64_t size = 0;
+                // the FST writer flushes blocks only occasionally so there is no need to query the file size every time
+                if(++size_check_cnt % 1024 == 0) {
+                    struct stat st;
+                    if(stat(chunks->file_name().c_str(), &st) == 0)
+                        size = st.st_size;
+                }
+                if(chunks->needs_rotation(time_stamp, size)) {
+                    rotate(time_stamp);
+                    last_emitted_ts = time_stamp;
+                    return;
+                }
+            }
             if(last_emitted_ts < time_stamp)
                 fstWriterEmitTimeChange(m_fst, time_stamp);
             if(triggered_traces.size()) {
@@ -489,6 +550,10 @@ void fst_trace_file::set_time_unit(double v, sc_core::sc_time_unit tu) {}
 
 sc_core::sc_trace_file* create_fst_trace_file(const char* name, std::function<bool()> enable) { return new fst_trace_file(name, enable); }
 
+sc_core::sc_trace_file* create_fst_trace_file(const char* name, std::function<bool()> enable, trace_rotation const& rotation) {
+    return new fst_trace_file(name, enable, rotation);
+}
+
 void close_fst_trace_file(sc_core::sc_trace_file* tf) { delete static_cast<fst_trace_file*>(tf); }
 
 } // namespace scc
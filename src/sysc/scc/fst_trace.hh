@@ -19,11 +19,13 @@
 #define SCC_FST_TRACE_H
 
 #include <scc/observer.h>
+#include <scc/trace.h>
 #include <sysc/tracing/sc_trace.h>
 #include <sysc/kernel/sc_ver.h>
 #include <deque>
 #include <vector>
 #include <functional>
+#include <memory>
 
 namespace sc_core {
 class sc_time;
@@ -37,13 +39,17 @@ namespace scc {
 //! @brief SCC SystemC tracing utilities
 namespace trace {
 class fst_trace;
+class chunk_index;
+struct sampler;
 }
-struct fst_trace_file : public sc_core::sc_trace_file, public observer {
+struct fst_trace_file : public sc_core::sc_trace_file, public observer, public sampling_control {
 
-    fst_trace_file(const char *name, std::function<bool()>& enable);
+    fst_trace_file(const char *name, std::function<bool()>& enable, trace_rotation const& rotation = trace_rotation());
 
     virtual ~fst_trace_file();
 
+    void set_sampling_policy(sampling_policy const& policy) override { sampling = policy; }
+
 protected:
 #define DECL_TRACE_METHOD_A(tp) void trace(const tp& object, const std::string& name) override;
 #define DECL_TRACE_METHOD_B(tp) void trace(const tp& object, const std::string& name, int width) override;
@@ -137,12 +143,20 @@ private:
 #endif
 
     void init();
+    void open_writer();
+    void write_scopes();
+    void rotate(uint64_t time_stamp);
     std::function<bool()> check_enabled;
 
     void* m_fst{nullptr};
+    std::unique_ptr<trace::chunk_index> chunks;
+    unsigned size_check_cnt{0};
     struct trace_entry: public observer::notification_handle {
         bool (*compare_and_update)(trace::fst_trace*);
         trace::fst_trace* trc;
+        trace::sampler* smplr{nullptr};
+        //! the time of the last recorded change if sampled
+        uint64_t last_sample_ps{0};
         fst_trace_file* that;
         bool notify() override;
         trace_entry(fst_trace_file* owner, bool (*compare_and_update)(trace::fst_trace*), trace::fst_trace* trc)
@@ -150,6 +164,10 @@ private:
         virtual ~trace_entry(){}
     };
     std::deque<trace_entry> all_traces;
+    sampling_policy sampling;
+    std::vector<std::unique_ptr<trace::sampler>> samplers;
+    uint64_t sample_step{0};
+    void attach_sampler(trace_entry& e);
     std::vector<trace_entry*> pull_traces;
     std::vector<trace::fst_trace*> changed_traces;
     std::vector<trace::fst_trace*> triggered_traces;
@@ -35,6 +35,7 @@
 #include <scc/utilities.h>
 #include <sstream>
 #include <tlm>
+#include <typeindex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -63,26 +64,39 @@ std::string demangle(const char* name) { return name; }
 #endif
 std::string demangle(const char* name);
 
-template <class T> std::string type(const T& t) { return demangle(typeid(t).name()); }
+//! the strings shared by many objects (type names and kinds) are kept once
+std::string const& intern(std::string const& str) {
+    static std::unordered_set<std::string> pool;
+    return *pool.insert(str).first;
+}
+//! the demangled type names are cached as demangling allocates
+template <class T> std::string const& type(const T& t) {
+    static std::unordered_map<std::type_index, std::string const*> cache;
+    auto it = cache.find(std::type_index(typeid(t)));
+    if(it == cache.end())
+        it = cache.emplace(std::type_index(typeid(t)), &intern(demangle(typeid(t).name()))).first;
+    return *it->second;
+}
 
 unsigned object_counter{0};
 
 struct Module;
-
+/**
+ * the model of the design only holds copies of what is needed to write the dump so that it can be written in the
+ * background while the simulation runs. The full name of a port is the full name of its owner and its name, its type
+ * needs to be interned.
+ */
 struct Port {
-    std::string const fullname;
     std::string const name;
     void const* port_if{nullptr};
     bool input{false};
-    std::string const type;
+    std::string const& type;
     std::string const sig_name;
-    std::string const id{fmt::format("{}", ++object_counter)};
+    unsigned const id{++object_counter};
     Module* const owner;
 
-    Port(std::string const& fullname, std::string const& name, void const* ptr, bool input, std::string const& type, Module& owner,
-         std::string const& sig_name = "")
-    : fullname(fullname)
-    , name(name)
+    Port(std::string const& name, void const* ptr, bool input, std::string const& type, Module& owner, std::string const& sig_name = "")
+    : name(name)
     , port_if(ptr)
     , input(input)
     , type(type)
@@ -93,24 +107,26 @@ struct Port {
 struct Module {
     std::string const fullname;
     std::string const name;
-    std::string const type;
+    std::string const& type;
     Module* const parent;
-    std::string const id{fmt::format("{}", ++object_counter)};
+    unsigned const id{++object_counter};
     std::deque<std::unique_ptr<Module>> submodules;
     std::deque<Port> ports;
 
     Module(std::string const& fullname, std::string const& name, std::string const& type, Module& parent)
     : fullname(fullname)
     , name(name)
-    , type(type)
+    , type(intern(type))
     , parent(&parent) {}
     Module(std::string const& fullname, std::string const& name, std::string const& type)
     : fullname(fullname)
     , name(name)
-    , type(type)
+    , type(intern(type))
     , parent(nullptr) {}
 };
 
+inline std::ostream& operator<<(std::ostream& os, Port const& p) { return os << p.owner->fullname << "." << p.name; }
+
 const std::unordered_set<std::string> ignored_entities = {"tlm_initiator_socket",
                                                           "sc_export",
                                                           "sc_thread_process",
@@ -126,18 +142,21 @@ const std::unordered_set<std::string> ignored_entities = {"tlm_initiator_socket"
                                                           "tlm_signal",
                                                           "tlm_fifo",
                                                           "sc_register",
-                                                          "sc_buffer"};
+                                                          "sc_buffer",
+                                                          "fifo_w_cb",
+                                                          "sc_owning_signal"};
 
 const std::unordered_set<std::string> module_entities = {
     "sc_module",      "uvm::uvm_root",    "uvm::uvm_test",       "uvm::uvm_env",    "uvm::uvm_component",
     "uvm::uvm_agent", "uvm::uvm_monitor", "uvm::uvm_scoreboard", "uvm::uvm_driver", "uvm::uvm_sequencer"};
 
-std::string indent{"    "};
-std::string operator*(std::string const& str, const unsigned int level) {
-    std::ostringstream ss;
-    for(unsigned int i = 0; i < level; i++)
-        ss << str;
-    return ss.str();
+struct indent {
+    unsigned const level;
+};
+inline std::ostream& operator<<(std::ostream& os, indent const& i) {
+    for(unsigned l = 0; l < i.level; ++l)
+        os.write("    ", 4);
+    return os;
 }
 
 #if TLM_VERSION_MAJOR == 2 and TLM_VERSION_MINOR == 0 ///< version minor level ( numeric )
@@ -152,13 +171,19 @@ std::string operator*(std::string const& str, const unsigned int level) {
 #endif
 #endif
 
-std::vector<std::string> scan_object(sc_core::sc_object const* obj, Module& currentModule, unsigned const level) {
+/**
+ * scans obj and its children, modules and clocks deeper than max_depth (if not 0) are left out
+ */
+std::vector<std::string> scan_object(sc_core::sc_object const* obj, Module& currentModule, unsigned const level, unsigned const max_depth) {
     std::string name{obj->basename()};
     if(name.substr(0, 3) == "$$$")
         return {};
-    SCCDEBUG() << indent * level << obj->name() << "(" << obj->kind() << "), id=" << (object_counter + 1);
-    std::string kind{obj->kind()};
-    if(auto const* mod = dynamic_cast<sc_core::sc_module const*>(obj)) {
+    std::string const& kind = intern(obj->kind());
+    auto const* mod = dynamic_cast<sc_core::sc_module const*>(obj);
+    if((mod || kind == "sc_clock") && max_depth && level > max_depth)
+        return {};
+    SCCDEBUG() << indent{level} << obj->name() << "(" << obj->kind() << "), id=" << (object_counter + 1);
+    if(mod) {
         currentModule.submodules.emplace_back(new Module(obj->name(), name, type(*obj), currentModule));
         std::unordered_set<std::string> keep_outs;
         for(auto* child : mod->get_child_objects()) {
@@ -172,7 +197,7 @@ std::vector<std::string> scan_object(sc_core::sc_object const* obj, Module& curr
                 if(it != std::end(keep_outs))
                     continue;
             }
-            auto ks = scan_object(child, *currentModule.submodules.back(), level + 1);
+            auto ks = scan_object(child, *currentModule.submodules.back(), level + 1, max_depth);
             if(ks.size())
                 for(auto& s : ks)
                     keep_outs.insert(s);
@@ -180,18 +205,18 @@ std::vector<std::string> scan_object(sc_core::sc_object const* obj, Module& curr
     } else if(kind == "sc_clock") {
         sc_core::sc_prim_channel const* prim_chan = dynamic_cast<sc_core::sc_prim_channel const*>(obj);
         currentModule.submodules.emplace_back(new Module(obj->name(), name, type(*obj), currentModule));
-        currentModule.submodules.back()->ports.push_back(Port(std::string(obj->name()) + "." + name, name, prim_chan, false, obj->kind(),
-                                                              *currentModule.submodules.back(), obj->basename()));
+        currentModule.submodules.back()->ports.push_back(
+            Port(name, prim_chan, false, kind, *currentModule.submodules.back(), obj->basename()));
 #ifndef NO_TLM_EXTRACT
 #ifndef NCSC
     } else if(auto const* tptr = dynamic_cast<tlm::tlm_base_socket_if const*>(obj)) {
         auto cat = tptr->get_socket_category();
         bool input = (cat & tlm::TLM_TARGET_SOCKET) == tlm::TLM_TARGET_SOCKET;
         if(input) {
-            currentModule.ports.push_back(Port(obj->name(), name, GET_EXPORT_IF(tptr), input, kind, currentModule));
+            currentModule.ports.push_back(Port(name, GET_EXPORT_IF(tptr), input, kind, currentModule));
             return {name + "_port", name + "_port_0"};
         } else {
-            currentModule.ports.push_back(Port(obj->name(), name, GET_PORT_IF(tptr), input, kind, currentModule));
+            currentModule.ports.push_back(Port(name, GET_PORT_IF(tptr), input, kind, currentModule));
             return {name + "_export", name + "_export_0"};
         }
 #endif
@@ -200,15 +225,15 @@ std::vector<std::string> scan_object(sc_core::sc_object const* obj, Module& curr
         sc_core::sc_interface const* if_ptr = optr->get_interface();
         sc_core::sc_prim_channel const* if_obj = dynamic_cast<sc_core::sc_prim_channel const*>(if_ptr);
         bool is_input = kind == "sc_in" || kind == "sc_fifo_in";
-        currentModule.ports.push_back(Port(obj->name(), name, if_obj ? static_cast<void const*>(if_obj) : static_cast<void const*>(if_ptr),
-                                           is_input, obj->kind(), currentModule, if_obj ? if_obj->basename() : ""));
+        currentModule.ports.push_back(Port(name, if_obj ? static_cast<void const*>(if_obj) : static_cast<void const*>(if_ptr), is_input,
+                                           kind, currentModule, if_obj ? if_obj->basename() : ""));
     } else if(auto const* optr = dynamic_cast<sc_core::sc_export_base const*>(obj)) {
         sc_core::sc_interface const* pointer = optr->get_interface();
-        currentModule.ports.push_back(Port(obj->name(), name, pointer, true, obj->kind(), currentModule));
+        currentModule.ports.push_back(Port(name, pointer, true, kind, currentModule));
 #if defined(RECORD_UVM_ANALYSIS)
     } else if(kind == "sc_object" && dynamic_cast<sc_core::sc_interface const*>(obj)) {
         auto const* ifptr = dynamic_cast<sc_core::sc_interface const*>(obj);
-        currentModule.ports.push_back(Port(obj->name(), name, ifptr, false, obj->kind(), currentModule));
+        currentModule.ports.push_back(Port(name, ifptr, false, kind, currentModule));
 #endif
     } else if(ignored_entities.find(kind) == ignored_entities.end()) {
         SCCWARN() << "object not known (" << kind << ")";
@@ -227,27 +252,40 @@ void collect_ports_rec(Module& m, registry_t& registry) {
 }
 
 using breadcrumb_t = std::tuple<Module*, bool>;
-bool get_path_to(Module const* i, std::vector<breadcrumb_t>& bread_crumb, std::unordered_set<Module*>& visited) {
-    auto current_mod = std::get<0>(bread_crumb.back());
-    bool upwards = std::get<1>(bread_crumb.back());
-    if(current_mod == i)
-        return true;
-    if(visited.count(current_mod))
-        return false;
-    visited.insert(current_mod);
-    for(auto& c : current_mod->submodules) {
-        bread_crumb.emplace_back(c.get(), false);
-        if(get_path_to(i, bread_crumb, visited))
-            return true;
-        bread_crumb.pop_back();
+inline unsigned depth_of(Module const* m) {
+    unsigned depth = 0;
+    for(; m->parent; m = m->parent)
+        ++depth;
+    return depth;
+}
+/**
+ * appends the path from the module at the end of bread_crumb to target, the modules being entered upwards (up to the
+ * common ancestor) are flagged true, the ones entered downwards false. As the modules form a tree the path is found
+ * using the parent links instead of searching the hierarchy.
+ */
+void get_path_to(Module* target, std::vector<breadcrumb_t>& bread_crumb) {
+    auto up = std::get<0>(bread_crumb.back());
+    auto down = target;
+    auto up_depth = depth_of(up), down_depth = depth_of(down);
+    std::vector<Module*> downwards;
+    while(down_depth > up_depth) {
+        downwards.push_back(down);
+        down = down->parent;
+        --down_depth;
+    }
+    while(up_depth > down_depth) {
+        up = up->parent;
+        bread_crumb.emplace_back(up, true);
+        --up_depth;
     }
-    if(upwards && current_mod->parent) {
-        bread_crumb.emplace_back(current_mod->parent, true);
-        if(get_path_to(i, bread_crumb, visited))
-            return true;
-        bread_crumb.pop_back();
+    while(up != down) {
+        downwards.push_back(down);
+        down = down->parent;
+        up = up->parent;
+        bread_crumb.emplace_back(up, true);
     }
-    return false;
+    for(auto it = downwards.rbegin(); it != downwards.rend(); ++it)
+        bread_crumb.emplace_back(*it, false);
 }
 
 void infer_implicit_ports(Module& m) {
@@ -264,8 +302,8 @@ void infer_implicit_ports(Module& m) {
                 while(i != std::end(ports)) {
                     Port* end_port = *i;
                     std::vector<breadcrumb_t> bread_crumb{std::make_tuple(start_mod, true)};
-                    std::unordered_set<Module*> visited;
-                    if(get_path_to(end_port->owner, bread_crumb, visited) && bread_crumb.size() > 1) {
+                    get_path_to(end_port->owner, bread_crumb);
+                    if(bread_crumb.size() > 1) {
                         void const* port_if = end_port->port_if;
                         auto last_upwards = false;
                         while(bread_crumb.size() > 1) {
@@ -274,10 +312,8 @@ void infer_implicit_ports(Module& m) {
                             auto port_iter = std::find_if(std::begin(mod->ports), std::end(mod->ports),
                                                           [port_if](Port const& p) -> bool { return p.port_if == port_if; });
                             if(port_iter == std::end(mod->ports) && upwards == last_upwards) {
-                                std::ostringstream oss;
                                 auto ref_port = upwards ? start_port : end_port;
-                                oss << mod->fullname << "." << ref_port->name;
-                                mod->ports.push_back(Port(oss.str(), ref_port->name, port_if, !upwards, ref_port->type, *mod));
+                                mod->ports.push_back(Port(ref_port->name, port_if, !upwards, ref_port->type, *mod));
                             }
                             last_upwards = upwards;
                             bread_crumb.pop_back();
@@ -290,8 +326,44 @@ void infer_implicit_ports(Module& m) {
         }
     }
 }
+/**
+ * calls f(srcmod, srcport, tgtmod, tgtport) for the edges module <-> submodule and submodule -> submodule. The ports of the
+ * submodules are grouped by their interface beforehand so that the edges are found without comparing all pairs of ports
+ * while being visited in the same order.
+ */
+template <typename F> void for_each_edge(Module const& module, F f) {
+    std::unordered_map<void const*, std::vector<std::pair<Module const*, Port const*>>> sub_ports;
+    for(auto& m : module.submodules)
+        for(auto& port : m->ports)
+            if(port.port_if)
+                sub_ports[port.port_if].emplace_back(m.get(), &port);
+    if(sub_ports.empty())
+        return;
+    // Draw edges module <-> submodule:
+    for(auto& srcport : module.ports) {
+        if(srcport.port_if) {
+            auto it = sub_ports.find(srcport.port_if);
+            if(it != sub_ports.end())
+                for(auto& tgt : it->second)
+                    f(module, srcport, *tgt.first, *tgt.second);
+        }
+    }
+    // Draw edges submodule -> submodule:
+    for(auto& srcmod : module.submodules) {
+        for(auto& srcport : srcmod->ports) {
+            if(!srcport.input && srcport.port_if) {
+                for(auto& tgt : sub_ports[srcport.port_if]) {
+                    if(tgt.first == srcmod.get() && tgt.second->name == srcport.name)
+                        continue;
+                    if(tgt.second->input)
+                        f(*srcmod, srcport, *tgt.first, *tgt.second);
+                }
+            }
+        }
+    }
+}
+
 void generate_elk(std::ostream& e, Module const& module, unsigned level = 0) {
-    SCCDEBUG() << module.name;
     unsigned num_in{0}, num_out{0};
     for(auto& port : module.ports)
         if(port.input)
@@ -300,47 +372,25 @@ void generate_elk(std::ostream& e, Module const& module, unsigned level = 0) {
             num_out++;
     if(!module.ports.size() && !module.submodules.size())
         return;
-    e << indent * level << "node " << module.name << " {"
+    e << indent{level} << "node " << module.name << " {"
       << "\n";
     level++;
-    e << indent * level << "layout [ size: 50, " << std::max(80U, std::max(num_in, num_out) * 20) << " ]\n";
-    e << indent * level << "portConstraints: FIXED_SIDE\n";
-    e << indent * level << "label \"" << module.name << "\"\n";
+    e << indent{level} << "layout [ size: 50, " << std::max(80U, std::max(num_in, num_out) * 20) << " ]\n";
+    e << indent{level} << "portConstraints: FIXED_SIDE\n";
+    e << indent{level} << "label \"" << module.name << "\"\n";
 
     for(auto& port : module.ports) {
-        SCCDEBUG() << "    " << port.name << "\n";
         auto side = port.input ? "WEST" : "EAST";
-        e << indent * level << "port " << port.name << " { ^port.side: " << side << " label '" << port.name << "' }\n";
+        e << indent{level} << "port " << port.name << " { ^port.side: " << side << " label '" << port.name << "' }\n";
     }
 
     for(auto& m : module.submodules)
         generate_elk(e, *m, level);
-    // Draw edges module <-> submodule:
-    for(auto& srcport : module.ports) {
-        if(srcport.port_if)
-            for(auto& tgtmod : module.submodules) {
-                for(auto& tgtport : tgtmod->ports) {
-                    if(tgtport.port_if == srcport.port_if)
-                        e << indent * level << "edge " << srcport.fullname << " -> " << tgtport.fullname << "\n";
-                }
-            }
-    }
-    // Draw edges submodule -> submodule:
-    for(auto& srcmod : module.submodules) {
-        for(auto& srcport : srcmod->ports) {
-            if(!srcport.input && srcport.port_if)
-                for(auto& tgtmod : module.submodules) {
-                    for(auto& tgtport : tgtmod->ports) {
-                        if(srcmod->fullname == tgtmod->fullname && tgtport.fullname == srcport.fullname)
-                            continue;
-                        if(tgtport.port_if == srcport.port_if && tgtport.input)
-                            e << indent * level << "edge " << srcport.fullname << " -> " << tgtport.fullname << "\n";
-                    }
-                }
-        }
-    }
+    for_each_edge(module, [&e, level](Module const&, Port const& srcport, Module const&, Port const& tgtport) {
+        e << indent{level} << "edge " << srcport << " -> " << tgtport << "\n";
+    });
     level--;
-    e << indent * level << "}\n"
+    e << indent{level} << "}\n"
       << "\n";
 }
 
@@ -348,7 +398,7 @@ void generate_port_json(writer_type& writer, hierarchy_dumper::file_type type, c
     writer.StartObject();
     {
         writer.Key("id");
-        writer.String(p.id.c_str());
+        writer.String(fmt::format_int(p.id).c_str());
         if(type != hierarchy_dumper::D3JSON) {
             writer.Key("labels");
             writer.StartArray();
@@ -413,16 +463,15 @@ void generate_port_json(writer_type& writer, hierarchy_dumper::file_type type, c
 void generate_edge_json(writer_type& writer, const scc::Port& srcport, const scc::Port& tgtport) {
     writer.StartObject();
     {
-        auto edge_name = fmt::format("{}", ++object_counter);
         writer.Key("id");
-        writer.String(edge_name.c_str());
+        writer.String(fmt::format_int(++object_counter).c_str());
         writer.Key("sources");
         writer.StartArray();
-        { writer.String(srcport.id.c_str()); }
+        { writer.String(fmt::format_int(srcport.id).c_str()); }
         writer.EndArray();
         writer.Key("targets");
         writer.StartArray();
-        { writer.String(tgtport.id.c_str()); }
+        { writer.String(fmt::format_int(tgtport.id).c_str()); }
         writer.EndArray();
     }
     writer.EndObject();
@@ -432,17 +481,16 @@ void generate_edge_d3_json(writer_type& writer, const scc::Module& srcmod, const
                            const scc::Port& tgtport) {
     writer.StartObject();
     {
-        auto edge_name = fmt::format("{}", ++object_counter);
         writer.Key("id");
-        writer.String(edge_name.c_str());
+        writer.String(fmt::format_int(++object_counter).c_str());
         writer.Key("source");
-        writer.String(srcmod.id.c_str());
+        writer.String(fmt::format_int(srcmod.id).c_str());
         writer.Key("sourcePort");
-        writer.String(srcport.id.c_str());
+        writer.String(fmt::format_int(srcport.id).c_str());
         writer.Key("target");
-        writer.String(tgtmod.id.c_str());
+        writer.String(fmt::format_int(tgtmod.id).c_str());
         writer.Key("targetPort");
-        writer.String(tgtport.id.c_str());
+        writer.String(fmt::format_int(tgtport.id).c_str());
         writer.Key("hwMeta");
         writer.StartObject();
         {
@@ -474,7 +522,7 @@ void generate_mod_json(writer_type& writer, hierarchy_dumper::file_type type, Mo
     writer.StartObject();
     {
         writer.Key("id");
-        writer.String(module.id.c_str());
+        writer.String(fmt::format_int(module.id).c_str());
         // process ports
         writer.Key("ports");
         writer.StartArray();
@@ -501,43 +549,13 @@ void generate_mod_json(writer_type& writer, hierarchy_dumper::file_type type, Mo
             writer.Key("edges");
         writer.StartArray();
         {
-            // Draw edges module <-> submodule:
-            for(auto& srcport : module.ports) {
-                if(srcport.port_if) {
-                    for(auto& tgtmod : module.submodules) {
-                        for(auto& tgtport : tgtmod->ports) {
-                            if(tgtport.port_if == srcport.port_if) {
-                                if(type == hierarchy_dumper::D3JSON) {
-                                    generate_edge_d3_json(writer, module, srcport, *tgtmod, tgtport);
-                                } else {
-                                    generate_edge_json(writer, srcport, tgtport);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            // Draw edges submodule -> submodule:
-            for(auto& srcmod : module.submodules) {
-                for(auto& srcport : srcmod->ports) {
-                    if(!srcport.input && srcport.port_if) {
-                        for(auto& tgtmod : module.submodules) {
-                            for(auto& tgtport : tgtmod->ports) {
-                                if(srcmod->fullname == tgtmod->fullname && tgtport.fullname == srcport.fullname) {
-                                    continue;
-                                }
-                                if(tgtport.port_if == srcport.port_if && tgtport.input) {
-                                    if(type == hierarchy_dumper::D3JSON) {
-                                        generate_edge_d3_json(writer, *srcmod, srcport, *tgtmod, tgtport);
-                                    } else {
-                                        generate_edge_json(writer, srcport, tgtport);
-                                    }
-                                }
-                            }
-                        }
-                    }
+            for_each_edge(module, [&writer, type](Module const& srcmod, Port const& srcport, Module const& tgtmod, Port const& tgtport) {
+                if(type == hierarchy_dumper::D3JSON) {
+                    generate_edge_d3_json(writer, srcmod, srcport, tgtmod, tgtport);
+                } else {
+                    generate_edge_json(writer, srcport, tgtport);
                 }
-            }
+            });
         }
         writer.EndArray();
         if(type != hierarchy_dumper::D3JSON) {
@@ -595,36 +613,48 @@ void generate_mod_json(writer_type& writer, hierarchy_dumper::file_type type, Mo
     writer.EndObject();
 }
 
-std::unique_ptr<Module> scan_object_tree() {
+std::unique_ptr<Module> scan_top_module(sc_core::sc_object const* obj, unsigned max_depth) {
+    SCCDEBUG() << obj->name() << "(" << obj->kind() << ")";
+    auto topModule = scc::make_unique<Module>(obj->name(), obj->basename(), type(*obj));
+    for(auto* child : obj->get_child_objects())
+        scan_object(child, *topModule, 1, max_depth);
+    return topModule;
+}
+/**
+ * scans the subtree of the module named root (the whole design if empty) up to max_depth levels (all if 0)
+ */
+std::unique_ptr<Module> scan_object_tree(std::string const& root, unsigned max_depth) {
+    if(root.size()) {
+        if(auto* mod = dynamic_cast<sc_core::sc_module*>(sc_core::sc_find_object(root.c_str())))
+            return scan_top_module(mod, max_depth);
+        SCCWARN() << "hierarchy dump root '" << root << "' is not a module, dumping the whole design";
+    }
     std::vector<sc_core::sc_object*> obja = sc_core::sc_get_top_level_objects();
     if(obja.size() == 1 && std::string(obja[0]->kind()) == "sc_module" && std::string(obja[0]->basename()).substr(0, 3) != "$$$") {
-        SCCDEBUG() << obja[0]->name() << "(" << obja[0]->kind() << ")";
-        auto topModule = scc::make_unique<Module>(obja[0]->name(), obja[0]->basename(), type(*obja[0]));
-        for(auto* child : obja[0]->get_child_objects())
-            scan_object(child, *topModule, 1);
-        return topModule;
+        return scan_top_module(obja[0], max_depth);
     } else {
         SCCDEBUG() << "sc_main ( function sc_main() )";
         auto topModule = scc::make_unique<Module>("sc_main", "sc_main", "sc_main()");
         for(auto* child : obja)
-            scan_object(child, *topModule, 1);
+            scan_object(child, *topModule, 1, max_depth);
         return topModule;
     }
 }
-void dump_structure(std::ostream& e, hierarchy_dumper::file_type format) {
-    auto topModule = scan_object_tree();
-    infer_implicit_ports(*topModule);
+/**
+ * writes the scanned design while traversing it. As it does not access SystemC objects nor the logging it can be
+ * called from a background thread.
+ */
+void dump_structure(std::ostream& e, hierarchy_dumper::file_type format, Module& topModule, std::string const& label) {
+    infer_implicit_ports(topModule);
     if(format == hierarchy_dumper::ELKT) {
         e << "algorithm: org.eclipse.elk.layered\n";
         e << "edgeRouting: ORTHOGONAL\n";
-        generate_elk(e, *topModule);
-        SCCINFO() << "SystemC Structure Dumped to ELK file";
+        generate_elk(e, topModule);
     } else {
         OStreamWrapper stream(e);
         writer_type writer(stream);
         writer.StartObject();
         {
-            auto elems = util::split(sc_core::sc_argv()[0], '/');
             writer.Key("id");
             writer.String("0");
             writer.Key("labels");
@@ -633,7 +663,7 @@ void dump_structure(std::ostream& e, hierarchy_dumper::file_type format) {
                 writer.StartObject();
                 {
                     writer.Key("text");
-                    writer.String(elems[elems.size() - 1].c_str());
+                    writer.String(label.c_str());
                 }
                 writer.EndObject();
             }
@@ -647,7 +677,7 @@ void dump_structure(std::ostream& e, hierarchy_dumper::file_type format) {
             writer.EndObject();
             writer.Key("children");
             writer.StartArray();
-            { generate_mod_json(writer, format, *topModule); }
+            { generate_mod_json(writer, format, topModule); }
             writer.EndArray();
             writer.Key("edges");
             writer.StartArray();
@@ -661,7 +691,7 @@ void dump_structure(std::ostream& e, hierarchy_dumper::file_type format) {
                     writer.Key("maxId");
                     writer.Uint(65536);
                     writer.Key("name");
-                    writer.String(elems[elems.size() - 1].c_str());
+                    writer.String(label.c_str());
                 }
                 writer.EndObject();
                 writer.Key("properties");
@@ -676,23 +706,77 @@ void dump_structure(std::ostream& e, hierarchy_dumper::file_type format) {
             }
         }
         writer.EndObject();
-        SCCINFO() << "SystemC Structure Dumped to JSON file";
     }
 }
+
+void report_dump(bool written, hierarchy_dumper::file_type format, std::string const& file_name) {
+    if(!written)
+        SCCWARN() << "could not write SystemC structure to " << file_name;
+    else if(format == hierarchy_dumper::ELKT)
+        SCCINFO() << "SystemC Structure Dumped to ELK file";
+    else
+        SCCINFO() << "SystemC Structure Dumped to JSON file";
+}
 } // namespace
 
+static char const* const dump_root_name = "scc_hierarchy_dumper.root";
+static char const* const dump_depth_name = "scc_hierarchy_dumper.depth";
+static char const* const dump_in_background_name = "scc_hierarchy_dumper.background";
+
 hierarchy_dumper::hierarchy_dumper(const std::string& filename, file_type format)
 : sc_core::sc_module(sc_core::sc_module_name("$$$hierarchy_dumper$$$"))
 , dump_hier_file_name{filename}
-, dump_format{format} {}
+, dump_format{format} {
+    auto cci_broker = cci::cci_get_broker();
+    dump_root_handle = cci_broker.get_param_handle(dump_root_name);
+    if(!dump_root_handle.is_valid()) {
+        dump_root = scc::make_unique<cci::cci_param<std::string>>(
+            dump_root_name, "", "hierarchical name of the module whose subtree is dumped, the whole design if empty",
+            cci::CCI_ABSOLUTE_NAME);
+        dump_root_handle = cci_broker.get_param_handle(dump_root_name);
+    }
+    dump_depth_handle = cci_broker.get_param_handle(dump_depth_name);
+    if(!dump_depth_handle.is_valid()) {
+        dump_depth = scc::make_unique<cci::cci_param<unsigned>>(
+            dump_depth_name, 0, "number of hierarchy levels below the root being dumped, 0 dumps all levels", cci::CCI_ABSOLUTE_NAME);
+        dump_depth_handle = cci_broker.get_param_handle(dump_depth_name);
+    }
+    dump_in_background_handle = cci_broker.get_param_handle(dump_in_background_name);
+    if(!dump_in_background_handle.is_valid()) {
+        dump_in_background = scc::make_unique<cci::cci_param<bool>>(
+            dump_in_background_name, false, "write the hierarchy dump in a background thread while the simulation runs",
+            cci::CCI_ABSOLUTE_NAME);
+        dump_in_background_handle = cci_broker.get_param_handle(dump_in_background_name);
+    }
+}
 
 hierarchy_dumper::~hierarchy_dumper() {}
 
 void hierarchy_dumper::start_of_simulation() {
     if(dump_hier_file_name.size()) {
-        std::ofstream of{dump_hier_file_name};
-        if(of.is_open())
-            dump_structure(of, dump_format);
+        // the design is scanned here as the SystemC objects may only be accessed from the simulation thread
+        std::shared_ptr<Module> topModule = scan_object_tree(dump_root_handle.get_cci_value().get<std::string>(),
+                                                             dump_depth_handle.get_cci_value().get<unsigned>());
+        auto elems = util::split(sc_core::sc_argv()[0], '/');
+        auto label = elems[elems.size() - 1];
+        auto file_name = dump_hier_file_name;
+        auto format = dump_format;
+        auto dump = [topModule, label, file_name, format]() -> bool {
+            std::ofstream of{file_name};
+            if(!of.is_open())
+                return false;
+            dump_structure(of, format, *topModule, label);
+            return of.good();
+        };
+        if(dump_in_background_handle.get_cci_value().get<bool>())
+            dump_done = std::async(std::launch::async, dump);
+        else
+            report_dump(dump(), dump_format, dump_hier_file_name);
     }
 }
+
+void hierarchy_dumper::end_of_simulation() {
+    if(dump_done.valid())
+        report_dump(dump_done.get(), dump_format, dump_hier_file_name);
+}
 } // namespace scc
@@ -17,6 +17,9 @@
 #ifndef _SYSC_SCC_HIERARCHY_DUMPER_H_
 #define _SYSC_SCC_HIERARCHY_DUMPER_H_
 
+#include "utilities.h"
+#include <future>
+#include <memory>
 #include <systemc>
 
 /** \ingroup scc-sysc
@@ -31,6 +34,11 @@ namespace scc {
  * The hierarchy_dumper class provides a method for dumping the hierarchy of SystemC objects to a file in various formats.
  * It can be used to visualize the structure of a SystemC design or to analyze the interactions between different components.
  *
+ * The dump is controlled by the CCI parameters
+ * - scc_hierarchy_dumper.root: the hierarchical name of the module whose subtree is dumped, the whole design if empty
+ * - scc_hierarchy_dumper.depth: the number of hierarchy levels below the root being dumped, 0 dumps all levels
+ * - scc_hierarchy_dumper.background: if true the file is written by a background thread while the simulation runs
+ *
  * @author Your Name
  * @date YYYY-MM-DD
  */
@@ -60,7 +68,21 @@ private:
      * This function is responsible for dumping the hierarchy of SystemC objects to the specified file.
      */
     void start_of_simulation() override;
+    /**
+     * @brief Callback function that is invoked at the end of the simulation.
+     *
+     * This function waits for a dump being written in the background.
+     */
+    void end_of_simulation() override;
     file_type const dump_format;
+    cci::cci_param_handle dump_root_handle;
+    cci::cci_param_handle dump_depth_handle;
+    cci::cci_param_handle dump_in_background_handle;
+    std::unique_ptr<cci::cci_param<std::string>> dump_root;
+    std::unique_ptr<cci::cci_param<unsigned>> dump_depth;
+    std::unique_ptr<cci::cci_param<bool>> dump_in_background;
+    //! the result of the dump written in the background, true if the file could be written
+    std::future<bool> dump_done;
 };
 } // namespace scc
 /** @} */ // end of scc-sysc
@@ -17,7 +17,9 @@
 #ifndef _SCC_OBSERVER_H_
 #define _SCC_OBSERVER_H_
 
+#include <algorithm>
 #include <string>
+#include <vector>
 // needed for typedefs like sc_dt::int64
 #include <sysc/communication/sc_signal_ifs.h>
 #include <sysc/datatypes/int/sc_nbdefs.h>
@@ -93,6 +95,15 @@ struct observer {
 #endif
     virtual ~observer() {}
 };
+/**
+ * @fn void notify_observers(std::vector<observer::notification_handle*>&)
+ * @brief notifies the observers about a change, handles returning false (e.g. of aliases or sampled traces) are
+ * removed so that they are not called again
+ */
+inline void notify_observers(std::vector<observer::notification_handle*>& handles) {
+    handles.erase(std::remove_if(handles.begin(), handles.end(), [](observer::notification_handle* h) { return !h->notify(); }),
+                  handles.end());
+}
 
 #define DECL_REGISTER_METHOD_A(tp)                                                                                                         \
     inline observer::notification_handle* observe(observer* obs, tp const& o, std::string const& nm) { return obs->observe(o, nm); }
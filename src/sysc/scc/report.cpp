@@ -16,15 +16,25 @@
 #include "report.h"
 #include "configurer.h"
 #include <array>
+#include <condition_variable>
+#include <deque>
+#include <fmt/args.h>
+#include <fmt/format.h>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
+#include <util/log_binary_format.h>
 #include <util/logging.h>
+#include <util/spsc_ring.h>
+#include <vector>
 #ifdef WITH_STACKTRACE
 #include <boost/stacktrace.hpp>
 #endif
@@ -81,6 +91,8 @@ static struct {
         table.clear();
         cache.clear();
     }
+    //! names of the log_level parameters being watched for changes
+    std::unordered_set<std::string> watched;
     std::mutex mtx;
 } lut;
 #ifdef MTI_SYSTEMC
@@ -94,6 +106,34 @@ bool& inst_based_logging() {
     return active;
 }
 
+bool is_param(std::string const& name, char const* basename) {
+    auto len = strlen(basename);
+    return name.size() >= len && name.compare(name.size() - len, len, basename) == 0 &&
+           (name.size() == len || name[name.size() - len - 1] == '.');
+}
+//! true if the parameter controls the logging of a module
+bool is_log_setting_param(std::string const& name) {
+    return is_param(name, SCC_LOG_LEVEL_PARAM_NAME) || is_param(name, SCC_LOG_RATE_LIMIT_PARAM_NAME) ||
+           is_param(name, SCC_LOG_RATE_WINDOW_PARAM_NAME) || is_param(name, SCC_LOG_SUPPRESS_REPEATS_PARAM_NAME);
+}
+
+void invalidate_report_limits();
+//! drops all cached verbosities and rate limits, to be called whenever a log setting changes
+void invalidate_log_levels() {
+    {
+        std::unique_lock<std::mutex> lock(lut.mtx);
+        lut.clear();
+    }
+    scc::log_verbosity_cache::invalidate();
+    invalidate_report_limits();
+}
+//! makes sure a change of a log setting parameter invalidates the cached settings, to be called with lut.mtx held
+void watch_log_level(cci::cci_param_untyped_handle& h) {
+    if(lut.watched.insert(h.name()).second)
+        h.register_post_write_callback(
+            cci::cci_param_post_write_callback_untyped([](const cci::cci_param_write_event<>&) { invalidate_log_levels(); }));
+}
+
 static struct ExtLogConfig : public scc::LogConfig {
     shared_ptr<spdlog::logger> file_logger;
     shared_ptr<spdlog::logger> console_logger;
@@ -139,13 +179,13 @@ auto get_tuple(const sc_time& t) -> tuple<sc_time::value_type, sc_time_unit> {
     return make_tuple(val, static_cast<sc_time_unit>(tu));
 }
 
-auto time2string(const sc_time& t) -> string {
+//! appends the time value scaled to the largest unit it is a multiple of
+template <typename BUF> void append_time(BUF& buf, const sc_time& t) {
     const array<const char*, 6> time_units{"fs", "ps", "ns", "us", "ms", "s "};
     const array<uint64_t, 6> multiplier{
         1ULL, 1000ULL, 1000ULL * 1000, 1000ULL * 1000 * 1000, 1000ULL * 1000 * 1000 * 1000, 1000ULL * 1000 * 1000 * 1000 * 1000};
-    ostringstream oss;
     if(!t.value()) {
-        oss << "0 s ";
+        fmt::format_to(fmt::appender(buf), "0 s ");
     } else {
         const auto tt = get_tuple(t);
         const auto val = get<0>(tt);
@@ -155,58 +195,89 @@ auto time2string(const sc_time& t) -> string {
             if(fs_val >= multiplier[j]) {
                 const auto i = val / multiplier[j - scale];
                 const auto f = val % multiplier[j - scale];
-                oss << i << '.' << setw(3 * (j - scale)) << setfill('0') << right << f << ' ' << time_units[j];
+                fmt::format_to(fmt::appender(buf), "{}.{:0{}} {}", i, f, 3 * (j - scale), time_units[j]);
                 break;
             }
         }
     }
-    return oss.str();
 }
-auto compose_message(const sc_report& rep, const scc::LogConfig& cfg) -> const string {
-    if(rep.get_severity() > SC_INFO || cfg.log_filter_regex.length() == 0 || rep.get_verbosity() == sc_core::SC_MEDIUM ||
-       log_cfg.match(rep.get_msg_type())) {
-        stringstream os;
+
+auto time2string(const sc_time& t) -> string {
+    fmt::memory_buffer buf;
+    append_time(buf, t);
+    return fmt::to_string(buf);
+}
+//! appends str like util::padded() does without creating temporary strings
+inline void append_padded(fmt::memory_buffer& buf, const char* str, size_t width) {
+    auto len = strlen(str);
+    if(width < 7)
+        buf.append(str, str + len);
+    else if(len > width) {
+        buf.append(str, str + 3);
+        fmt::format_to(fmt::appender(buf), "...");
+        buf.append(str + len - (width - 6), str + len);
+    } else {
+        buf.append(str, str + len);
+        fmt::format_to(fmt::appender(buf), "{:{}}", "", width - len);
+    }
+}
+//! checks the report against the filter regex, true if it is to be logged
+inline bool is_logged(const sc_report& rep, const scc::LogConfig& cfg) {
+    return rep.get_severity() > SC_INFO || cfg.log_filter_regex.length() == 0 || rep.get_verbosity() == sc_core::SC_MEDIUM ||
+           log_cfg.match(rep.get_msg_type());
+}
+/**
+ * composes the log line of a report in a buffer being reused by all reports of the calling thread. The returned view
+ * is valid until the next call from the same thread, it is empty if the report is filtered out.
+ */
+auto compose_message(const sc_report& rep, const scc::LogConfig& cfg) -> fmt::string_view {
+    if(is_logged(rep, cfg)) {
+        static thread_local fmt::memory_buffer buf;
+        buf.clear();
+        auto out = fmt::appender(buf);
         if(unlikely(cfg.print_sys_time))
-            os << "<" << logging::now_time() << ">";
+            fmt::format_to(out, "<{}>", logging::now_time());
         if(likely(cfg.print_sim_time)) {
             if(unlikely(log_cfg.cycle_base.value())) {
                 if(unlikely(cfg.print_delta))
-                    os << "[" << std::setw(7) << std::setfill(' ') << sc_time_stamp().value() / log_cfg.cycle_base.value() << "(" << setw(5)
-                       << sc_delta_count() << ")]";
+                    fmt::format_to(out, "[{:7}({:5})]", sc_time_stamp().value() / log_cfg.cycle_base.value(), sc_delta_count());
                 else
-                    os << "[" << std::setw(7) << std::setfill(' ') << sc_time_stamp().value() / log_cfg.cycle_base.value() << "]";
+                    fmt::format_to(out, "[{:7}]", sc_time_stamp().value() / log_cfg.cycle_base.value());
             } else {
-                auto t = time2string(sc_time_stamp());
+                fmt::basic_memory_buffer<char, 32> t;
+                append_time(t, sc_time_stamp());
                 if(unlikely(cfg.print_delta))
-                    os << "[" << std::setw(20) << std::setfill(' ') << t << "(" << setw(5) << sc_delta_count() << ")]";
+                    fmt::format_to(out, "[{:>20}({:5})]", fmt::string_view(t.data(), t.size()), sc_delta_count());
                 else
-                    os << "[" << std::setw(20) << std::setfill(' ') << t << "]";
+                    fmt::format_to(out, "[{:>20}]", fmt::string_view(t.data(), t.size()));
             }
         }
         if(unlikely(rep.get_id() >= 0))
-            os << " ("
-               << "IWEF"[rep.get_severity()] << rep.get_id() << ") " << rep.get_msg_type() << ": ";
+            fmt::format_to(out, " ({}{}) {}: ", "IWEF"[rep.get_severity()], rep.get_id(), rep.get_msg_type());
         else if(cfg.msg_type_field_width) {
             if(cfg.msg_type_field_width == std::numeric_limits<unsigned>::max())
-                os << " " << rep.get_msg_type() << ": ";
-            else
-                os << " " << util::padded(rep.get_msg_type(), cfg.msg_type_field_width) << ": ";
+                fmt::format_to(out, " {}: ", rep.get_msg_type());
+            else {
+                fmt::format_to(out, " ");
+                append_padded(buf, rep.get_msg_type(), cfg.msg_type_field_width);
+                fmt::format_to(out, ": ");
+            }
         }
         if(*rep.get_msg())
-            os << rep.get_msg();
+            fmt::format_to(out, "{}", rep.get_msg());
         if(rep.get_severity() > SC_INFO) {
             if(rep.get_line_number())
-                os << "\n         [FILE:" << rep.get_file_name() << ":" << rep.get_line_number() << "]";
+                fmt::format_to(out, "\n         [FILE:{}:{}]", rep.get_file_name(), rep.get_line_number());
             sc_simcontext* simc = sc_get_curr_simcontext();
             if(simc && sc_is_running()) {
                 const char* proc_name = rep.get_process_name();
                 if(proc_name)
-                    os << "\n         [PROCESS:" << proc_name << "]";
+                    fmt::format_to(out, "\n         [PROCESS:{}]", proc_name);
             }
         }
-        return os.str();
+        return {buf.data(), buf.size()};
     } else
-        return "";
+        return {};
 }
 
 inline void log2logger(spdlog::logger& logger, const sc_report& rep, const scc::LogConfig& cfg) {
@@ -250,7 +321,497 @@ inline void log2logger(spdlog::logger& logger, const sc_report& rep, const scc::
     }
 }
 
+namespace lb = util::log_binary;
+/**
+ * writes reports as records of the binary log format described in util/log_binary_format.h. Each reporting thread
+ * owns a lock-free ring buffer which is drained into the file by a background thread, composing the text lines is left
+ * to the logbin2txt tool. If the ring buffer of a thread is full its messages are dropped and counted instead of
+ * stalling the simulation, records defining strings and sites wait for the background thread to make room.
+ */
+class binary_log {
+public:
+    static binary_log& get() {
+        static binary_log log;
+        return log;
+    }
+
+    ~binary_log() { close(); }
+
+    bool is_open() const { return active.load(std::memory_order_acquire); }
+
+    size_t buffer_size{4 * 1024 * 1024};
+
+    bool open(std::string const& name, scc::LogConfig const& cfg) {
+        if(active.load(std::memory_order_acquire))
+            return true;
+        ofs.open(name, ios::out | ios::binary | ios::trunc);
+        if(!ofs.is_open())
+            return false;
+        std::vector<uint8_t> hdr(std::begin(lb::magic), std::end(lb::magic));
+        lb::put(hdr, static_cast<uint64_t>(sc_time::from_value(1).to_seconds() * 1E15));
+        lb::put(hdr, cfg.msg_type_field_width ? cfg.msg_type_field_width : 24);
+        lb::put(hdr, (cfg.print_delta ? lb::PRINT_DELTA : 0) | (cfg.print_severity ? lb::PRINT_SEVERITY : 0));
+        ofs.write(reinterpret_cast<char const*>(hdr.data()), hdr.size());
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            producers.clear();
+            ++epoch;
+        }
+        stop.store(false, std::memory_order_release);
+        worker = std::thread([this]() { run(); });
+        active.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void close() {
+        if(!active.exchange(false, std::memory_order_acq_rel))
+            return;
+        stop.store(true, std::memory_order_release);
+        cv.notify_one();
+        worker.join();
+        // the messages dropped after the last record of a thread
+        std::vector<uint8_t> frame;
+        for(auto& p : producers)
+            if(p->dropped) {
+                dropped_record(*p);
+                frame.clear();
+                lb::put(frame, p->idx);
+                lb::put(frame, p->note.size());
+                frame.insert(frame.end(), p->note.begin(), p->note.end());
+                ofs.write(reinterpret_cast<char const*>(frame.data()), frame.size());
+            }
+        ofs.close();
+    }
+
+    void write(const sc_report& rep) {
+        auto& p = local();
+        sync_cycle_base(p);
+        auto site = site_id(p, rep);
+        uint64_t proc = 0;
+        if(rep.get_severity() > SC_INFO && sc_get_curr_simcontext() && sc_is_running() && rep.get_process_name())
+            proc = string_id(p, rep.get_process_name());
+        auto msg = rep.get_msg();
+        auto len = strlen(msg);
+        start(p, lb::MESSAGE);
+        lb::put(p.rec, site);
+        lb::put(p.rec, sc_time_stamp().value());
+        lb::put(p.rec, sc_delta_count());
+        lb::put(p.rec, proc);
+        lb::put(p.rec, len);
+        p.rec.insert(p.rec.end(), msg, msg + len);
+        finish(p, true);
+    }
+    //! writes a message of the formatting logging macros as its call site and its raw arguments
+    void write(scc::log_call_site const& site, char const* type, char const* format, scc::log_arg const* args, size_t count) {
+        auto& p = local();
+        sync_cycle_base(p);
+        auto id = format_id(p, site, format);
+        auto type_id = string_id(p, type);
+        start(p, lb::ARGS);
+        lb::put(p.rec, id);
+        lb::put(p.rec, type_id);
+        lb::put(p.rec, sc_time_stamp().value());
+        lb::put(p.rec, sc_delta_count());
+        lb::put(p.rec, count);
+        for(auto a = args; a != args + count; ++a) {
+            p.rec.push_back(a->kind);
+            switch(a->kind) {
+            case scc::log_arg::INT:
+                lb::put_signed(p.rec, a->i);
+                break;
+            case scc::log_arg::DOUBLE: {
+                uint8_t bytes[sizeof(double)];
+                memcpy(bytes, &a->d, sizeof(double));
+                p.rec.insert(p.rec.end(), bytes, bytes + sizeof(double));
+            } break;
+            case scc::log_arg::STRING:
+                lb::put(p.rec, a->len);
+                p.rec.insert(p.rec.end(), a->data(), a->data() + a->len);
+                break;
+            default:
+                lb::put(p.rec, a->u);
+            }
+        }
+        finish(p, true);
+    }
+    //! waits until the background thread wrote all records emitted so far
+    void flush() {
+        if(!active.load(std::memory_order_acquire))
+            return;
+        auto req = flush_req.fetch_add(1, std::memory_order_acq_rel) + 1;
+        cv.notify_one();
+        std::unique_lock<std::mutex> lock(mtx);
+        done_cv.wait(lock, [this, req]() { return flush_done >= req; });
+    }
+
+private:
+    struct site_key {
+        uint64_t type, file;
+        int line, severity, verbosity, id;
+        bool operator==(site_key const& o) const {
+            return type == o.type && file == o.file && line == o.line && severity == o.severity && verbosity == o.verbosity &&
+                   id == o.id;
+        }
+    };
+    struct site_hash {
+        size_t operator()(site_key const& k) const {
+            return static_cast<size_t>(((k.type * 31 + k.file) * 31 + k.line) * 31 + k.verbosity + (k.severity << 16) + k.id);
+        }
+    };
+    //! the state of a reporting thread, the ids of strings and sites are local to the thread
+    struct producer {
+        producer(unsigned idx, size_t capacity)
+        : idx(idx)
+        , ring(capacity) {}
+        unsigned const idx;
+        util::spsc_ring ring;
+        std::unordered_map<char const*, uint64_t, char_hash, char_equal_to> string_ids;
+        std::deque<std::string> strings;
+        std::unordered_map<site_key, uint64_t, site_hash> site_ids;
+        std::unordered_map<scc::log_call_site const*, uint64_t> format_ids;
+        uint64_t sites{0};
+        uint64_t cycle_base{0};
+        //! the number of messages dropped since the last record
+        uint64_t dropped{0};
+        std::vector<uint8_t> rec, note;
+    };
+
+    producer& local() {
+        thread_local std::pair<producer*, unsigned> current{nullptr, 0};
+        if(!current.first || current.second != epoch.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(mtx);
+            producers.emplace_back(new producer(producers.size(), buffer_size));
+            current = std::make_pair(producers.back().get(), epoch.load(std::memory_order_relaxed));
+        }
+        return *current.first;
+    }
+    //! returns the id of the string, emits a STRING record at first use
+    uint64_t string_id(producer& p, char const* str) {
+        if(!str)
+            str = "";
+        auto it = p.string_ids.find(str);
+        if(it != p.string_ids.end())
+            return it->second;
+        p.strings.emplace_back(str);
+        auto& s = p.strings.back();
+        uint64_t id = p.strings.size();
+        p.string_ids.emplace(s.c_str(), id);
+        start(p, lb::STRING);
+        lb::put(p.rec, id);
+        lb::put(p.rec, s.size());
+        p.rec.insert(p.rec.end(), s.begin(), s.end());
+        finish(p);
+        return id;
+    }
+    //! returns the id of the origin of the report, emits a SITE record at first use
+    uint64_t site_id(producer& p, const sc_report& rep) {
+        auto type = string_id(p, rep.get_msg_type());
+        auto file = string_id(p, rep.get_file_name());
+        site_key key{type, file, rep.get_line_number(), rep.get_severity(), rep.get_verbosity(), rep.get_id()};
+        auto it = p.site_ids.find(key);
+        if(it != p.site_ids.end())
+            return it->second;
+        uint64_t id = p.sites++;
+        p.site_ids.emplace(key, id);
+        start(p, lb::SITE);
+        lb::put(p.rec, id);
+        lb::put(p.rec, key.severity);
+        lb::put(p.rec, key.verbosity);
+        lb::put(p.rec, key.type);
+        lb::put(p.rec, key.file);
+        lb::put(p.rec, key.line);
+        lb::put(p.rec, key.id >= 0 ? key.id + 1 : 0);
+        finish(p);
+        return id;
+    }
+
+    //! returns the id of a call site of the formatting logging macros, emits a FORMAT record at first use
+    uint64_t format_id(producer& p, scc::log_call_site const& site, char const* format) {
+        auto it = p.format_ids.find(&site);
+        if(it != p.format_ids.end())
+            return it->second;
+        auto file = string_id(p, site.file);
+        auto fmt_str = string_id(p, format);
+        uint64_t id = p.sites++;
+        p.format_ids.emplace(&site, id);
+        start(p, lb::FORMAT);
+        lb::put(p.rec, id);
+        lb::put(p.rec, site.severity);
+        lb::put(p.rec, site.verbosity);
+        lb::put(p.rec, file);
+        lb::put(p.rec, site.line);
+        lb::put(p.rec, fmt_str);
+        finish(p);
+        return id;
+    }
+
+    void sync_cycle_base(producer& p) {
+        if(p.cycle_base != log_cfg.cycle_base.value()) {
+            p.cycle_base = log_cfg.cycle_base.value();
+            start(p, lb::CYCLE);
+            lb::put(p.rec, p.cycle_base);
+            finish(p);
+        }
+    }
+
+    void start(producer& p, lb::record_type type) {
+        p.rec.clear();
+        p.rec.push_back(type);
+    }
+    //! composes the DROPPED record of the producer in its note buffer, it is less than 128 bytes long
+    void dropped_record(producer& p) {
+        p.note.assign({0, lb::DROPPED});
+        lb::put(p.note, p.dropped);
+        p.note[0] = static_cast<uint8_t>(p.note.size() - 1);
+    }
+    //! queues the record in p.rec, a message (droppable) is dropped if it does not fit into the ring buffer
+    void finish(producer& p, bool droppable = false) {
+        uint8_t hdr[10];
+        size_t hdr_len = 0;
+        for(auto len = p.rec.size(); hdr_len == 0 || len; len >>= 7)
+            hdr[hdr_len++] = static_cast<uint8_t>(len >= 0x80 ? (len & 0x7f) | 0x80 : len);
+        if(droppable) {
+            p.note.clear();
+            if(p.dropped)
+                dropped_record(p);
+            if(p.ring.capacity() - p.ring.size() < p.note.size() + hdr_len + p.rec.size()) {
+                ++p.dropped;
+                cv.notify_one();
+                return;
+            }
+            push(p, p.note.data(), p.note.size());
+            p.dropped = 0;
+        }
+        push(p, hdr, hdr_len);
+        push(p, p.rec.data(), p.rec.size());
+        if(p.ring.size() > p.ring.capacity() / 2)
+            cv.notify_one();
+    }
+    //! writes into the ring buffer waiting for the background thread if it is full
+    void push(producer& p, uint8_t const* data, size_t len) {
+        while(len) {
+            auto n = p.ring.write(data, len);
+            data += n;
+            len -= n;
+            if(len) {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.notify_one();
+                space_cv.wait_for(lock, std::chrono::milliseconds(1), [&p]() { return p.ring.size() < p.ring.capacity(); });
+            }
+        }
+    }
+
+    void run() {
+        std::vector<producer*> rings;
+        std::vector<uint8_t> chunk(64 * 1024), hdr;
+        while(true) {
+            // both are read before draining so that all records emitted before a request are written
+            auto req = flush_req.load(std::memory_order_acquire);
+            auto stopping = stop.load(std::memory_order_acquire);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                for(auto i = rings.size(); i < producers.size(); ++i)
+                    rings.push_back(producers[i].get());
+            }
+            size_t total = 0;
+            for(auto* p : rings)
+                while(auto n = p->ring.read(chunk.data(), chunk.size())) {
+                    hdr.clear();
+                    lb::put(hdr, p->idx);
+                    lb::put(hdr, n);
+                    ofs.write(reinterpret_cast<char const*>(hdr.data()), hdr.size());
+                    ofs.write(reinterpret_cast<char const*>(chunk.data()), n);
+                    total += n;
+                }
+            if(total) {
+                // notifying under the lock cannot hit a producer between checking for space and waiting
+                std::lock_guard<std::mutex> lock(mtx);
+                space_cv.notify_all();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mtx);
+            if(flush_done < req) {
+                ofs.flush();
+                flush_done = req;
+                done_cv.notify_all();
+            }
+            if(stopping)
+                break;
+            cv.wait_for(lock, std::chrono::milliseconds(1));
+        }
+    }
+
+    //! read by all producer threads while open() and close() may be called from another one
+    std::atomic<bool> active{false};
+    std::ofstream ofs;
+    std::vector<std::unique_ptr<producer>> producers;
+    std::atomic<unsigned> epoch{0};
+    std::thread worker;
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> flush_req{0};
+    uint64_t flush_done{0};
+    std::mutex mtx;
+    std::condition_variable cv, done_cv, space_cv;
+};
+
+/**
+ * limits the number of info and warning reports per message type and time window and collapses identical consecutive
+ * messages as configured by the log_rate_limit, log_rate_window and log_suppress_repeats parameters of the reporting
+ * module or its closest parent. The number of suppressed messages is reported at the end of the simulation.
+ */
+class report_limiter : public sc_core::sc_stage_callback_if {
+public:
+    //! returns false if the report shall be dropped
+    bool pass(const sc_report& rep) {
+        if(bypass || rep.get_severity() > SC_WARNING || !inst_based_logging())
+            return true;
+        std::unique_lock<std::mutex> lock(mtx);
+        auto& s = state(rep.get_msg_type());
+        if(!s.limit && !s.collapse)
+            return true;
+        if(s.collapse) {
+            if(rep.get_severity() == s.last_severity && s.last_msg == rep.get_msg()) {
+                ++s.repeats;
+                return false;
+            }
+            if(s.repeats)
+                emit_repeats(rep.get_msg_type(), s);
+            s.last_msg = rep.get_msg();
+            s.last_severity = rep.get_severity();
+        }
+        if(s.limit) {
+            auto idx = sc_time_stamp().value() / s.window;
+            if(idx != s.window_idx) {
+                s.window_idx = idx;
+                s.window_count = 0;
+            }
+            if(++s.window_count > s.limit) {
+                ++s.dropped;
+                return false;
+            }
+        }
+        return true;
+    }
+    //! true if the reports of the message type are subject to a rate limit or the collapsing of repeats
+    bool limits(char const* type) {
+        if(bypass || !inst_based_logging())
+            return false;
+        std::unique_lock<std::mutex> lock(mtx);
+        auto& s = state(type);
+        return s.limit || s.collapse;
+    }
+    //! forces the settings to be read again at the next report
+    void invalidate() {
+        std::unique_lock<std::mutex> lock(mtx);
+        for(auto& e : states)
+            e.second.resolved = false;
+    }
+
+    void stage_callback(const sc_core::sc_stage&) override {
+        std::unique_lock<std::mutex> lock(mtx);
+        for(auto& e : states) {
+            auto& s = e.second;
+            if(s.repeats)
+                emit_repeats(e.first, s);
+            if(s.dropped) {
+                emit(e.first, fmt::format("{} messages suppressed by the rate limit of {} per {}", s.dropped, s.limit,
+                                          sc_time::from_value(s.window).to_string()));
+                s.dropped = 0;
+            }
+        }
+    }
+
+private:
+    struct limit_state {
+        bool resolved{false};
+        bool collapse{false};
+        unsigned limit{0};
+        uint64_t window{1};
+        uint64_t window_idx{0};
+        unsigned window_count{0};
+        uint64_t dropped{0};
+        std::string last_msg;
+        int last_severity{-1};
+        uint64_t repeats{0};
+    };
+
+    limit_state& state(char const* type) {
+        auto it = states.find(type);
+        if(it == states.end()) {
+            types.emplace_back(type);
+            it = states.emplace(types.back().c_str(), limit_state()).first;
+        }
+        auto& s = it->second;
+        if(!s.resolved) {
+            auto limit = setting(type, SCC_LOG_RATE_LIMIT_PARAM_NAME);
+            s.limit = limit.is_int() && limit.get_int() > 0 ? limit.get_int() : 0;
+            auto collapse = setting(type, SCC_LOG_SUPPRESS_REPEATS_PARAM_NAME);
+            s.collapse = collapse.is_bool() && collapse.get_bool();
+            sc_time window(1, SC_MS);
+            auto w = setting(type, SCC_LOG_RATE_WINDOW_PARAM_NAME);
+            if(w.is_number())
+                window = sc_time(w.get_number(), SC_NS);
+            else if(!w.is_null())
+                w.try_get(window);
+            s.window = window.value() ? window.value() : 1;
+            s.resolved = true;
+            if((s.limit || s.collapse) && !registered) {
+                sc_core::sc_register_stage_callback(*this, sc_core::SC_POST_END_OF_SIMULATION);
+                registered = true;
+            }
+        }
+        return s;
+    }
+    //! returns the value of the parameter for the module or its closest parent having it, a null value if none has
+    cci::cci_value setting(std::string name, char const* param) {
+        auto broker = sc_core::sc_get_current_object() ? cci::cci_get_broker() : cci::cci_get_global_broker(originator);
+        while(true) {
+            auto param_name = name.empty() ? std::string(param) : name + "." + param;
+            auto h = broker.get_param_handle(param_name);
+            if(h.is_valid()) {
+                std::unique_lock<std::mutex> lock(lut.mtx);
+                watch_log_level(h);
+                return h.get_cci_value();
+            }
+            auto val = broker.get_preset_cci_value(param_name);
+            if(!val.is_null())
+                return val;
+            if(name.empty())
+                return cci::cci_value();
+            auto pos = name.rfind('.');
+            name = pos == std::string::npos ? std::string() : name.substr(0, pos);
+        }
+    }
+
+    void emit_repeats(char const* type, limit_state& s) {
+        emit(type, fmt::format("last message repeated {} times", s.repeats));
+        s.repeats = 0;
+    }
+    //! reports a note of the limiter, it passes the handler unlimited
+    void emit(char const* type, std::string const& msg) {
+        bypass = true;
+        try {
+            sc_report_handler::report(SC_INFO, type, msg.c_str(), SC_NONE, "", 0);
+        } catch(...) {
+            bypass = false;
+            throw;
+        }
+        bypass = false;
+    }
+
+    std::unordered_map<char const*, limit_state, char_hash, char_equal_to> states;
+    std::deque<std::string> types;
+    bool registered{false};
+    std::mutex mtx;
+    static thread_local bool bypass;
+} limiter;
+
+thread_local bool report_limiter::bypass = false;
+
+void invalidate_report_limits() { limiter.invalidate(); }
+
 inline void flush_loggers() {
+    binary_log::get().flush();
     log_cfg.console_logger->flush();
     if(log_cfg.file_logger)
         log_cfg.file_logger->flush();
@@ -260,10 +821,16 @@ void report_handler(const sc_report& rep, const sc_actions& actions) {
     thread_local bool sc_stop_called = false;
     if(actions & SC_DO_NOTHING)
         return;
+    if(!limiter.pass(rep))
+        return;
     if(rep.get_severity() == sc_core::SC_INFO || !log_cfg.report_only_first_error || sc_report_handler::get_count(SC_ERROR) < 2) {
-        if((actions & SC_DISPLAY) && (!log_cfg.file_logger || rep.get_verbosity() < SC_HIGH))
+        auto& binlog = binary_log::get();
+        if((actions & SC_DISPLAY) && (!(log_cfg.file_logger || binlog.is_open()) || rep.get_verbosity() < SC_HIGH))
             log2logger(*log_cfg.console_logger, rep, log_cfg);
-        if((actions & SC_LOG) && log_cfg.file_logger) {
+        if((actions & SC_LOG) && binlog.is_open()) {
+            if(is_logged(rep, log_cfg))
+                binlog.write(rep);
+        } else if((actions & SC_LOG) && log_cfg.file_logger) {
             scc::LogConfig lcfg(log_cfg);
             lcfg.print_sim_time = true;
             if(!lcfg.msg_type_field_width)
@@ -291,8 +858,98 @@ void report_handler(const sc_report& rep, const sc_actions& actions) {
         flush_loggers();
     }
 }
+//! the message buffers of a thread, buffers [0, used) belong to log_streambuf instances currently alive
+struct log_buffer_pool {
+    vector<unique_ptr<fmt::memory_buffer>> buffers;
+    size_t used{0};
+};
+thread_local log_buffer_pool log_buffers;
+//! applies the fmt style format string to the arguments of a formatting logging macro
+auto format_message(char const* format, log_arg const* args, size_t count) -> string {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    for(auto a = args; a != args + count; ++a)
+        switch(a->kind) {
+        case log_arg::INT:
+            store.push_back(a->i);
+            break;
+        case log_arg::UINT:
+            store.push_back(a->u);
+            break;
+        case log_arg::DOUBLE:
+            store.push_back(a->d);
+            break;
+        case log_arg::BOOL:
+            store.push_back(a->u != 0);
+            break;
+        case log_arg::CHAR:
+            store.push_back(static_cast<char>(a->u));
+            break;
+        case log_arg::STRING:
+            store.push_back(fmt::string_view(a->data(), a->len));
+            break;
+        case log_arg::POINTER:
+            store.push_back(reinterpret_cast<void const*>(static_cast<uintptr_t>(a->u)));
+            break;
+        }
+    try {
+        return fmt::vformat(format, store);
+    } catch(fmt::format_error& e) {
+        return fmt::format("{} [{}]", format, e.what());
+    }
+}
 } // namespace
 
+void scc::log_formatted(log_call_site const& site, char const* type, char const* format, log_arg const* args, size_t count) {
+    if(!type)
+        type = "SystemC";
+    auto& binlog = binary_log::get();
+    // debug and trace messages are not displayed if a binary log is written, so they need no text if the report
+    // handler would pass them to the binary log
+    if(site.severity == SC_INFO && site.verbosity >= SC_HIGH && binlog.is_open() && !limiter.limits(type)) {
+        if(site.verbosity <= sc_report_handler::get_verbosity_level() && (log_cfg.log_filter_regex.empty() || log_cfg.match(type)))
+            binlog.write(site, type, format, args, count);
+        return;
+    }
+    auto msg = format_message(format, args, count);
+    sc_report_handler::report(site.severity, type, msg.c_str(), site.verbosity, site.file, site.line);
+}
+
+scc::log_streambuf::log_streambuf() {
+    auto& pool = log_buffers;
+    if(pool.used == pool.buffers.size())
+        pool.buffers.emplace_back(new fmt::memory_buffer);
+    auto* b = pool.buffers[pool.used++].get();
+    b->resize(b->capacity());
+    setp(b->data(), b->data() + b->size());
+    mem = b;
+}
+
+scc::log_streambuf::~log_streambuf() { --log_buffers.used; }
+
+auto scc::log_streambuf::c_str() -> const char* {
+    if(pptr() == epptr())
+        grow();
+    *pptr() = 0;
+    return pbase();
+}
+
+auto scc::log_streambuf::overflow(int_type ch) -> int_type {
+    if(traits_type::eq_int_type(ch, traits_type::eof()))
+        return traits_type::not_eof(ch);
+    grow();
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+void scc::log_streambuf::grow() {
+    auto* b = static_cast<fmt::memory_buffer*>(mem);
+    auto used = pptr() - pbase();
+    b->resize(2 * b->size());
+    setp(b->data(), b->data() + b->size());
+    pbump(static_cast<int>(used));
+}
+
 scc::stream_redirection::stream_redirection(ostream& os, log level)
 : os(os)
 , level(level) {
@@ -350,8 +1007,19 @@ auto scc::stream_redirection::sync() -> int {
 static void configure_logging() {
     std::lock_guard<mutex> lock(log_cfg.mtx);
     static bool spdlog_initialized = false;
-    if(!log_cfg.dont_create_broker)
+    if(!log_cfg.dont_create_broker) {
         scc::init_cci("SCCBroker");
+        static bool create_cb_registered = false;
+        if(!create_cb_registered) {
+            // a new log_level parameter might override the level inherited from a parent scope
+            cci::cci_get_global_broker(originator).register_create_callback(
+                cci::cci_param_create_callback([](const cci::cci_param_untyped_handle& h) {
+                    if(is_log_setting_param(h.name()))
+                        invalidate_log_levels();
+                }));
+            create_cb_registered = true;
+        }
+    }
     if(log_cfg.install_handler) {
         if(!log_cfg.instance_based_log_levels || getenv("SCC_DISABLE_INSTANCE_BASED_LOGGING"))
             inst_based_logging() = false;
@@ -371,7 +1039,12 @@ static void configure_logging() {
                 log_cfg.console_logger->set_pattern("[%L] %v");
             log_cfg.console_logger->flush_on(spdlog::level::err);
             log_cfg.console_logger->set_level(spdlog::level::level_enum::trace);
-            if(log_cfg.log_file_name.size()) {
+            if(log_cfg.binary_log_file_name.size()) {
+                if(!binary_log::get().open(log_cfg.binary_log_file_name, log_cfg))
+                    cerr << "Could not open binary log file " << log_cfg.binary_log_file_name << ", logging to "
+                         << (log_cfg.log_file_name.size() ? log_cfg.log_file_name : string("console")) << " instead\n";
+            }
+            if(log_cfg.log_file_name.size() && !binary_log::get().is_open()) {
                 {
                     ofstream ofs;
                     ofs.open(log_cfg.log_file_name, ios::out | ios::trunc);
@@ -389,7 +1062,7 @@ static void configure_logging() {
             spdlog_initialized = true;
         } else {
             log_cfg.console_logger = spdlog::get("console_logger");
-            if(log_cfg.log_file_name.size())
+            if(log_cfg.log_file_name.size() && !binary_log::get().is_open())
                 log_cfg.file_logger = spdlog::get("file_logger");
         }
         if(log_cfg.log_filter_regex.size()) {
@@ -441,6 +1114,7 @@ static void configure_logging() {
                     << msg;
         });
     }
+    scc::log_verbosity_cache::invalidate();
 }
 
 void scc::reinit_logging() { reinit_logging(log_cfg.level); }
@@ -449,7 +1123,7 @@ void scc::reinit_logging(scc::log level) {
     if(log_cfg.install_handler)
         sc_report_handler::set_handler(report_handler);
     log_cfg.level = level;
-    lut.clear();
+    invalidate_log_levels();
     if(!log_cfg.instance_based_log_levels || getenv("SCC_DISABLE_INSTANCE_BASED_LOGGING"))
         inst_based_logging() = false;
     log_cfg.initialized = true;
@@ -477,6 +1151,7 @@ void scc::set_logging_level(scc::log level) {
     log_cfg.console_logger->set_level(
         static_cast<spdlog::level::level_enum>(SPDLOG_LEVEL_OFF - min<int>(SPDLOG_LEVEL_OFF, static_cast<int>(log_cfg.level))));
     log_cfg.initialized = true;
+    scc::log_verbosity_cache::invalidate();
 }
 
 auto scc::get_logging_level() -> scc::log { return log_cfg.level; }
@@ -523,6 +1198,11 @@ auto scc::LogConfig::logFileName(const string& name) -> scc::LogConfig& {
     return *this;
 }
 
+auto scc::LogConfig::binaryLogFileName(const string& name) -> scc::LogConfig& {
+    this->binary_log_file_name = name;
+    return *this;
+}
+
 auto scc::LogConfig::coloredOutput(bool enable) -> scc::LogConfig& {
     this->colored_output = enable;
     return *this;
@@ -575,6 +1255,7 @@ auto scc::get_log_verbosity(char const* str) -> sc_core::sc_verbosity {
                 string param_name = (current_name.empty()) ? SCC_LOG_LEVEL_PARAM_NAME : current_name + "." SCC_LOG_LEVEL_PARAM_NAME;
                 auto h = broker.get_param_handle(param_name);
                 if(h.is_valid()) {
+                    watch_log_level(h);
                     sc_core::sc_verbosity ret = verbosity.at(std::min<unsigned>(h.get_cci_value().get_int(), verbosity.size() - 1));
                     lut.insert(str, ret);
                     return ret;
@@ -604,3 +1285,38 @@ auto scc::get_log_verbosity(char const* str) -> sc_core::sc_verbosity {
     }
     return static_cast<sc_core::sc_verbosity>(::sc_core::sc_report_handler::get_verbosity_level());
 }
+
+std::atomic<uint64_t> scc::log_verbosity_cache::generation{0};
+constexpr uint64_t scc::log_verbosity_cache::EMPTY;
+
+auto scc::log_verbosity_cache::update(char const* t) -> sc_core::sc_verbosity {
+    // read the generation first so that a concurrent change of the configuration invalidates the new entry
+    auto gen = generation.load(std::memory_order_acquire);
+    // the global level is not cached without instance based logging
+    if(!inst_based_logging())
+        return get_log_verbosity(t);
+    // the verbosity per scope name as seen by this thread, it serves call sites used by more scopes than they have ways.
+    // It is cleared if the generation changes and bounded in size as names built at runtime might never be used again
+    thread_local std::unordered_map<char const*, sc_core::sc_verbosity> scopes;
+    thread_local uint64_t scopes_gen = gen;
+    if(scopes_gen != gen || scopes.size() >= MAX_SCOPES) {
+        scopes.clear();
+        scopes_gen = gen;
+    }
+    auto it = scopes.find(t);
+    if(it == scopes.end())
+        it = scopes.emplace(t, get_log_verbosity(t)).first;
+    auto ret = it->second;
+    auto key = reinterpret_cast<uintptr_t>(t);
+    // only the levels used by SCC fit into a way
+    if(key < (1ULL << 48) && ret >= 0 && ret <= 700 && ret % 100 == 0) {
+        if(valid_gen.load(std::memory_order_acquire) != gen) {
+            for(auto& w : ways)
+                w.store(EMPTY, std::memory_order_relaxed);
+            valid_gen.store(gen, std::memory_order_release);
+        }
+        auto entry = static_cast<uint64_t>(key) << 16 | (gen & GEN_MASK) << 3 | static_cast<uint64_t>(ret / 100);
+        ways[next_way.fetch_add(1, std::memory_order_relaxed) % WAYS].store(entry, std::memory_order_relaxed);
+    }
+    return ret;
+}
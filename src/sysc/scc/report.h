@@ -18,14 +18,18 @@
 #define _SCC_REPORT_H_
 
 #include "utilities.h"
+#include <atomic>
 #include <cci_configuration>
+#include <cstdint>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 #include <sysc/kernel/sc_time.h>
 #include <sysc/utils/sc_report.h>
+#include <type_traits>
 #include <unordered_map>
 #include <util/ities.h>
 
@@ -57,6 +61,16 @@ The macros take an optional argument which becomes the message type. If not prov
 | SCCTRACE      | SC_INFO          | SC_FULL           |
 | SCCTRACEALL   | SC_INFO          | SC_DEBUG          |
 
+Each macro has a variant with the suffix F (e.g. SCCDEBUGF) taking the message type, a fmt style format string and
+its arguments instead of providing a stream:
+
+    SCCDEBUGF(SCMOD, "read {} bytes at 0x{:x}", len, addr);
+
+If a binary log file is configured the debug and trace messages of these macros are written as the id of the call
+site and the raw argument values without composing the text or a sc_report, the formatting is left to logbin2txt.
+The stream based macros always compose the text and the sc_report on the calling thread, so only call sites using
+the F variants benefit from the deferred formatting.
+
 ## Reporting backend
 
 The backend is initialized using the short form:
@@ -75,6 +89,19 @@ writing. By default spdlog logs asyncronously to keep the performance impact low
  */
 //! the name of the CCI property to attach to modules to control logging of this module
 #define SCC_LOG_LEVEL_PARAM_NAME "log_level"
+//! the name of the CCI property limiting the number of info and warning messages of a module per time window
+#define SCC_LOG_RATE_LIMIT_PARAM_NAME "log_rate_limit"
+//! the name of the CCI property setting the time window of the rate limit (a sc_time or a number of ns), default 1ms
+#define SCC_LOG_RATE_WINDOW_PARAM_NAME "log_rate_window"
+//! the name of the CCI property enabling the collapsing of identical consecutive info and warning messages of a module
+#define SCC_LOG_SUPPRESS_REPEATS_PARAM_NAME "log_suppress_repeats"
+/**
+ * the most verbose log level compiled in given as number of scc::log, set by the SCC_LOG_LEVEL_MAX CMake cache variable.
+ * The output of the SCC logging macros above this level is removed including the evaluation of the arguments.
+ */
+#ifndef SCC_LOG_LEVEL_MAX
+#define SCC_LOG_LEVEL_MAX 7
+#endif
 /** \ingroup scc-sysc
  *  @{
  */
@@ -168,6 +195,7 @@ struct LogConfig {
     bool print_severity{true};
     bool colored_output{true};
     std::string log_file_name{""};
+    std::string binary_log_file_name{""};
     std::string log_filter_regex{""};
     bool log_async{true};
     bool dont_create_broker{false};
@@ -229,6 +257,13 @@ struct LogConfig {
      * @return self
      */
     LogConfig& logFileName(const std::string&);
+    /**
+     * set the file name for the binary log output file. Messages going to the log file are then written as compact
+     * binary records by a background thread, the logbin2txt tool converts them into the text format of the log file.
+     * @param name of the binary log file to be generated
+     * @return self
+     */
+    LogConfig& binaryLogFileName(const std::string&);
     /**
      * set the file name for the log output file
      * @param name
@@ -340,6 +375,84 @@ sc_core::sc_verbosity get_log_verbosity(char const* t);
  * @return the verbosity level
  */
 inline sc_core::sc_verbosity get_log_verbosity(std::string const& t) { return get_log_verbosity(t.c_str()); }
+/**
+ * @class log_verbosity_cache
+ * @brief the verbosity cache of a logging call site
+ *
+ * Each logging macro owns a static instance which remembers the verbosity determined for the last WAYS scope names
+ * used at this call site, so a call site inside a class having several instances hits as well. Each way packs the
+ * address of the name, the verbosity and the low bits of the generation of the log configuration into a single atomic
+ * word, the table as a whole is valid for the full generation it was filled in. As long as neither the names nor the
+ * configuration change checking the verbosity takes a few relaxed loads and compares instead of a locked lookup. A
+ * miss is served from a bounded per thread cache of the scope names before falling back to the locked lookup. Any change of
+ * the log configuration, be it via the API or via a CCI log_level parameter, increments the generation and thus
+ * invalidates all caches.
+ */
+class log_verbosity_cache {
+public:
+    constexpr log_verbosity_cache()
+    : valid_gen(~0ULL)
+    , ways{{EMPTY}, {EMPTY}, {EMPTY}, {EMPTY}}
+    , next_way(0) {}
+    //! the global verbosity level, there is nothing to cache
+    sc_core::sc_verbosity get() const { return get_log_verbosity(); }
+    //! the verbosity of the given scope, the name is identified by its address so it needs to be stored at a stable
+    //! address as long as it is in use (e.g. a literal or the name of a sc_object), a reused address might see the
+    //! cached verbosity of the previous name until the log configuration changes
+    sc_core::sc_verbosity get(char const* t) {
+        auto gen = generation.load(std::memory_order_relaxed);
+        if(valid_gen.load(std::memory_order_relaxed) == gen) {
+            auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(t)) << 16 | (gen & GEN_MASK) << 3;
+            for(auto& w : ways) {
+                auto e = w.load(std::memory_order_relaxed);
+                if((e & ~7ULL) == key)
+                    return static_cast<sc_core::sc_verbosity>((e & 7) * 100);
+            }
+        }
+        return update(t);
+    }
+    //! names given as std::string are usually temporaries so their address does not identify the scope
+    sc_core::sc_verbosity get(std::string const& t) const { return get_log_verbosity(t.c_str()); }
+    //! invalidate the cached verbosity of all call sites
+    static void invalidate() { generation.fetch_add(1, std::memory_order_acq_rel); }
+
+private:
+    enum { WAYS = 4, GEN_MASK = 0x1fff, MAX_SCOPES = 4096 };
+    //! the value of an unused way, it matches no name
+    static constexpr uint64_t EMPTY = ~0ULL;
+    sc_core::sc_verbosity update(char const* t);
+    std::atomic<uint64_t> valid_gen;
+    std::atomic<uint64_t> ways[WAYS];
+    std::atomic<unsigned> next_way;
+    static std::atomic<uint64_t> generation;
+};
+/**
+ * @class log_streambuf
+ * @brief the stream buffer collecting the text of a log message
+ *
+ * The text is written into memory owned by the current thread which is reused for all its messages so composing a
+ * message does not allocate once the buffer has grown to the size of the longest message. Messages being composed
+ * while another one is still open (e.g. by a function called to produce an argument) use their own buffer.
+ */
+class log_streambuf : public std::streambuf {
+public:
+    log_streambuf();
+
+    ~log_streambuf() override;
+
+    log_streambuf(const log_streambuf&) = delete;
+
+    log_streambuf& operator=(const log_streambuf&) = delete;
+    //! the zero terminated text written so far, valid until the next write or the destruction of the buffer
+    const char* c_str();
+
+protected:
+    int_type overflow(int_type ch) override;
+
+private:
+    void grow();
+    void* mem{nullptr};
+};
 /**
  * @struct ScLogger
  * @brief the logger class
@@ -378,7 +491,7 @@ template <sc_core::sc_severity SEVERITY> struct ScLogger {
      *
      */
     virtual ~ScLogger() noexcept(false) {
-        ::sc_core::sc_report_handler::report(SEVERITY, t ? t : "SystemC", os.str().c_str(), level, file, line);
+        ::sc_core::sc_report_handler::report(SEVERITY, t ? t : "SystemC", buf.c_str(), level, file, line);
     }
     /**
      * @fn ScLogger& type()
@@ -414,49 +527,197 @@ template <sc_core::sc_severity SEVERITY> struct ScLogger {
     }
     /**
      * @fn std::ostream& get()
-     * @brief  get the underlying ostringstream
+     * @brief  get the underlying output stream
      *
      * @return the output stream collecting the log message
      */
     inline std::ostream& get() { return os; };
 
 protected:
-    std::ostringstream os{};
+    log_streambuf buf{};
+    std::ostream os{&buf};
     char* t{nullptr};
     const char* file;
     const int line;
     const int level;
 };
 
+/**
+ * @struct log_arg
+ * @brief an argument of a message of the formatting logging macros
+ *
+ * Arithmetic values, pointers and strings are captured by value resp. by reference without formatting them. Any other
+ * type is rendered using its output stream operator as the stream based macros do.
+ */
+struct log_arg {
+    enum kind_e : uint8_t { INT, UINT, DOUBLE, BOOL, CHAR, STRING, POINTER };
+
+    log_arg(bool v)
+    : kind(BOOL)
+    , u(v) {}
+
+    log_arg(char v)
+    : kind(CHAR)
+    , u(static_cast<unsigned char>(v)) {}
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+    log_arg(T v)
+    : kind(INT)
+    , i(v) {}
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, int>::type = 0>
+    log_arg(T v)
+    : kind(UINT)
+    , u(v) {}
+
+    template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    log_arg(T v)
+    : kind(DOUBLE)
+    , d(v) {}
+
+    log_arg(char const* v)
+    : kind(STRING)
+    , u(0)
+    , str(v ? v : "")
+    , len(strlen(str)) {}
+
+    log_arg(std::string const& v)
+    : kind(STRING)
+    , u(0)
+    , str(v.c_str())
+    , len(v.size()) {}
+
+    template <typename T, typename std::enable_if<!std::is_same<typename std::remove_cv<T>::type, char>::value, int>::type = 0>
+    log_arg(T* v)
+    : kind(POINTER)
+    , u(reinterpret_cast<uintptr_t>(v)) {}
+
+    template <typename T, typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_pointer<T>::value, int>::type = 0>
+    log_arg(T const& v)
+    : kind(STRING)
+    , u(0) {
+        std::ostringstream os;
+        os << v;
+        owned = os.str();
+        len = owned.size();
+    }
+    //! the characters of a STRING argument
+    char const* data() const { return owned.size() ? owned.data() : str; }
+
+    kind_e kind;
+    union {
+        long long i;
+        unsigned long long u;
+        double d;
+    };
+    char const* str{nullptr};
+    size_t len{0};
+    std::string owned;
+};
+/**
+ * @struct log_call_site
+ * @brief the static description of a call site of the formatting logging macros
+ */
+struct log_call_site {
+    sc_core::sc_severity severity;
+    int verbosity;
+    char const* file;
+    int line;
+};
+/**
+ * @fn void log_formatted(const log_call_site&, const char*, const char*, const log_arg*, size_t)
+ * @brief emits a message of the formatting logging macros
+ *
+ * Debug and trace messages only going to the binary log are written as raw arguments, all others are formatted and
+ * reported via the sc_report_handler like the messages of the stream based macros.
+ *
+ * @param site the call site
+ * @param type the message type
+ * @param format the fmt style format string
+ * @param args the arguments
+ * @param count the number of arguments
+ */
+void log_formatted(log_call_site const& site, char const* type, char const* format, log_arg const* args, size_t count);
+
+template <typename... ARGS>
+inline void log_format(log_call_site const& site, char const* type, char const* format, ARGS const&... args) {
+    log_arg const list[] = {log_arg(args)..., log_arg(false)};
+    log_formatted(site, type, format, list, sizeof...(ARGS));
+}
+
+template <typename... ARGS>
+inline void log_format(log_call_site const& site, std::string const& type, char const* format, ARGS const&... args) {
+    log_format(site, type.c_str(), format, args...);
+}
 /**
  * logging macros
  */
+//! the verbosity applying to a logging call site, cached in a static slot of the call site
+#define SCC_CALL_SITE_VERBOSITY(...)                                                                                                       \
+    ([]() -> ::scc::log_verbosity_cache& {                                                                                                 \
+        static ::scc::log_verbosity_cache cache;                                                                                           \
+        return cache;                                                                                                                      \
+    }().get(__VA_ARGS__))
+//! true if the output of the given scc::log level (as number, names might clash with other macros) is compiled in
+#define SCC_LOG_COMPILED(LVL) ((LVL) <= SCC_LOG_LEVEL_MAX)
 //! macro for log output
 #define SCCLOG(lvl, ...) ::scc::ScLogger<::sc_core::SC_INFO>(__FILE__, __LINE__, lvl).type(__VA_ARGS__).get()
 //! macro for debug trace level output
 #define SCCTRACEALL(...)                                                                                                                   \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_DEBUG)                                                                         \
+    if(SCC_LOG_COMPILED(7) && SCC_CALL_SITE_VERBOSITY(__VA_ARGS__) >= sc_core::SC_DEBUG)                                                   \
     SCCLOG(sc_core::SC_DEBUG, __VA_ARGS__)
 //! macro for trace level output
 #define SCCTRACE(...)                                                                                                                      \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_FULL)                                                                          \
+    if(SCC_LOG_COMPILED(6) && SCC_CALL_SITE_VERBOSITY(__VA_ARGS__) >= sc_core::SC_FULL)                                                    \
     SCCLOG(sc_core::SC_FULL, __VA_ARGS__)
 //! macro for debug level output
 #define SCCDEBUG(...)                                                                                                                      \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_HIGH)                                                                          \
+    if(SCC_LOG_COMPILED(5) && SCC_CALL_SITE_VERBOSITY(__VA_ARGS__) >= sc_core::SC_HIGH)                                                    \
     SCCLOG(sc_core::SC_HIGH, __VA_ARGS__)
 //! macro for info level output
 #define SCCINFO(...)                                                                                                                       \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_MEDIUM)                                                                        \
+    if(SCC_LOG_COMPILED(4) && SCC_CALL_SITE_VERBOSITY(__VA_ARGS__) >= sc_core::SC_MEDIUM)                                                  \
     SCCLOG(sc_core::SC_MEDIUM, __VA_ARGS__)
 //! macro for warning level output
 #define SCCWARN(...)                                                                                                                       \
-    if(::scc::get_log_verbosity(__VA_ARGS__) >= sc_core::SC_LOW)                                                                           \
+    if(SCC_LOG_COMPILED(3) && SCC_CALL_SITE_VERBOSITY(__VA_ARGS__) >= sc_core::SC_LOW)                                                     \
     ::scc::ScLogger<::sc_core::SC_WARNING>(__FILE__, __LINE__, sc_core::SC_MEDIUM).type(__VA_ARGS__).get()
 //! macro for error level output
 #define SCCERR(...) ::scc::ScLogger<::sc_core::SC_ERROR>(__FILE__, __LINE__, sc_core::SC_MEDIUM).type(__VA_ARGS__).get()
 //! macro for fatal message output
 #define SCCFATAL(...) ::scc::ScLogger<::sc_core::SC_FATAL>(__FILE__, __LINE__, sc_core::SC_MEDIUM).type(__VA_ARGS__).get()
+//! the static description of a call site of the formatting logging macros
+#define SCC_LOG_CALL_SITE(SEVERITY, LVL)                                                                                                   \
+    ([]() -> ::scc::log_call_site const& {                                                                                                 \
+        static const ::scc::log_call_site site{SEVERITY, LVL, __FILE__, __LINE__};                                                         \
+        return site;                                                                                                                       \
+    }())
+//! macro for formatted log output, the arguments following the message type are the format string and its arguments
+#define SCCLOGF(lvl, TYPE, ...) ::scc::log_format(SCC_LOG_CALL_SITE(::sc_core::SC_INFO, lvl), TYPE, __VA_ARGS__)
+//! macro for formatted debug trace level output
+#define SCCTRACEALLF(TYPE, ...)                                                                                                            \
+    if(SCC_LOG_COMPILED(7) && SCC_CALL_SITE_VERBOSITY(TYPE) >= sc_core::SC_DEBUG)                                                          \
+    SCCLOGF(sc_core::SC_DEBUG, TYPE, __VA_ARGS__)
+//! macro for formatted trace level output
+#define SCCTRACEF(TYPE, ...)                                                                                                               \
+    if(SCC_LOG_COMPILED(6) && SCC_CALL_SITE_VERBOSITY(TYPE) >= sc_core::SC_FULL)                                                           \
+    SCCLOGF(sc_core::SC_FULL, TYPE, __VA_ARGS__)
+//! macro for formatted debug level output
+#define SCCDEBUGF(TYPE, ...)                                                                                                               \
+    if(SCC_LOG_COMPILED(5) && SCC_CALL_SITE_VERBOSITY(TYPE) >= sc_core::SC_HIGH)                                                           \
+    SCCLOGF(sc_core::SC_HIGH, TYPE, __VA_ARGS__)
+//! macro for formatted info level output
+#define SCCINFOF(TYPE, ...)                                                                                                                \
+    if(SCC_LOG_COMPILED(4) && SCC_CALL_SITE_VERBOSITY(TYPE) >= sc_core::SC_MEDIUM)                                                         \
+    SCCLOGF(sc_core::SC_MEDIUM, TYPE, __VA_ARGS__)
+//! macro for formatted warning level output
+#define SCCWARNF(TYPE, ...)                                                                                                                \
+    if(SCC_LOG_COMPILED(3) && SCC_CALL_SITE_VERBOSITY(TYPE) >= sc_core::SC_LOW)                                                            \
+    ::scc::log_format(SCC_LOG_CALL_SITE(::sc_core::SC_WARNING, sc_core::SC_MEDIUM), TYPE, __VA_ARGS__)
+//! macro for formatted error level output
+#define SCCERRF(TYPE, ...) ::scc::log_format(SCC_LOG_CALL_SITE(::sc_core::SC_ERROR, sc_core::SC_MEDIUM), TYPE, __VA_ARGS__)
+//! macro for formatted fatal message output
+#define SCCFATALF(TYPE, ...) ::scc::log_format(SCC_LOG_CALL_SITE(::sc_core::SC_FATAL, sc_core::SC_MEDIUM), TYPE, __VA_ARGS__)
 
 #ifdef NDEBUG
 #define SCC_ASSERT(expr) ((void)0)
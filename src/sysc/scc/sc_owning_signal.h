@@ -17,8 +17,10 @@
 #ifndef _SCC_SC_SIGNAL_GP_H_
 #define _SCC_SC_SIGNAL_GP_H_
 
+#include "observer.h"
 #include <sysc/communication/sc_signal.h>
 #include <tlm>
+#include <vector>
 /** \ingroup scc-sysc
  *  @{
  */
@@ -29,6 +31,9 @@ namespace scc {
  * @class sc_owning_signal
  * @brief sc_signal which takes ownership of the data (acquire()/release())
  *
+ * When traced the occupancy of the signal (holding a non-null value) is recorded. If the trace file is an observer
+ * the value is pushed upon update instead of being compared in every cycle.
+ *
  * @tparam T
  * @tparam POL
  */
@@ -46,10 +51,21 @@ public: // constructors and destructor:
     : sc_core::sc_signal<T*, POL>(name_, nullptr) {}
 
     sc_owning_signal(const char* name_, T* initial_value_)
-    : sc_core::sc_signal<T*, POL>(name_, initial_value_) {}
+    : sc_core::sc_signal<T*, POL>(name_, initial_value_)
+    , occupied(initial_value_ != nullptr) {}
 
     virtual ~sc_owning_signal() {}
 
+    const char* kind() const override { return "sc_owning_signal"; }
+
+    void trace(sc_core::sc_trace_file* tf) const override {
+        if(auto* obs = dynamic_cast<observer*>(tf)) {
+            if(auto* h = observe(obs, occupied, super::name()))
+                hndl.push_back(h);
+        } else
+            sc_core::sc_trace(tf, occupied, super::name());
+    }
+
     // write the new value
     void write(const type& value_) override {
         bool value_changed = !(super::m_cur_val == value_);
@@ -80,8 +96,16 @@ protected:
             if(super::m_cur_val && super::m_cur_val->has_mm())
                 super::m_cur_val->release();
             super::update();
+            if(occupied != (super::m_cur_val != nullptr)) {
+                occupied = super::m_cur_val != nullptr;
+                notify_observers(hndl);
+            }
         }
     }
+
+private:
+    bool occupied{false};
+    mutable std::vector<observer::notification_handle*> hndl;
 };
 
 } // namespace scc
@@ -148,15 +148,13 @@ template <typename T> struct sc_variable : public sc_variable_b {
     // assignment operator overload
     sc_variable& operator=(T other) {
         value = other;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return *this;
     }
 
     sc_variable& operator=(const sc_variable<T>& other) {
         value = other.value;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return *this;
     }
     /**
@@ -198,8 +196,7 @@ template <typename T> struct sc_variable : public sc_variable_b {
     //! overloaded prefix ++ operator
     sc_variable& operator++() {
         ++value; // increment this object
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return *this;
     }
 
@@ -207,15 +204,13 @@ template <typename T> struct sc_variable : public sc_variable_b {
     T operator++(int) {
         auto orig = value;
         ++value;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return orig;
     }
     //! overloaded prefix -- operator
     sc_variable& operator--() {
         --value; // increment this object
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return *this;
     }
 
@@ -223,34 +218,29 @@ template <typename T> struct sc_variable : public sc_variable_b {
     T operator--(int) {
         auto orig = value;
         --value;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return orig;
     }
 
     //" arithmetic operator overloads
     T operator+=(const T other) {
         value += other;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return value;
     }
     T operator-=(const T other) {
         value -= other;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return value;
     }
     T operator*=(const T other) {
         value *= other;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return value;
     }
     T operator/=(const T other) {
         value /= other;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return value;
     }
     T operator+(const T other) const { return value - other; }
@@ -324,14 +314,12 @@ template <> struct sc_variable<bool> : public sc_variable_b {
     operator bool() const { return value; }
     sc_variable& operator=(const bool other) {
         value = other;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return *this;
     }
     sc_variable& operator=(const sc_variable<bool>& other) {
         value = other.value;
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
         return *this;
     }
     bool operator==(bool other) const { return value == other; }
@@ -493,8 +481,7 @@ template <typename T> struct sc_ref_variable : public sc_variable_b {
     void trace(observer* obs) const override { hndl.push_back(observe(obs, value, name())); }
 
     void notify() const {
-        for(auto h : hndl)
-            h->notify();
+        notify_observers(hndl);
     }
 
 private:
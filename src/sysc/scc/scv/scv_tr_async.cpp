@@ -0,0 +1,538 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#include "scv_tr_async.h"
+#include "scv_tr_schema.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <util/spsc_ring.h>
+// clang-format off
+#ifndef HAS_SCV
+namespace scv_tr {
+#endif
+// clang-format on
+// ----------------------------------------------------------------------------
+using namespace std;
+using event_type = scv_tr_async_sink::event_type;
+using data_type = scv_tr_async_sink::data_type;
+// ----------------------------------------------------------------------------
+namespace {
+enum record_kind : uint8_t { STRING_DEF, STREAM, GENERATOR, TX_BEGIN, TX_END, ATTR_STRING, ATTR_INT, ATTR_UINT, ATTR_BOOL, ATTR_DOUBLE, RELATION };
+/*
+ * Each record is prefixed by its length as varint followed by the record kind and the fields of the record. Integers
+ * are written as varints, names are replaced by the id of a preceding STRING_DEF record. Since records are only
+ * decoded once they are complete, the simulation thread may write them in pieces if the ring buffer is full.
+ */
+struct record_reader {
+    uint8_t const* p;
+    uint8_t const* end;
+    uint64_t get() {
+        uint64_t v = 0;
+        for(unsigned shift = 0; p < end; shift += 7) {
+            auto b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if(!(b & 0x80))
+                return v;
+        }
+        throw std::runtime_error("Truncated transaction record");
+    }
+    uint8_t get_byte() {
+        if(p == end)
+            throw std::runtime_error("Truncated transaction record");
+        return *p++;
+    }
+    std::string get_string() {
+        auto len = get();
+        if(static_cast<uint64_t>(end - p) < len)
+            throw std::runtime_error("Truncated transaction record");
+        std::string ret(reinterpret_cast<char const*>(p), len);
+        p += len;
+        return ret;
+    }
+    double get_double() {
+        auto raw = get();
+        double v;
+        memcpy(&v, &raw, sizeof(v));
+        return v;
+    }
+};
+
+class async_db {
+public:
+    static async_db& get() {
+        static async_db db;
+        return db;
+    }
+
+    std::unique_ptr<scv_tr_async_sink> sink;
+    size_t buffer_size{4 * 1024 * 1024};
+    bool active{false};
+
+    bool open(std::string const& name) {
+        if(!sink || !sink->open(name))
+            return false;
+        ring.reset(new util::spsc_ring(buffer_size));
+        strings.clear();
+        string_ids.clear();
+        write_errors = 0;
+        stop.store(false, std::memory_order_release);
+        worker = std::thread([this]() { run(); });
+        active = true;
+        return true;
+    }
+
+    void close() {
+        if(!active)
+            return;
+        active = false;
+        stop.store(true, std::memory_order_release);
+        cv.notify_one();
+        worker.join();
+        sink->close();
+        if(write_errors) {
+            std::array<char, 100> tmpString;
+            snprintf(tmpString.data(), tmpString.size(), "Could not write %llu transaction records",
+                     static_cast<unsigned long long>(write_errors));
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
+        }
+    }
+    //! returns the id of the string, emits a STRING_DEF record at first use
+    uint64_t intern(std::string const& str) {
+        auto it = string_ids.find(str);
+        if(it != string_ids.end())
+            return it->second;
+        auto id = string_ids.size();
+        string_ids.emplace(str, id);
+        start(STRING_DEF);
+        put(id);
+        put_string(str);
+        finish();
+        return id;
+    }
+    uint64_t intern(char const* str) { return intern(std::string(str ? str : "")); }
+
+    void start(record_kind kind) {
+        rec.clear();
+        rec.push_back(kind);
+    }
+    void put(uint64_t v) {
+        while(v >= 0x80) {
+            rec.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        rec.push_back(static_cast<uint8_t>(v));
+    }
+    void put_byte(uint8_t v) { rec.push_back(v); }
+    void put_string(std::string const& str) {
+        put(static_cast<uint64_t>(str.size()));
+        rec.insert(rec.end(), str.begin(), str.end());
+    }
+    void put_double(double v) {
+        uint64_t raw;
+        memcpy(&raw, &v, sizeof(v));
+        put(raw);
+    }
+    void finish() {
+        uint8_t hdr[10];
+        size_t hdr_len = 0;
+        for(auto len = rec.size(); hdr_len == 0 || len; len >>= 7)
+            hdr[hdr_len++] = static_cast<uint8_t>(len >= 0x80 ? (len & 0x7f) | 0x80 : len);
+        push(hdr, hdr_len);
+        push(rec.data(), rec.size());
+        if(ring->size() > ring->capacity() / 2)
+            cv.notify_one();
+    }
+
+private:
+    void push(uint8_t const* data, size_t len) {
+        while(len) {
+            auto n = ring->write(data, len);
+            data += n;
+            len -= n;
+            if(len) {
+                cv.notify_one();
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void run() {
+        std::vector<uint8_t> pending;
+        std::vector<uint8_t> chunk(64 * 1024);
+        while(true) {
+            auto n = ring->read(chunk.data(), chunk.size());
+            if(n) {
+                pending.insert(pending.end(), chunk.begin(), chunk.begin() + n);
+                auto used = decode(pending.data(), pending.data() + pending.size());
+                pending.erase(pending.begin(), pending.begin() + used);
+            } else if(stop.load(std::memory_order_acquire)) {
+                if(ring->size() == 0)
+                    break;
+            } else {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        }
+    }
+    //! decodes all complete records and returns the number of bytes consumed
+    size_t decode(uint8_t const* begin, uint8_t const* end) {
+        auto p = begin;
+        while(p < end) {
+            uint64_t len = 0;
+            auto q = p;
+            for(unsigned shift = 0; q < end; shift += 7) {
+                auto b = *q++;
+                len |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if(!(b & 0x80))
+                    break;
+                if(q == end)
+                    return p - begin;
+            }
+            if(static_cast<uint64_t>(end - q) < len)
+                break;
+            try {
+                dispatch(record_reader{q, q + len});
+            } catch(std::exception& e) {
+                ++write_errors;
+            }
+            p = q + len;
+        }
+        return p - begin;
+    }
+
+    void dispatch(record_reader rd) {
+        auto kind = rd.get_byte();
+        switch(kind) {
+        case STRING_DEF: {
+            auto id = rd.get();
+            strings.resize(std::max<size_t>(strings.size(), id + 1));
+            strings[id] = rd.get_string();
+        } break;
+        case STREAM: {
+            auto id = rd.get();
+            auto& name = str(rd.get());
+            sink->writeStream(id, name, str(rd.get()));
+        } break;
+        case GENERATOR: {
+            auto id = rd.get();
+            auto& name = str(rd.get());
+            auto stream = rd.get();
+            std::vector<scv_tr_async_sink::attr_desc> attrs(rd.get());
+            for(auto& a : attrs) {
+                a.evt = static_cast<event_type>(rd.get_byte());
+                a.type = static_cast<data_type>(rd.get_byte());
+                a.name = str(rd.get());
+            }
+            sink->writeGenerator(id, name, stream, attrs);
+        } break;
+        case TX_BEGIN:
+        case TX_END: {
+            auto id = rd.get();
+            auto gen = rd.get();
+            auto stream = rd.get();
+            auto time = rd.get();
+            if(kind == TX_BEGIN)
+                sink->beginTransaction(id, gen, stream, time);
+            else
+                sink->endTransaction(id, gen, stream, time);
+        } break;
+        case ATTR_STRING:
+        case ATTR_INT:
+        case ATTR_UINT:
+        case ATTR_BOOL:
+        case ATTR_DOUBLE: {
+            auto id = rd.get();
+            auto evt = static_cast<event_type>(rd.get_byte());
+            auto& name = str(rd.get());
+            auto type = static_cast<data_type>(rd.get_byte());
+            switch(kind) {
+            case ATTR_STRING:
+                sink->writeAttribute(id, evt, name, type, rd.get_string());
+                break;
+            case ATTR_INT: {
+                auto v = rd.get();
+                sink->writeAttribute(id, evt, name, type, static_cast<int64_t>((v >> 1) ^ (~(v & 1) + 1)));
+            } break;
+            case ATTR_UINT:
+                sink->writeAttribute(id, evt, name, type, rd.get());
+                break;
+            case ATTR_BOOL:
+                sink->writeAttribute(id, evt, name, type, rd.get_byte() != 0);
+                break;
+            default:
+                sink->writeAttribute(id, evt, name, type, rd.get_double());
+            }
+        } break;
+        case RELATION: {
+            auto& name = str(rd.get());
+            auto s1 = rd.get();
+            auto t1 = rd.get();
+            auto s2 = rd.get();
+            sink->writeRelation(name, s1, t1, s2, rd.get());
+        } break;
+        default:
+            throw std::runtime_error("Unknown transaction record");
+        }
+    }
+
+    std::string const& str(uint64_t id) const {
+        if(id >= strings.size())
+            throw std::runtime_error("Unknown string id in transaction record");
+        return strings[id];
+    }
+
+    // simulation thread side
+    std::unordered_map<std::string, uint64_t> string_ids;
+    std::vector<uint8_t> rec;
+    // background thread side
+    std::vector<std::string> strings;
+    uint64_t write_errors{0};
+    // shared
+    std::unique_ptr<util::spsc_ring> ring;
+    std::thread worker;
+    std::atomic<bool> stop{false};
+    std::mutex mtx;
+    std::condition_variable cv;
+};
+//! the attribute schemas, the per attribute data is the id of the attribute name
+scv_tr_schema_cache<> schemas([](scv_tr_schema_cache<>::attribute& attr) { attr.data = async_db::get().intern(attr.name); });
+// ----------------------------------------------------------------------------
+inline bool is_recording(const scv_tr_stream& s) {
+    auto txdb = s.get_scv_tr_db();
+    return async_db::get().active && txdb && txdb->get_recording();
+}
+// ----------------------------------------------------------------------------
+void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
+    // This is called from the scv_tr_db ctor.
+    static string fName("DEFAULT_scv_tr_async");
+    switch(reason) {
+    case scv_tr_db::CREATE:
+        if((_scv_tr_db.get_name() != nullptr) && (strlen(_scv_tr_db.get_name()) != 0))
+            fName = _scv_tr_db.get_name();
+        try {
+            if(!async_db::get().open(fName))
+                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't open recording file");
+        } catch(...) {
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't open recording file");
+        }
+        break;
+    case scv_tr_db::DELETE:
+        try {
+            async_db::get().close();
+            schemas.clear();
+        } catch(...) {
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
+        }
+        break;
+    default:
+        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Unknown reason in scv_tr_db callback");
+    }
+}
+// ----------------------------------------------------------------------------
+void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, void* data) {
+    auto& db = async_db::get();
+    if(db.active && reason == scv_tr_stream::CREATE) {
+        auto name = db.intern(s.get_name());
+        auto kind = db.intern(s.get_stream_kind());
+        db.start(STREAM);
+        db.put(s.get_id());
+        db.put(name);
+        db.put(kind);
+        db.finish();
+    }
+}
+// ----------------------------------------------------------------------------
+inline void startAttribute(async_db& db, record_kind kind, uint64_t id, event_type event, uint64_t name_id, data_type type) {
+    db.start(kind);
+    db.put(id);
+    db.put_byte(event);
+    db.put(name_id);
+    db.put_byte(type);
+}
+// ----------------------------------------------------------------------------
+void recordAttributes(uint64_t id, event_type eventType, scv_tr_schema<>& schema, const scv_extensions_if* my_exts_p) {
+    auto& db = async_db::get();
+    for(auto& attr : schema.attributes()) {
+        auto* leaf_p = scv_tr_schema<>::leaf(my_exts_p, attr);
+        if(!leaf_p)
+            continue;
+        auto name = attr.data;
+        switch(attr.type) {
+        case scv_extensions_if::ENUMERATION:
+            startAttribute(db, ATTR_STRING, id, eventType, name, scv_extensions_if::ENUMERATION);
+            db.put_string(leaf_p->get_enum_string((int)(leaf_p->get_integer())));
+            db.finish();
+            break;
+        case scv_extensions_if::BOOLEAN:
+            startAttribute(db, ATTR_BOOL, id, eventType, name, scv_extensions_if::BOOLEAN);
+            db.put_byte(leaf_p->get_bool() ? 1 : 0);
+            db.finish();
+            break;
+        case scv_extensions_if::INTEGER:
+        case scv_extensions_if::FIXED_POINT_INTEGER: {
+            auto v = static_cast<int64_t>(leaf_p->get_integer());
+            startAttribute(db, ATTR_INT, id, eventType, name, scv_extensions_if::INTEGER);
+            db.put((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+            db.finish();
+        } break;
+        case scv_extensions_if::UNSIGNED:
+            startAttribute(db, ATTR_UINT, id, eventType, name, scv_extensions_if::UNSIGNED);
+            db.put(static_cast<uint64_t>(leaf_p->get_unsigned()));
+            db.finish();
+            break;
+        case scv_extensions_if::POINTER:
+            startAttribute(db, ATTR_UINT, id, eventType, name, scv_extensions_if::POINTER);
+            db.put(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(leaf_p->get_pointer())));
+            db.finish();
+            break;
+        case scv_extensions_if::STRING:
+            startAttribute(db, ATTR_STRING, id, eventType, name, scv_extensions_if::STRING);
+            db.put_string(leaf_p->get_string());
+            db.finish();
+            break;
+        case scv_extensions_if::FLOATING_POINT_NUMBER:
+            startAttribute(db, ATTR_DOUBLE, id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER);
+            db.put_double(leaf_p->get_double());
+            db.finish();
+            break;
+        case scv_extensions_if::BIT_VECTOR: {
+            sc_bv_base tmp_bv(leaf_p->get_bitwidth());
+            leaf_p->get_value(tmp_bv);
+            startAttribute(db, ATTR_STRING, id, eventType, name, scv_extensions_if::BIT_VECTOR);
+            db.put_string(tmp_bv.to_string());
+            db.finish();
+        } break;
+        case scv_extensions_if::LOGIC_VECTOR: {
+            sc_lv_base tmp_lv(leaf_p->get_bitwidth());
+            leaf_p->get_value(tmp_lv);
+            startAttribute(db, ATTR_STRING, id, eventType, name, scv_extensions_if::LOGIC_VECTOR);
+            db.put_string(tmp_lv.to_string());
+            db.finish();
+        } break;
+        default: {
+            std::array<char, 100> tmpString;
+            sprintf(tmpString.data(), "Unsupported attribute type = %d", attr.type);
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
+        }
+        }
+    }
+}
+// ----------------------------------------------------------------------------
+void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
+    auto& db = async_db::get();
+    if(db.active && reason == scv_tr_generator_base::CREATE) {
+        std::vector<std::array<uint64_t, 3>> attrs;
+        if(auto* my_begin_exts_p = g.get_begin_exts_p())
+            attrs.push_back({{scv_tr_async_sink::BEGIN, static_cast<uint64_t>(my_begin_exts_p->get_type()),
+                              db.intern(g.get_begin_attribute_name())}});
+        if(auto* my_end_exts_p = g.get_end_exts_p())
+            attrs.push_back(
+                {{scv_tr_async_sink::END, static_cast<uint64_t>(my_end_exts_p->get_type()), db.intern(g.get_end_attribute_name())}});
+        auto name = db.intern(g.get_name());
+        db.start(GENERATOR);
+        db.put(g.get_id());
+        db.put(name);
+        db.put(g.get_scv_tr_stream().get_id());
+        db.put(static_cast<uint64_t>(attrs.size()));
+        for(auto& a : attrs) {
+            db.put_byte(static_cast<uint8_t>(a[0]));
+            db.put_byte(static_cast<uint8_t>(a[1]));
+            db.put(a[2]);
+        }
+        db.finish();
+    }
+}
+// ----------------------------------------------------------------------------
+void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason, void* data) {
+    if(!is_recording(t.get_scv_tr_stream()))
+        return;
+    auto& db = async_db::get();
+    uint64_t id = t.get_id();
+    auto& gen = t.get_scv_tr_generator_base();
+    switch(reason) {
+    case scv_tr_handle::BEGIN: {
+        db.start(TX_BEGIN);
+        db.put(id);
+        db.put(gen.get_id());
+        db.put(gen.get_scv_tr_stream().get_id());
+        db.put(static_cast<uint64_t>(t.get_begin_sc_time() / sc_core::sc_time(1, sc_core::SC_PS)));
+        db.finish();
+        auto my_exts_p = t.get_begin_exts_p();
+        if(my_exts_p == nullptr)
+            my_exts_p = gen.get_begin_exts_p();
+        if(my_exts_p)
+            recordAttributes(id, scv_tr_async_sink::BEGIN, schemas.get(gen, false, my_exts_p), my_exts_p);
+    } break;
+    case scv_tr_handle::END: {
+        auto my_exts_p = t.get_end_exts_p();
+        if(my_exts_p == nullptr)
+            my_exts_p = gen.get_end_exts_p();
+        if(my_exts_p)
+            recordAttributes(id, scv_tr_async_sink::END, schemas.get(gen, true, my_exts_p), my_exts_p);
+        db.start(TX_END);
+        db.put(id);
+        db.put(gen.get_id());
+        db.put(gen.get_scv_tr_stream().get_id());
+        db.put(static_cast<uint64_t>(t.get_end_sc_time() / sc_core::sc_time(1, sc_core::SC_PS)));
+        db.finish();
+    } break;
+    default:;
+    }
+}
+// ----------------------------------------------------------------------------
+void attributeCb(const scv_tr_handle& t, const char* name, const scv_extensions_if* ext, void* data) {
+    if(!is_recording(t.get_scv_tr_stream()))
+        return;
+    if(ext)
+        recordAttributes(t.get_id(), scv_tr_async_sink::RECORD, schemas.get(name, ext), ext);
+}
+// ----------------------------------------------------------------------------
+void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
+    auto& stream1 = tr_1.get_scv_tr_stream();
+    if(!is_recording(stream1))
+        return;
+    auto& db = async_db::get();
+    auto name = db.intern(stream1.get_scv_tr_db()->get_relation_name(relation_handle));
+    db.start(RELATION);
+    db.put(name);
+    db.put(stream1.get_id());
+    db.put(tr_1.get_id());
+    db.put(tr_2.get_scv_tr_stream().get_id());
+    db.put(tr_2.get_id());
+    db.finish();
+}
+} // namespace
+// ----------------------------------------------------------------------------
+void scv_tr_async_init(std::unique_ptr<scv_tr_async_sink>&& sink, size_t buffer_size) {
+    async_db::get().sink = std::move(sink);
+    async_db::get().buffer_size = buffer_size;
+    scv_tr_db::register_class_cb(dbCb);
+    scv_tr_stream::register_class_cb(streamCb);
+    scv_tr_generator_base::register_class_cb(generatorCb);
+    scv_tr_handle::register_class_cb(transactionCb);
+    scv_tr_handle::register_record_attribute_cb(attributeCb);
+    scv_tr_handle::register_relation_cb(relationCb);
+}
+// ----------------------------------------------------------------------------
+#ifndef HAS_SCV
+}
+#endif
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCC_SCV_TR_ASYNC_H_
+#define _SCC_SCV_TR_ASYNC_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+// clang-format off
+#ifdef HAS_SCV
+#include <scv.h>
+#else
+#include <scv-tr.h>
+namespace scv_tr {
+#endif
+// clang-format on
+/**
+ * @struct scv_tr_async_sink
+ * @brief the backend part of the asynchronous transaction recording
+ *
+ * The asynchronous front end registers the SCV callbacks, encodes all events into compact binary records with interned
+ * names and appends them to a lock-free ring buffer. A background thread decodes the records and calls the sink, so
+ * formatting, compression and I/O of the backend do not take place on the simulation thread. All functions except
+ * open() and close() are called from the background thread.
+ */
+struct scv_tr_async_sink {
+    enum event_type { BEGIN, RECORD, END };
+    using data_type = scv_extensions_if::data_type;
+    //! description of the begin and end attributes of a generator
+    struct attr_desc {
+        event_type evt;
+        data_type type;
+        std::string name;
+    };
+
+    virtual ~scv_tr_async_sink() = default;
+    //! open the database named name, called from the simulation thread
+    virtual bool open(std::string const& name) = 0;
+    //! close the database, called from the simulation thread after all records have been processed
+    virtual void close() = 0;
+
+    virtual void writeStream(uint64_t id, std::string const& name, std::string const& kind) = 0;
+
+    virtual void writeGenerator(uint64_t id, std::string const& name, uint64_t stream, std::vector<attr_desc> const& attributes) = 0;
+    //! begin of a transaction, the time is given in ps
+    virtual void beginTransaction(uint64_t id, uint64_t generator, uint64_t stream, uint64_t time) = 0;
+    //! end of a transaction, the time is given in ps
+    virtual void endTransaction(uint64_t id, uint64_t generator, uint64_t stream, uint64_t time) = 0;
+
+    virtual void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, std::string const& value) = 0;
+
+    virtual void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, int64_t value) = 0;
+
+    virtual void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, uint64_t value) = 0;
+
+    virtual void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, bool value) = 0;
+
+    virtual void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, double value) = 0;
+
+    virtual void writeRelation(std::string const& name, uint64_t stream_1, uint64_t tx_1, uint64_t stream_2, uint64_t tx_2) = 0;
+};
+/**
+ * @fn void scv_tr_async_init(std::unique_ptr<scv_tr_async_sink>&&, size_t)
+ * @brief initializes the infrastructure to record transactions asynchronously into the given sink
+ *
+ * @param sink the backend receiving the decoded events
+ * @param buffer_size the size of the ring buffer between simulation and background thread in bytes. If it is full
+ * the simulation thread waits for the background thread.
+ */
+void scv_tr_async_init(std::unique_ptr<scv_tr_async_sink>&& sink, size_t buffer_size = 4 * 1024 * 1024);
+
+#ifndef HAS_SCV
+}
+#endif
+#endif /* _SCC_SCV_TR_ASYNC_H_ */
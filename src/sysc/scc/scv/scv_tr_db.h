@@ -16,6 +16,7 @@
 
 #ifndef _SCC_SCV_TR_DB_H_
 #define _SCC_SCV_TR_DB_H_
+#include <systemc>
 #ifndef HAS_SCV
 namespace scv_tr {
 #endif
@@ -35,41 +36,53 @@ void scv_tr_sqlite_init();
  */
 void scv_tr_compressed_init();
 /**
- * @fn void scv_tr_plain_init()
+ * @fn void scv_tr_plain_init(bool)
  * @brief initializes the infrastructure to use a plain text based transaction recording database
  *
- * TODO: add a multithreaded writer
- *
+ * @param async if true the formatting and writing is done in a background thread, see scv_tr_async_init()
  */
-void scv_tr_plain_init();
+void scv_tr_plain_init(bool async = false);
 /**
- * @fn void scv_tr_lz4_init()
+ * @fn void scv_tr_lz4_init(bool)
  * @brief initializes the infrastructure to use a LZ4 compressed text based transaction recording database
  *
- * TODO: add a multithreaded writer
- *
+ * @param async if true the formatting, compression and writing is done in a background thread, see scv_tr_async_init()
  */
-void scv_tr_lz4_init();
+void scv_tr_lz4_init(bool async = false);
 /**
- * @fn void scv_tr_mtc_init()
- * @brief initializes the infrastructure to use a compressed text based transaction recording database with a
- * multithreaded writer
+ * @fn void scv_tr_ftr_init(bool, bool, const sc_core::sc_time&, uint64_t)
+ * @brief initializes the infrastructure to use a FTR (CBOR based) transaction recording database
  *
+ * @param compressed if true the data chunks are compressed
+ * @param async if true the encoding and writing is done in a background thread, see scv_tr_async_init()
+ * @param chunk_time if larger than 0 the database is written as numbered, self-contained chunks (name.0.ftr,
+ * name.1.ftr, ...) each covering the given span of simulated time, and the index file name.ftr.idx lists the finished
+ * chunks. Each transaction is stored in the chunk it ends in. Chunked databases are always written asynchronously.
+ * @param chunk_size if larger than 0 a new chunk is started as soon as the current one exceeds the given number of bytes
  */
-void scv_tr_ftr_init(bool compressed);
+void scv_tr_ftr_init(bool compressed, bool async = false, sc_core::sc_time const& chunk_time = sc_core::SC_ZERO_TIME,
+                     uint64_t chunk_size = 0);
 /**
  * @fn void scv_tr_mtc_init()
- * @brief initializes the infrastructure to use a compressed text based transaction recording database with a
+ * @brief initializes the infrastructure to use a compressed binary transaction recording database with a
  * multithreaded writer
  *
+ * The records are collected per stream, full blocks are LZ4 compressed on a pool of worker threads and indexed by
+ * stream and time at the end of the file. Each block is preceded by its index entry so that the file stays readable if
+ * the simulation terminates abnormally. The file layout is described in util/scv_mtc_format.h, util::scv_mtc_reader
+ * reads it and the tool txmtc2ftr converts it into FTR.
  */
 void scv_tr_mtc_init();
-
-#ifdef USE_EXTENDED_DB
 /**
- * initializes the infrastructure to use a binary transaction recording database
+ * @fn void scv_tr_binary_init()
+ * @brief initializes the infrastructure to use a binary transaction recording database
+ *
+ * The database is a directory of memory mapped, append-only files including a timing index. It can be accessed
+ * using util::scv_binary_reader and converted to FTR with the txbin2ftr tool. Available on POSIX systems only.
  */
 void scv_tr_binary_init();
+
+#ifdef USE_EXTENDED_DB
 /**
  * initializes the infrastructure to use a LevelDB based transaction recording database
  */
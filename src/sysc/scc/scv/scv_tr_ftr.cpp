@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include "scv_tr_async.h"
+#include "scv_tr_schema.h"
 #include <array>
 #include <boost/filesystem.hpp>
 #include <cmath>
@@ -22,9 +24,12 @@
 #include <fstream>
 #include <ftr/ftr_writer.h>
 #include <iostream>
+#include <scc/trace/chunk_index.hh>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -43,6 +48,7 @@ using namespace ftr;
 namespace {
 template <bool COMPRESSED> struct tx_db {
     static ftr_writer<COMPRESSED>* db;
+    static scv_tr_schema_cache<> schemas;
     static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
         // This is called from the scv_tr_db ctor.
         static string fName("DEFAULT_scv_tr_cbor");
@@ -70,6 +76,8 @@ template <bool COMPRESSED> struct tx_db {
             } catch(...) {
                 _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
             }
+            db = nullptr;
+            schemas.clear();
             break;
         default:
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Unknown reason in scv_tr_db callback");
@@ -114,76 +122,53 @@ template <bool COMPRESSED> struct tx_db {
             }
     }
     // ----------------------------------------------------------------------------
-    static inline std::string get_name(const char* prefix, const scv_extensions_if* my_exts_p) {
-        string name{prefix};
-        if(!prefix || strlen(prefix) == 0) {
-            name = my_exts_p->get_name();
-        } else {
-            if((my_exts_p->get_name() != nullptr) && (strlen(my_exts_p->get_name()) > 0)) {
-                name += ".";
-                name += my_exts_p->get_name();
-            }
-        }
-        return (name == "") ? "<unnamed>" : name;
-    }
-    // ----------------------------------------------------------------------------
-    static void recordAttributes(uint64_t id, event_type eventType, char const* prefix, const scv_extensions_if* my_exts_p) {
+    static void recordAttributes(uint64_t id, event_type eventType, scv_tr_schema<>& schema, const scv_extensions_if* my_exts_p) {
         if(!db || my_exts_p == nullptr)
             return;
-        auto name = get_name(prefix, my_exts_p);
-        switch(my_exts_p->get_type()) {
-        case scv_extensions_if::RECORD: {
-            int num_fields = my_exts_p->get_num_fields();
-            if(num_fields > 0) {
-                for(int field_counter = 0; field_counter < num_fields; field_counter++) {
-                    const scv_extensions_if* field_data_p = my_exts_p->get_field(field_counter);
-                    recordAttributes(id, eventType, prefix, field_data_p);
-                }
+        for(auto& attr : schema.attributes()) {
+            auto* leaf_p = scv_tr_schema<>::leaf(my_exts_p, attr);
+            if(!leaf_p)
+                continue;
+            auto const& name = attr.name;
+            switch(attr.type) {
+            case scv_extensions_if::ENUMERATION:
+                recordAttribute(id, eventType, name, ftr::data_type::ENUMERATION, leaf_p->get_enum_string((int)(leaf_p->get_integer())));
+                break;
+            case scv_extensions_if::BOOLEAN:
+                recordAttribute(id, eventType, name, ftr::data_type::BOOLEAN, leaf_p->get_bool());
+                break;
+            case scv_extensions_if::INTEGER:
+            case scv_extensions_if::FIXED_POINT_INTEGER:
+                recordAttribute(id, eventType, name, ftr::data_type::INTEGER, leaf_p->get_integer());
+                break;
+            case scv_extensions_if::UNSIGNED:
+                recordAttribute(id, eventType, name, ftr::data_type::UNSIGNED, leaf_p->get_integer());
+                break;
+            case scv_extensions_if::POINTER:
+                recordAttribute(id, eventType, name, ftr::data_type::POINTER, (long long)leaf_p->get_pointer());
+                break;
+            case scv_extensions_if::STRING:
+                recordAttribute(id, eventType, name, ftr::data_type::STRING, leaf_p->get_string());
+                break;
+            case scv_extensions_if::FLOATING_POINT_NUMBER:
+                recordAttribute(id, eventType, name, ftr::data_type::FLOATING_POINT_NUMBER, leaf_p->get_double());
+                break;
+            case scv_extensions_if::BIT_VECTOR: {
+                sc_bv_base tmp_bv(leaf_p->get_bitwidth());
+                leaf_p->get_value(tmp_bv);
+                recordAttribute(id, eventType, name, ftr::data_type::BIT_VECTOR, tmp_bv.to_string());
+            } break;
+            case scv_extensions_if::LOGIC_VECTOR: {
+                sc_lv_base tmp_lv(leaf_p->get_bitwidth());
+                leaf_p->get_value(tmp_lv);
+                recordAttribute(id, eventType, name, ftr::data_type::LOGIC_VECTOR, tmp_lv.to_string());
+            } break;
+            default: {
+                std::array<char, 100> tmpString;
+                sprintf(tmpString.data(), "Unsupported attribute type = %d", attr.type);
+                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
             }
-        } break;
-        case scv_extensions_if::ENUMERATION:
-            recordAttribute(id, eventType, name, ftr::data_type::ENUMERATION, my_exts_p->get_enum_string((int)(my_exts_p->get_integer())));
-            break;
-        case scv_extensions_if::BOOLEAN:
-            recordAttribute(id, eventType, name, ftr::data_type::BOOLEAN, my_exts_p->get_bool());
-            break;
-        case scv_extensions_if::INTEGER:
-        case scv_extensions_if::FIXED_POINT_INTEGER:
-            recordAttribute(id, eventType, name, ftr::data_type::INTEGER, my_exts_p->get_integer());
-            break;
-        case scv_extensions_if::UNSIGNED:
-            recordAttribute(id, eventType, name, ftr::data_type::UNSIGNED, my_exts_p->get_integer());
-            break;
-        case scv_extensions_if::POINTER:
-            recordAttribute(id, eventType, name, ftr::data_type::POINTER, (long long)my_exts_p->get_pointer());
-            break;
-        case scv_extensions_if::STRING:
-            recordAttribute(id, eventType, name, ftr::data_type::STRING, my_exts_p->get_string());
-            break;
-        case scv_extensions_if::FLOATING_POINT_NUMBER:
-            recordAttribute(id, eventType, name, ftr::data_type::FLOATING_POINT_NUMBER, my_exts_p->get_double());
-            break;
-        case scv_extensions_if::BIT_VECTOR: {
-            sc_bv_base tmp_bv(my_exts_p->get_bitwidth());
-            my_exts_p->get_value(tmp_bv);
-            recordAttribute(id, eventType, name, ftr::data_type::BIT_VECTOR, tmp_bv.to_string());
-        } break;
-        case scv_extensions_if::LOGIC_VECTOR: {
-            sc_lv_base tmp_lv(my_exts_p->get_bitwidth());
-            my_exts_p->get_value(tmp_lv);
-            recordAttribute(id, eventType, name, ftr::data_type::LOGIC_VECTOR, tmp_lv.to_string());
-        } break;
-        case scv_extensions_if::ARRAY:
-            for(int array_elt_index = 0; array_elt_index < my_exts_p->get_array_size(); array_elt_index++) {
-                const scv_extensions_if* field_data_p = my_exts_p->get_array_elt(array_elt_index);
-                recordAttributes(id, eventType, prefix, field_data_p);
             }
-            break;
-        default: {
-            std::array<char, 100> tmpString;
-            sprintf(tmpString.data(), "Unsupported attribute type = %d", my_exts_p->get_type());
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
-        }
         }
     }
     // ----------------------------------------------------------------------------
@@ -209,22 +194,15 @@ template <bool COMPRESSED> struct tx_db {
             auto my_exts_p = t.get_begin_exts_p();
             if(my_exts_p == nullptr)
                 my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
-            if(my_exts_p) {
-                auto tmp_str = t.get_scv_tr_generator_base().get_begin_attribute_name()
-                                   ? t.get_scv_tr_generator_base().get_begin_attribute_name()
-                                   : "";
-                recordAttributes(id, event_type::BEGIN, tmp_str, my_exts_p);
-            }
+            if(my_exts_p)
+                recordAttributes(id, event_type::BEGIN, schemas.get(t.get_scv_tr_generator_base(), false, my_exts_p), my_exts_p);
         } break;
         case scv_tr_handle::END: {
             auto my_exts_p = t.get_end_exts_p();
             if(my_exts_p == nullptr)
                 my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
-            if(my_exts_p) {
-                auto tmp_str =
-                    t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-                recordAttributes(id, event_type::END, tmp_str, my_exts_p);
-            }
+            if(my_exts_p)
+                recordAttributes(id, event_type::END, schemas.get(t.get_scv_tr_generator_base(), true, my_exts_p), my_exts_p);
             db->endTransaction(id, t.get_end_sc_time() / sc_core::sc_time(1, sc_core::SC_PS));
         } break;
         default:;
@@ -234,7 +212,8 @@ template <bool COMPRESSED> struct tx_db {
     static void attributeCb(const scv_tr_handle& t, const char* name, const scv_extensions_if* ext, void* data) {
         if(!db || !t.get_scv_tr_stream().get_scv_tr_db() || !t.get_scv_tr_stream().get_scv_tr_db()->get_recording())
             return;
-        recordAttributes(t.get_id(), event_type::RECORD, name == nullptr ? "" : name, ext);
+        if(ext)
+            recordAttributes(t.get_id(), event_type::RECORD, schemas.get(name, ext), ext);
     }
     // ----------------------------------------------------------------------------
     static void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
@@ -251,10 +230,331 @@ template <bool COMPRESSED> struct tx_db {
     }
 };
 template <bool COMPRESSED> ftr_writer<COMPRESSED>* tx_db<COMPRESSED>::db{nullptr};
+template <bool COMPRESSED> scv_tr_schema_cache<> tx_db<COMPRESSED>::schemas;
+// ----------------------------------------------------------------------------
+template <bool COMPRESSED> struct async_sink : public scv_tr_async_sink {
+    std::unique_ptr<ftr_writer<COMPRESSED>> db;
+
+    static ftr::event_type to_event(scv_tr_async_sink::event_type event) {
+        switch(event) {
+        case scv_tr_async_sink::BEGIN:
+            return ftr::event_type::BEGIN;
+        case scv_tr_async_sink::END:
+            return ftr::event_type::END;
+        default:
+            return ftr::event_type::RECORD;
+        }
+    }
+
+    static ftr::data_type to_type(data_type type) {
+        switch(type) {
+        case scv_extensions_if::ENUMERATION:
+            return ftr::data_type::ENUMERATION;
+        case scv_extensions_if::BOOLEAN:
+            return ftr::data_type::BOOLEAN;
+        case scv_extensions_if::UNSIGNED:
+            return ftr::data_type::UNSIGNED;
+        case scv_extensions_if::POINTER:
+            return ftr::data_type::POINTER;
+        case scv_extensions_if::STRING:
+            return ftr::data_type::STRING;
+        case scv_extensions_if::FLOATING_POINT_NUMBER:
+            return ftr::data_type::FLOATING_POINT_NUMBER;
+        case scv_extensions_if::BIT_VECTOR:
+            return ftr::data_type::BIT_VECTOR;
+        case scv_extensions_if::LOGIC_VECTOR:
+            return ftr::data_type::LOGIC_VECTOR;
+        default:
+            return ftr::data_type::INTEGER;
+        }
+    }
+
+    bool open(std::string const& name) override { return open_file(name + ".ftr"); }
+
+    bool open_file(std::string const& file_name) {
+        db.reset(new ftr_writer<COMPRESSED>(file_name));
+        if(!db->cw.enc.ofs.is_open()) {
+            db.reset();
+            return false;
+        }
+        double secs = sc_core::sc_time::from_value(1ULL).to_seconds();
+        auto exp = rint(log(secs) / log(10.0));
+        db->writeInfo(static_cast<int8_t>(exp));
+        return true;
+    }
+
+    void close() override { db.reset(); }
+
+    void writeStream(uint64_t id, std::string const& name, std::string const& kind) override { db->writeStream(id, name, kind); }
+
+    void writeGenerator(uint64_t id, std::string const& name, uint64_t stream, std::vector<attr_desc> const& attributes) override {
+        db->writeGenerator(id, name, stream);
+    }
+
+    void beginTransaction(uint64_t id, uint64_t generator, uint64_t stream, uint64_t time) override {
+        db->startTransaction(id, generator, stream, time);
+    }
+
+    void endTransaction(uint64_t id, uint64_t generator, uint64_t stream, uint64_t time) override { db->endTransaction(id, time); }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, std::string const& value) override {
+        db->writeAttribute(id, to_event(event), name, to_type(type), value);
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, int64_t value) override {
+        db->writeAttribute(id, to_event(event), name, to_type(type), static_cast<long long>(value));
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, uint64_t value) override {
+        db->writeAttribute(id, to_event(event), name, to_type(type), static_cast<long long>(value));
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, bool value) override {
+        db->writeAttribute(id, to_event(event), name, to_type(type), value);
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, double value) override {
+        db->writeAttribute(id, to_event(event), name, to_type(type), value);
+    }
+
+    void writeRelation(std::string const& name, uint64_t stream_1, uint64_t tx_1, uint64_t stream_2, uint64_t tx_2) override {
+        db->writeRelation(name, stream_1, tx_1, stream_2, tx_2);
+    }
+};
+// ----------------------------------------------------------------------------
+/*
+ * A sink writing the database as sequence of self-contained chunks (name.0.ftr, name.1.ftr, ...) each covering a span
+ * of simulated time or a number of bytes. Finished chunks are listed in the index file name.ftr.idx so that a partially written database
+ * is usable even if the simulation does not terminate regularly. A transaction is written to the chunk in which it
+ * ends, until then its begin and its attributes are kept. Hence the memory needed depends on the number of outstanding
+ * transactions but not on the length of the simulation. Relations are recorded only if both transactions end in the
+ * same chunk. Closing a finished chunk, which flushes and compresses its last blocks, is done by a separate thread.
+ * The time range listed in the index covers the begin and end times of all transactions written to a chunk, so the
+ * ranges of neighbouring chunks overlap if transactions span a chunk boundary or arrive out of time order.
+ */
+template <bool COMPRESSED> struct chunked_sink : public async_sink<COMPRESSED> {
+    using event_type = scv_tr_async_sink::event_type;
+    using data_type = scv_tr_async_sink::data_type;
+    using attr_desc = scv_tr_async_sink::attr_desc;
+
+    struct attribute {
+        event_type event;
+        std::string name;
+        data_type type;
+        enum { STR, INT, UINT, BOOL, DBL } kind;
+        std::string str;
+        int64_t ival;
+        double dval;
+    };
+    struct transaction {
+        uint64_t generator, stream, time;
+        std::vector<attribute> attributes;
+    };
+    struct relation {
+        std::string name;
+        uint64_t stream_1, tx_1, stream_2, tx_2;
+    };
+
+    chunked_sink(sc_core::sc_time const& chunk_time, uint64_t chunk_size) {
+        rotation.max_time = chunk_time;
+        rotation.max_size = chunk_size;
+    }
+
+    ~chunked_sink() override {
+        if(closer.joinable())
+            closer.join();
+    }
+
+    bool open(std::string const& name) override {
+        chunks.reset(new scc::trace::chunk_index(name, "ftr", rotation));
+        return this->open_file(chunks->file_name());
+    }
+
+    void close() override {
+        if(this->db) {
+            // transactions not being finished are written with their begin only
+            for(auto& e : pending) {
+                chunks->cover(e.second.time);
+                writer().startTransaction(e.first, e.second.generator, e.second.stream, e.second.time);
+                write_attributes(e.first, e.second.attributes);
+                written.insert(e.first);
+            }
+            pending.clear();
+            write_relations();
+            retire();
+        }
+        chunks->finish(last_time);
+        if(closer.joinable())
+            closer.join();
+    }
+
+    void writeStream(uint64_t id, std::string const& name, std::string const& kind) override {
+        streams.emplace_back(id, name, kind);
+        writer().writeStream(id, name, kind);
+    }
+
+    void writeGenerator(uint64_t id, std::string const& name, uint64_t stream, std::vector<attr_desc> const& attributes) override {
+        generators.emplace_back(id, name, stream);
+        writer().writeGenerator(id, name, stream);
+    }
+
+    void beginTransaction(uint64_t id, uint64_t generator, uint64_t stream, uint64_t time) override {
+        advance(time);
+        auto& tx = pending[id];
+        tx.generator = generator;
+        tx.stream = stream;
+        tx.time = time;
+    }
+
+    void endTransaction(uint64_t id, uint64_t generator, uint64_t stream, uint64_t time) override {
+        advance(time);
+        auto it = pending.find(id);
+        if(it == pending.end())
+            return;
+        // the times might not be in order (e.g. the timed view of a recorder not using payload event queues), so the
+        // index lists the range of all times written to the chunk
+        chunks->cover(it->second.time);
+        chunks->cover(time);
+        writer().startTransaction(id, it->second.generator, it->second.stream, it->second.time);
+        write_attributes(id, it->second.attributes);
+        writer().endTransaction(id, time);
+        written.insert(id);
+        pending.erase(it);
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, std::string const& value) override {
+        if(auto* tx = find(id))
+            tx->attributes.push_back({event, name, type, attribute::STR, value, 0, 0.});
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, int64_t value) override {
+        if(auto* tx = find(id))
+            tx->attributes.push_back({event, name, type, attribute::INT, std::string(), value, 0.});
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, uint64_t value) override {
+        if(auto* tx = find(id))
+            tx->attributes.push_back({event, name, type, attribute::UINT, std::string(), static_cast<int64_t>(value), 0.});
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, bool value) override {
+        if(auto* tx = find(id))
+            tx->attributes.push_back({event, name, type, attribute::BOOL, std::string(), value, 0.});
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, double value) override {
+        if(auto* tx = find(id))
+            tx->attributes.push_back({event, name, type, attribute::DBL, std::string(), 0, value});
+    }
+
+    void writeRelation(std::string const& name, uint64_t stream_1, uint64_t tx_1, uint64_t stream_2, uint64_t tx_2) override {
+        relations.push_back({name, stream_1, tx_1, stream_2, tx_2});
+    }
+
+private:
+    ftr_writer<COMPRESSED>& writer() {
+        if(!this->db)
+            throw std::runtime_error("No open chunk of the recording database");
+        return *this->db;
+    }
+
+    transaction* find(uint64_t id) {
+        auto it = pending.find(id);
+        return it == pending.end() ? nullptr : &it->second;
+    }
+
+    void write_attributes(uint64_t id, std::vector<attribute> const& attributes) {
+        for(auto& a : attributes)
+            switch(a.kind) {
+            case attribute::STR:
+                async_sink<COMPRESSED>::writeAttribute(id, a.event, a.name, a.type, a.str);
+                break;
+            case attribute::UINT:
+                async_sink<COMPRESSED>::writeAttribute(id, a.event, a.name, a.type, static_cast<uint64_t>(a.ival));
+                break;
+            case attribute::BOOL:
+                async_sink<COMPRESSED>::writeAttribute(id, a.event, a.name, a.type, a.ival != 0);
+                break;
+            case attribute::DBL:
+                async_sink<COMPRESSED>::writeAttribute(id, a.event, a.name, a.type, a.dval);
+                break;
+            default:
+                async_sink<COMPRESSED>::writeAttribute(id, a.event, a.name, a.type, a.ival);
+            }
+    }
+    /*
+     * writes the relations whose transactions are both written to the current chunk, keeps the ones whose transactions
+     * are outstanding or in the current chunk and drops the ones referring to a transaction of a previous chunk
+     */
+    void write_relations() {
+        std::vector<relation> remaining;
+        for(auto& r : relations) {
+            auto written_1 = written.count(r.tx_1) != 0;
+            auto written_2 = written.count(r.tx_2) != 0;
+            if(written_1 && written_2)
+                writer().writeRelation(r.name, r.stream_1, r.tx_1, r.stream_2, r.tx_2);
+            else if((written_1 || pending.count(r.tx_1)) && (written_2 || pending.count(r.tx_2)))
+                remaining.push_back(std::move(r));
+        }
+        relations.swap(remaining);
+    }
+    //! the number of bytes written to the current chunk so far, only determined if the chunk size is limited
+    uint64_t chunk_size() {
+        if(!rotation.max_size)
+            return 0;
+        auto pos = writer().cw.enc.ofs.tellp();
+        return pos < 0 ? 0 : static_cast<uint64_t>(pos);
+    }
+
+    void advance(uint64_t time) {
+        if(time <= last_time)
+            return;
+        last_time = time;
+        if(chunks->needs_rotation(time, chunk_size())) {
+            write_relations();
+            written.clear();
+            retire();
+            chunks->rotate(time);
+            if(!this->open_file(chunks->file_name()))
+                throw std::runtime_error("Can't open recording file " + chunks->file_name());
+            for(auto& e : streams)
+                writer().writeStream(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+            for(auto& e : generators)
+                writer().writeGenerator(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+        }
+    }
+    //! hands the writer of the finished chunk over to the closing thread
+    void retire() {
+        if(closer.joinable())
+            closer.join();
+        closer = std::thread([](ftr_writer<COMPRESSED>* w) { delete w; }, this->db.release());
+    }
+
+    scc::trace_rotation rotation;
+    std::unique_ptr<scc::trace::chunk_index> chunks;
+    std::thread closer;
+    uint64_t last_time{0};
+    std::vector<std::tuple<uint64_t, std::string, std::string>> streams;
+    std::vector<std::tuple<uint64_t, std::string, uint64_t>> generators;
+    std::unordered_map<uint64_t, transaction> pending;
+    //! the ids of the transactions written to the current chunk
+    std::unordered_set<uint64_t> written;
+    std::vector<relation> relations;
+};
 } // namespace
 // ----------------------------------------------------------------------------
-void scv_tr_ftr_init(bool compressed) {
-    if(compressed) {
+void scv_tr_ftr_init(bool compressed, bool async, sc_core::sc_time const& chunk_time, uint64_t chunk_size) {
+    if(chunk_time > sc_core::SC_ZERO_TIME || chunk_size > 0) {
+        if(compressed)
+            scv_tr_async_init(std::unique_ptr<scv_tr_async_sink>(new chunked_sink<true>(chunk_time, chunk_size)));
+        else
+            scv_tr_async_init(std::unique_ptr<scv_tr_async_sink>(new chunked_sink<false>(chunk_time, chunk_size)));
+    } else if(async) {
+        if(compressed)
+            scv_tr_async_init(std::unique_ptr<scv_tr_async_sink>(new async_sink<true>()));
+        else
+            scv_tr_async_init(std::unique_ptr<scv_tr_async_sink>(new async_sink<false>()));
+    } else if(compressed) {
         scv_tr_db::register_class_cb(tx_db<true>::dbCb);
         scv_tr_stream::register_class_cb(tx_db<true>::streamCb);
         scv_tr_generator_base::register_class_cb(tx_db<true>::generatorCb);
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include "scv_tr_async.h"
+#include "scv_tr_schema.h"
 #include <array>
 #include <boost/filesystem.hpp>
 #include <cmath>
@@ -190,6 +192,11 @@ template <typename WRITER> struct Formatter {
         return db;
     }
 };
+template <typename DB> scv_tr_schema_cache<>& schemas() {
+    static scv_tr_schema_cache<> cache;
+    return cache;
+}
+// ----------------------------------------------------------------------------
 template <typename DB> void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
     // This is called from the scv_tr_db ctor.
     static string fName("DEFAULT_scv_tr_sqlite");
@@ -209,6 +216,7 @@ template <typename DB> void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callbac
         } catch(...) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
         }
+        schemas<DB>().clear();
         break;
     default:
         _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Unknown reason in scv_tr_db callback");
@@ -314,6 +322,58 @@ inline void recordAttributes(uint64_t id, EventType eventType, char const* prefi
     }
 }
 // ----------------------------------------------------------------------------
+template <typename DB>
+inline void recordAttributes(uint64_t id, EventType eventType, scv_tr_schema<>& schema, const scv_extensions_if* my_exts_p) {
+    for(auto& attr : schema.attributes()) {
+        auto* leaf_p = scv_tr_schema<>::leaf(my_exts_p, attr);
+        if(!leaf_p)
+            continue;
+        auto const& name = attr.name;
+        switch(attr.type) {
+        case scv_extensions_if::POINTER:
+            if(auto ptr = leaf_p->get_pointer()) {
+                auto prefix = schema.prefix() + "*";
+                recordAttributes<DB>(id, eventType, prefix.c_str(), ptr);
+            }
+            break;
+        case scv_extensions_if::ENUMERATION:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, leaf_p->get_enum_string((int)(leaf_p->get_integer())));
+            break;
+        case scv_extensions_if::BOOLEAN:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, leaf_p->get_bool());
+            break;
+        case scv_extensions_if::INTEGER:
+        case scv_extensions_if::FIXED_POINT_INTEGER:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::INTEGER, (int64_t)leaf_p->get_integer());
+            break;
+        case scv_extensions_if::UNSIGNED:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, (uint64_t)leaf_p->get_unsigned());
+            break;
+        case scv_extensions_if::STRING:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::STRING, leaf_p->get_string());
+            break;
+        case scv_extensions_if::FLOATING_POINT_NUMBER:
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, leaf_p->get_double());
+            break;
+        case scv_extensions_if::BIT_VECTOR: {
+            sc_bv_base tmp_bv(leaf_p->get_bitwidth());
+            leaf_p->get_value(tmp_bv);
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
+        } break;
+        case scv_extensions_if::LOGIC_VECTOR: {
+            sc_lv_base tmp_lv(leaf_p->get_bitwidth());
+            leaf_p->get_value(tmp_lv);
+            DB::get().writeAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
+        } break;
+        default: {
+            std::array<char, 100> tmpString;
+            sprintf(tmpString.data(), "Unsupported attribute type = %d", attr.type);
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
+        }
+        }
+    }
+}
+// ----------------------------------------------------------------------------
 template <typename DB> void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
     if(reason == scv_tr_generator_base::CREATE) {
         try {
@@ -348,22 +408,16 @@ template <typename DB> void transactionCb(const scv_tr_handle& t, scv_tr_handle:
         my_exts_p = t.get_begin_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-            recordAttributes<DB>(id, BEGIN, tmp_str, my_exts_p);
-        }
+        if(my_exts_p)
+            recordAttributes<DB>(id, BEGIN, schemas<DB>().get(t.get_scv_tr_generator_base(), false, my_exts_p), my_exts_p);
     } break;
     case scv_tr_handle::END: {
         DB::get().writeTransaction(t.get_id(), t.get_scv_tr_generator_base().get_id(), END, t.get_begin_sc_time().value());
         my_exts_p = t.get_end_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-            recordAttributes<DB>(t.get_id(), END, tmp_str, my_exts_p);
-        }
+        if(my_exts_p)
+            recordAttributes<DB>(t.get_id(), END, schemas<DB>().get(t.get_scv_tr_generator_base(), true, my_exts_p), my_exts_p);
     } break;
     default:;
     }
@@ -374,7 +428,8 @@ template <typename DB> void attributeCb(const scv_tr_handle& t, const char* name
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    recordAttributes<DB>(t.get_id(), RECORD, name == nullptr ? "" : name, ext);
+    if(ext)
+        recordAttributes<DB>(t.get_id(), RECORD, schemas<DB>().get(name, ext), ext);
 }
 // ----------------------------------------------------------------------------
 template <typename DB>
@@ -389,9 +444,62 @@ void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data
         _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create transaction relation");
     }
 }
+// ----------------------------------------------------------------------------
+template <typename WRITER> struct AsyncSink : public scv_tr_async_sink {
+    Formatter<WRITER> formatter;
+
+    bool open(std::string const& name) override { return formatter.open(name); }
+
+    void close() override { formatter.close(); }
+
+    void writeStream(uint64_t id, std::string const& name, std::string const& kind) override { formatter.writeStream(id, name, kind); }
+
+    void writeGenerator(uint64_t id, std::string const& name, uint64_t stream, std::vector<attr_desc> const& attributes) override {
+        std::vector<AttrDesc> attrs;
+        for(auto& a : attributes)
+            attrs.emplace_back(static_cast<EventType>(a.evt), a.type, a.name);
+        formatter.writeGenerator(id, name, stream, attrs);
+    }
+
+    void beginTransaction(uint64_t id, uint64_t generator, uint64_t stream, uint64_t time) override {
+        formatter.writeTransaction(id, generator, EventType::BEGIN, time);
+    }
+
+    void endTransaction(uint64_t id, uint64_t generator, uint64_t stream, uint64_t time) override {
+        formatter.writeTransaction(id, generator, EventType::END, time);
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, std::string const& value) override {
+        formatter.writeAttribute(id, static_cast<EventType>(event), name, type, value);
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, int64_t value) override {
+        formatter.writeAttribute(id, static_cast<EventType>(event), name, type, value);
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, uint64_t value) override {
+        formatter.writeAttribute(id, static_cast<EventType>(event), name, type, value);
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, bool value) override {
+        formatter.writeAttribute(id, static_cast<EventType>(event), name, type, value);
+    }
+
+    void writeAttribute(uint64_t id, event_type event, std::string const& name, data_type type, double value) override {
+        formatter.writeAttribute(id, static_cast<EventType>(event), name, type, value);
+    }
+
+    void writeRelation(std::string const& name, uint64_t stream_1, uint64_t tx_1, uint64_t stream_2, uint64_t tx_2) override {
+        formatter.writeRelation(name, tx_1, tx_2);
+    }
+};
 } // namespace
 // ----------------------------------------------------------------------------
-void scv_tr_lz4_init() {
+void scv_tr_lz4_init(bool async) {
+    if(async) {
+        scv_tr_async_init(std::unique_ptr<scv_tr_async_sink>(new AsyncSink<LZ4Writer>()));
+        return;
+    }
     scv_tr_db::register_class_cb(dbCb<Formatter<LZ4Writer>>);
     scv_tr_stream::register_class_cb(streamCb<Formatter<LZ4Writer>>);
     scv_tr_generator_base::register_class_cb(generatorCb<Formatter<LZ4Writer>>);
@@ -399,7 +507,11 @@ void scv_tr_lz4_init() {
     scv_tr_handle::register_record_attribute_cb(attributeCb<Formatter<LZ4Writer>>);
     scv_tr_handle::register_relation_cb(relationCb<Formatter<LZ4Writer>>);
 }
-void scv_tr_plain_init() {
+void scv_tr_plain_init(bool async) {
+    if(async) {
+        scv_tr_async_init(std::unique_ptr<scv_tr_async_sink>(new AsyncSink<PlainWriter>()));
+        return;
+    }
     scv_tr_db::register_class_cb(dbCb<Formatter<PlainWriter>>);
     scv_tr_stream::register_class_cb(streamCb<Formatter<PlainWriter>>);
     scv_tr_generator_base::register_class_cb(generatorCb<Formatter<PlainWriter>>);
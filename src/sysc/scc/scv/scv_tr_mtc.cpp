@@ -13,19 +13,25 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include "scv_tr_schema.h"
+#include <algorithm>
 #include <array>
-#include <boost/filesystem.hpp>
+#include <atomic>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
-#include <fcntl.h>
-#include <fstream>
-#include <iostream>
-#include <sstream>
+#include <deque>
+#include <future>
+#include <lz4.h>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
-#include <unordered_set>
+#include <util/scv_mtc_format.h>
+#include <util/thread_pool.h>
 #include <vector>
 // clang-format off
 #ifdef HAS_SCV
@@ -44,79 +50,270 @@ enum EventType { BEGIN, RECORD, END };
 using data_type = scv_extensions_if::data_type;
 // ----------------------------------------------------------------------------
 namespace {
-class Base {
-protected:
-    boost::filesystem::path dir;
-    std::ofstream out;
-    bool const is_open;
-    std::array<char, 1024> buffer;
-    Base(const std::string& name)
-    : dir(name.c_str())
-    , out(name)
-    , is_open(out.is_open()) {
-        //        if(boost::filesystem::exists(dir))
-        //            boost::filesystem::remove_all(dir);
-        //        boost::filesystem::create_directory(dir);
+namespace mtc = util::scv_mtc;
+//! records are collected per shard until a block is full
+struct shard {
+    uint64_t stream{0};
+    mtc::block_kind kind{mtc::TX_BLOCK};
+    std::vector<uint8_t> buf;
+    uint64_t first_time{0}, last_time{0};
+    uint64_t prev_id{0};
+    uint32_t count{0};
+    bool has_time{false};
+
+    inline void put(uint64_t v) {
+        while(v >= 0x80) {
+            buf.push_back(static_cast<uint8_t>(v) | 0x80);
+            v >>= 7;
+        }
+        buf.push_back(static_cast<uint8_t>(v));
+    }
+    inline void put_signed(int64_t v) { put((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63)); }
+    inline void put_double(double v) {
+        uint8_t tmp[sizeof(double)];
+        memcpy(tmp, &v, sizeof(double));
+        buf.insert(buf.end(), tmp, tmp + sizeof(double));
+    }
+    inline void put_id(uint64_t id) {
+        put_signed(static_cast<int64_t>(id - prev_id));
+        prev_id = id;
     }
-    ~Base() {
-        if(is_open)
-            out.close();
+    inline void put_time(uint64_t time) {
+        if(!has_time)
+            first_time = last_time = time;
+        has_time = true;
+        put(time - last_time);
+        last_time = time;
     }
 };
 
-struct Database : Base {
-    uint64_t idx{0};
+class Database {
+public:
     Database(const std::string& name)
-    : Base(name) {}
+    : out(fopen(name.c_str(), "wb")) {
+        if(!out)
+            throw std::runtime_error("Can't open recording file");
+        write(mtc::magic, sizeof(mtc::magic));
+        int64_t time_unit = static_cast<int64_t>(std::rint(std::log10(sc_core::sc_time::from_value(1ULL).to_seconds())));
+        write(&time_unit, sizeof(time_unit));
+        meta.kind = mtc::META_BLOCK;
+        auto threads = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+        max_pending = 2 * threads;
+        pool.start(threads);
+    }
 
-    inline uint64_t getIdOf(const std::string& str) { return idx; }
+    ~Database() {
+        flush(meta);
+        for(auto& e : shards)
+            flush(e.second);
+        while(pending.size()) {
+            pending.front().get();
+            pending.pop_front();
+        }
+        pool.finish();
+        std::sort(index.begin(), index.end(), [](mtc::block_desc const& a, mtc::block_desc const& b) {
+            return std::tie(a.kind, a.stream, a.first_time, a.offset) < std::tie(b.kind, b.stream, b.first_time, b.offset);
+        });
+        auto index_offset = offset;
+        write(index.data(), index.size() * sizeof(mtc::block_desc));
+        uint64_t trailer[2] = {index_offset, index.size()};
+        write(trailer, sizeof(trailer));
+        write(mtc::magic, sizeof(mtc::magic));
+        fclose(out);
+        if(failed)
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Error writing recording file");
+    }
 
     inline void writeStream(uint64_t id, std::string const& name, std::string const& kind) {
-        if(is_open) {
-            auto len = sprintf(buffer.data(), "scv_tr_stream (ID %lu, name \"%s\", kind \"%s\")\n", id, name.c_str(), kind.c_str());
-            out.write(buffer.data(), len);
-        }
+        auto name_id = getIdOf(name);
+        auto kind_id = getIdOf(kind);
+        meta.buf.push_back(mtc::STREAM);
+        meta.put(id);
+        meta.put(name_id);
+        meta.put(kind_id);
+        commit(meta);
+        auto& s = shards[id];
+        s.stream = id;
+        s.buf.reserve(block_size + 256);
     }
 
     inline void writeGenerator(uint64_t id, std::string const& name, uint64_t stream) {
-        if(is_open) {
-            auto len = sprintf(buffer.data(), "scv_tr_generator (ID %lu, name \"%s\", scv_tr_stream %lu,\n", id, name.c_str(), stream);
-            out.write(buffer.data(), len);
-        }
+        auto name_id = getIdOf(name);
+        meta.buf.push_back(mtc::GENERATOR);
+        meta.put(id);
+        meta.put(name_id);
+        meta.put(stream);
+        commit(meta);
     }
 
-    inline uint64_t writeTransaction(uint64_t id, uint64_t generator) {
-        return ++idx; // d.writeTx(id, generator, concurrencyLevel);
+    inline void writeTransaction(uint64_t stream, uint64_t id, uint64_t generator, EventType type, uint64_t time) {
+        auto& s = get_shard(stream);
+        s.buf.push_back(type == BEGIN ? mtc::TX_BEGIN : mtc::TX_END);
+        s.put_id(id);
+        if(type == BEGIN)
+            s.put(generator);
+        s.put_time(time);
+        commit(s);
     }
 
-    inline void writeTxTimepoint(uint64_t id, int type, uint64_t time, uint64_t file_offset) {
-        //        t.append(type, time, file_offset);
+    inline void writeAttribute(uint64_t stream, uint64_t id, EventType event, uint64_t name_id, data_type type, const string& value) {
+        auto value_id = getIdOf(value);
+        auto& s = start_attribute(stream, mtc::ATTR_STRING, id, event, name_id, type);
+        s.put(value_id);
+        commit(s);
     }
 
-    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, const string& value) {
-        //        d.writeAttribute(id, event, c.getIdOf(name), type, c.getIdOf(value));
+    inline void writeAttribute(uint64_t stream, uint64_t id, EventType event, uint64_t name_id, data_type type, int64_t value) {
+        auto& s = start_attribute(stream, mtc::ATTR_INT, id, event, name_id, type);
+        s.put_signed(value);
+        commit(s);
     }
 
-    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, uint64_t value) {
-        //        d.writeAttribute(id, event, c.getIdOf(name), type, value);
+    inline void writeAttribute(uint64_t stream, uint64_t id, EventType event, uint64_t name_id, data_type type, uint64_t value) {
+        auto& s = start_attribute(stream, mtc::ATTR_UINT, id, event, name_id, type);
+        s.put(value);
+        commit(s);
     }
 
-    inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, double value) {
-        //        int exponent;
-        //        const double mantissa = frexp(value, &exponent);
+    inline void writeAttribute(uint64_t stream, uint64_t id, EventType event, uint64_t name_id, data_type type, double value) {
+        auto& s = start_attribute(stream, mtc::ATTR_DOUBLE, id, event, name_id, type);
+        s.put_double(value);
+        commit(s);
     }
 
     inline void writeRelation(const std::string& name, uint64_t sink_id, uint64_t src_id) {
-        //        d.writeRelation(c.getIdOf(name), src_id, sink_id);
+        auto name_id = getIdOf(name);
+        meta.buf.push_back(mtc::RELATION);
+        meta.put(name_id);
+        meta.put(sink_id);
+        meta.put(src_id);
+        commit(meta);
+    }
+
+    //! returns the id of str, writes the string record if str is new
+    inline uint64_t getIdOf(const std::string& str) {
+        auto it = strings.find(str);
+        if(it != strings.end())
+            return it->second;
+        auto id = strings.size();
+        strings.insert({str, id});
+        meta.buf.push_back(mtc::STRING);
+        meta.put(id);
+        meta.put(str.size());
+        meta.buf.insert(meta.buf.end(), str.begin(), str.end());
+        commit(meta);
+        return id;
+    }
+
+private:
+    //! size of the uncompressed data of a block
+    static constexpr size_t block_size = 64 * 1024;
+
+    inline shard& get_shard(uint64_t stream) {
+        if(last_shard && last_shard->stream == stream)
+            return *last_shard;
+        auto& s = shards[stream];
+        s.stream = stream;
+        return *(last_shard = &s);
+    }
+
+    inline shard& start_attribute(uint64_t stream, mtc::record_tag tag, uint64_t id, EventType event, uint64_t name_id, data_type type) {
+        auto& s = get_shard(stream);
+        s.buf.push_back(tag);
+        s.put_id(id);
+        s.put(event);
+        s.put(name_id);
+        s.put(type);
+        return s;
+    }
+
+    inline void commit(shard& s) {
+        s.count++;
+        if(s.buf.size() >= block_size)
+            flush(s);
+    }
+    /*
+     * hand the content of the shard over to the worker pool and reset it. The metadata is handed over before a block
+     * of transactions so that the strings, streams and generators it refers to are in the file if the simulation
+     * terminates abnormally.
+     */
+    void flush(shard& s) {
+        if(!s.count)
+            return;
+        if(s.kind == mtc::TX_BLOCK)
+            flush(meta);
+        auto job = std::make_shared<block_job>();
+        job->desc.stream = s.stream;
+        job->desc.first_time = s.first_time;
+        job->desc.last_time = s.last_time;
+        job->desc.count = s.count;
+        job->desc.kind = s.kind;
+        job->data.swap(s.buf);
+        s.buf.reserve(block_size + 256);
+        s.count = 0;
+        s.prev_id = 0;
+        s.has_time = false;
+        // limit the memory held by blocks waiting for compression
+        while(pending.size() && (pending.size() >= max_pending || is_ready(pending.front()))) {
+            pending.front().get();
+            pending.pop_front();
+        }
+        pending.push_back(pool.enqueue([this, job]() { compress_and_write(*job); }));
+    }
+
+    struct block_job {
+        mtc::block_desc desc;
+        std::vector<uint8_t> data;
+    };
+    //! runs on the worker pool, only the file access is serialized. Each frame is flushed to the file when written
+    void compress_and_write(block_job& job) {
+        std::vector<char> comp(LZ4_compressBound(static_cast<int>(job.data.size())));
+        auto comp_size = LZ4_compress_default(reinterpret_cast<char const*>(job.data.data()), comp.data(),
+                                              static_cast<int>(job.data.size()), static_cast<int>(comp.size()));
+        if(comp_size <= 0) {
+            failed = true;
+            return;
+        }
+        job.desc.raw_size = static_cast<uint32_t>(job.data.size());
+        job.desc.comp_size = static_cast<uint32_t>(comp_size);
+        std::lock_guard<std::mutex> lock(file_mtx);
+        job.desc.offset = offset + sizeof(mtc::block_desc);
+        write(&job.desc, sizeof(mtc::block_desc));
+        write(comp.data(), comp_size);
+        if(fflush(out))
+            failed = true;
+        index.push_back(job.desc);
     }
+
+    void write(void const* data, size_t size) {
+        if(fwrite(data, 1, size, out) != size)
+            failed = true;
+        offset += size;
+    }
+
+    static bool is_ready(std::future<void> const& f) { return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+    FILE* out;
+    uint64_t offset{0};
+    std::atomic<bool> failed{false};
+    std::mutex file_mtx;
+    std::vector<mtc::block_desc> index;
+    util::thread_pool pool;
+    std::deque<std::future<void>> pending;
+    size_t max_pending{2};
+    std::unordered_map<std::string, uint64_t> strings;
+    shard meta;
+    std::unordered_map<uint64_t, shard> shards;
+    shard* last_shard{nullptr};
 };
 
 Database* db;
-std::unordered_map<uint64_t, uint64_t> id2offset;
+//! the attribute schemas, the per attribute data is the id of the attribute name
+scv_tr_schema_cache<> schemas([](scv_tr_schema_cache<>::attribute& attr) { attr.data = db->getIdOf(attr.name); });
 
 void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
     // This is called from the scv_tr_db ctor.
-    static string fName("DEFAULT_scv_tr_sqlite");
+    static string fName("DEFAULT_scv_tr_mtc");
     switch(reason) {
     case scv_tr_db::CREATE:
         if((_scv_tr_db.get_name() != nullptr) && (strlen(_scv_tr_db.get_name()) != 0))
@@ -130,6 +327,8 @@ void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void*
     case scv_tr_db::DELETE:
         try {
             delete db;
+            db = nullptr;
+            schemas.clear();
         } catch(...) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
         }
@@ -140,7 +339,7 @@ void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void*
 }
 // ----------------------------------------------------------------------------
 void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, void* data) {
-    if(reason == scv_tr_stream::CREATE) {
+    if(reason == scv_tr_stream::CREATE && db) {
         try {
             db->writeStream(s.get_id(), s.get_name(), s.get_stream_kind());
         } catch(std::runtime_error& e) {
@@ -149,107 +348,60 @@ void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, voi
     }
 }
 // ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, const string& value) {
+template <typename T> inline void recordAttribute(uint64_t stream, uint64_t id, EventType event, uint64_t name, data_type type, T value) {
     try {
-        db->writeAttribute(id, event, name, type, value);
+        db->writeAttribute(stream, id, event, name, type, value);
     } catch(std::runtime_error& e) {
         _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
     }
 }
 // ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, long long value) {
-    try {
-        db->writeAttribute(id, event, name, type, static_cast<uint64_t>(value));
-    } catch(std::runtime_error& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
-    }
-}
-// ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, double value) {
-    try {
-        db->writeAttribute(id, event, name, type, value);
-    } catch(std::runtime_error& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
-    }
-}
-
-inline std::string get_name(const char* prefix, const scv_extensions_if* my_exts_p) {
-    static thread_local std::unordered_map<const scv_extensions_if*, std::string> name_lut;
-    auto it = name_lut.find(my_exts_p);
-    if(it != name_lut.end())
-        return it->second;
-    string name;
-    if(!prefix || strlen(prefix) == 0) {
-        name = my_exts_p->get_name();
-    } else {
-        if((my_exts_p->get_name() == nullptr) || (strlen(my_exts_p->get_name()) == 0)) {
-            name = prefix;
-        } else {
-            name = std::string(prefix) + "." + my_exts_p->get_name();
+void recordAttributes(uint64_t stream, uint64_t id, EventType eventType, scv_tr_schema<>& schema, const scv_extensions_if* my_exts_p) {
+    for(auto& attr : schema.attributes()) {
+        auto* leaf_p = scv_tr_schema<>::leaf(my_exts_p, attr);
+        if(!leaf_p)
+            continue;
+        auto name = attr.data;
+        switch(attr.type) {
+        case scv_extensions_if::ENUMERATION:
+            recordAttribute(stream, id, eventType, name, scv_extensions_if::ENUMERATION,
+                            string(leaf_p->get_enum_string((int)(leaf_p->get_integer()))));
+            break;
+        case scv_extensions_if::BOOLEAN:
+            recordAttribute(stream, id, eventType, name, scv_extensions_if::BOOLEAN, string(leaf_p->get_bool() ? "TRUE" : "FALSE"));
+            break;
+        case scv_extensions_if::INTEGER:
+        case scv_extensions_if::FIXED_POINT_INTEGER:
+            recordAttribute(stream, id, eventType, name, scv_extensions_if::INTEGER, static_cast<int64_t>(leaf_p->get_integer()));
+            break;
+        case scv_extensions_if::UNSIGNED:
+            recordAttribute(stream, id, eventType, name, scv_extensions_if::UNSIGNED, static_cast<uint64_t>(leaf_p->get_integer()));
+            break;
+        case scv_extensions_if::POINTER:
+            recordAttribute(stream, id, eventType, name, scv_extensions_if::POINTER, reinterpret_cast<uint64_t>(leaf_p->get_pointer()));
+            break;
+        case scv_extensions_if::STRING:
+            recordAttribute(stream, id, eventType, name, scv_extensions_if::STRING, string(leaf_p->get_string()));
+            break;
+        case scv_extensions_if::FLOATING_POINT_NUMBER:
+            recordAttribute(stream, id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, leaf_p->get_double());
+            break;
+        case scv_extensions_if::BIT_VECTOR: {
+            sc_bv_base tmp_bv(leaf_p->get_bitwidth());
+            leaf_p->get_value(tmp_bv);
+            recordAttribute(stream, id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
+        } break;
+        case scv_extensions_if::LOGIC_VECTOR: {
+            sc_lv_base tmp_lv(leaf_p->get_bitwidth());
+            leaf_p->get_value(tmp_lv);
+            recordAttribute(stream, id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
+        } break;
+        default: {
+            std::array<char, 100> tmpString;
+            sprintf(tmpString.data(), "Unsupported attribute type = %d", attr.type);
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
         }
-    }
-    name_lut[my_exts_p] = (name == "") ? "<unnamed>" : name;
-    return (name == "") ? "<unnamed>" : name;
-}
-
-// ----------------------------------------------------------------------------
-void recordAttributes(uint64_t id, EventType eventType, char const* prefix, const scv_extensions_if* my_exts_p) {
-    if(my_exts_p == nullptr)
-        return;
-    auto name = get_name(prefix, my_exts_p);
-    switch(my_exts_p->get_type()) {
-    case scv_extensions_if::RECORD: {
-        int num_fields = my_exts_p->get_num_fields();
-        if(num_fields > 0) {
-            for(int field_counter = 0; field_counter < num_fields; field_counter++) {
-                const scv_extensions_if* field_data_p = my_exts_p->get_field(field_counter);
-                recordAttributes(id, eventType, prefix, field_data_p);
-            }
         }
-    } break;
-    case scv_extensions_if::ENUMERATION:
-        recordAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, my_exts_p->get_enum_string((int)(my_exts_p->get_integer())));
-        break;
-    case scv_extensions_if::BOOLEAN:
-        recordAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, my_exts_p->get_bool() ? "TRUE" : "FALSE");
-        break;
-    case scv_extensions_if::INTEGER:
-    case scv_extensions_if::FIXED_POINT_INTEGER:
-        recordAttribute(id, eventType, name, scv_extensions_if::INTEGER, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::UNSIGNED:
-        recordAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::POINTER:
-        recordAttribute(id, eventType, name, scv_extensions_if::POINTER, (long long)my_exts_p->get_pointer());
-        break;
-    case scv_extensions_if::STRING:
-        recordAttribute(id, eventType, name, scv_extensions_if::STRING, my_exts_p->get_string());
-        break;
-    case scv_extensions_if::FLOATING_POINT_NUMBER:
-        recordAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, my_exts_p->get_double());
-        break;
-    case scv_extensions_if::BIT_VECTOR: {
-        sc_bv_base tmp_bv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_bv);
-        recordAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
-    } break;
-    case scv_extensions_if::LOGIC_VECTOR: {
-        sc_lv_base tmp_lv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_lv);
-        recordAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
-    } break;
-    case scv_extensions_if::ARRAY:
-        for(int array_elt_index = 0; array_elt_index < my_exts_p->get_array_size(); array_elt_index++) {
-            const scv_extensions_if* field_data_p = my_exts_p->get_array_elt(array_elt_index);
-            recordAttributes(id, eventType, prefix, field_data_p);
-        }
-        break;
-    default: {
-        std::array<char, 100> tmpString;
-        sprintf(tmpString.data(), "Unsupported attribute type = %d", my_exts_p->get_type());
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
-    }
     }
 }
 // ----------------------------------------------------------------------------
@@ -272,28 +424,24 @@ void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason
         return;
 
     uint64_t id = t.get_id();
-    vector<uint64_t>::size_type concurrencyIdx;
+    uint64_t stream = t.get_scv_tr_stream().get_id();
     const scv_extensions_if* my_exts_p;
     switch(reason) {
     case scv_tr_handle::BEGIN: {
+        db->writeTransaction(stream, id, t.get_scv_tr_generator_base().get_id(), BEGIN, t.get_begin_sc_time().value());
         my_exts_p = t.get_begin_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-            recordAttributes(id, BEGIN, tmp_str, my_exts_p);
-        }
+        if(my_exts_p)
+            recordAttributes(stream, id, BEGIN, schemas.get(t.get_scv_tr_generator_base(), false, my_exts_p), my_exts_p);
     } break;
     case scv_tr_handle::END: {
         my_exts_p = t.get_end_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-            recordAttributes(t.get_id(), END, tmp_str, my_exts_p);
-        }
+        if(my_exts_p)
+            recordAttributes(stream, id, END, schemas.get(t.get_scv_tr_generator_base(), true, my_exts_p), my_exts_p);
+        db->writeTransaction(stream, id, t.get_scv_tr_generator_base().get_id(), END, t.get_end_sc_time().value());
     } break;
     default:;
     }
@@ -306,7 +454,8 @@ void attributeCb(const scv_tr_handle& t, const char* name, const scv_extensions_
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    recordAttributes(t.get_id(), RECORD, name == nullptr ? "" : name, ext);
+    if(ext)
+        recordAttributes(t.get_scv_tr_stream().get_id(), t.get_id(), RECORD, schemas.get(name, ext), ext);
 }
 // ----------------------------------------------------------------------------
 void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCC_SCV_TR_SCHEMA_H_
+#define _SCC_SCV_TR_SCHEMA_H_
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+// clang-format off
+#ifdef HAS_SCV
+#include <scv.h>
+#else
+#include <scv-tr.h>
+namespace scv_tr {
+#endif
+// clang-format on
+/**
+ * @class scv_tr_schema
+ * @brief the flattened attribute layout of an introspected data type
+ *
+ * The shape of the extension tree of a data type does not depend on the value so it is walked only once. Each leaf
+ * becomes an attribute holding its full (prefixed) name, its data type and the field resp. array element indices
+ * leading to it. Recording a value then is a loop over the attributes calling one getter per leaf instead of a
+ * recursive walk building the names. The template parameter T is a slot the backend can use to cache per attribute
+ * data, e.g. the id of the interned name.
+ */
+template <typename T = uint64_t> class scv_tr_schema {
+public:
+    struct attribute {
+        std::string name;
+        scv_extensions_if::data_type type;
+        std::vector<unsigned> path;
+        T data;
+    };
+
+    scv_tr_schema(char const* prefix, const scv_extensions_if* ext)
+    : prefix_str(prefix ? prefix : "") {
+        std::vector<unsigned> path;
+        flatten(prefix_str.c_str(), ext, path);
+    }
+
+    std::vector<attribute>& attributes() { return attrs; }
+    //! the name prefix the schema was created with
+    std::string const& prefix() const { return prefix_str; }
+    //! returns the leaf of value ext described by attr
+    static const scv_extensions_if* leaf(const scv_extensions_if* ext, attribute const& attr) {
+        auto* ret = ext;
+        auto* idx = attr.path.data();
+        for(auto* end = idx + attr.path.size(); ret && idx != end; ++idx)
+            ret = ret->get_type() == scv_extensions_if::ARRAY ? ret->get_array_elt(*idx) : ret->get_field(*idx);
+        return ret;
+    }
+
+private:
+    void flatten(char const* prefix, const scv_extensions_if* ext, std::vector<unsigned>& path) {
+        if(!ext)
+            return;
+        switch(ext->get_type()) {
+        case scv_extensions_if::RECORD:
+            for(int i = 0; i < ext->get_num_fields(); ++i) {
+                path.push_back(i);
+                flatten(prefix, ext->get_field(i), path);
+                path.pop_back();
+            }
+            break;
+        case scv_extensions_if::ARRAY:
+            for(int i = 0; i < ext->get_array_size(); ++i) {
+                path.push_back(i);
+                flatten(prefix, ext->get_array_elt(i), path);
+                path.pop_back();
+            }
+            break;
+        default: {
+            std::string name{prefix};
+            auto const* ext_name = ext->get_name();
+            if(name.empty())
+                name = ext_name ? ext_name : "";
+            else if(ext_name && strlen(ext_name))
+                name.append(".").append(ext_name);
+            attrs.push_back({name.empty() ? "<unnamed>" : name, ext->get_type(), path, T{}});
+        }
+        }
+    }
+    std::string prefix_str;
+    std::vector<attribute> attrs;
+};
+/**
+ * @class scv_tr_schema_cache
+ * @brief holds the schemas of the attributes being recorded, to be used from the simulation thread only
+ *
+ * The begin and end attributes of a generator always have the type of its template parameters, their schemas are
+ * kept in a table indexed by the generator id. Attributes recorded during a transaction may have any type, their
+ * schemas are looked up by type and name. The optional init function is called once for each attribute of a newly
+ * created schema, e.g. to intern the attribute name.
+ */
+template <typename T = uint64_t> class scv_tr_schema_cache {
+public:
+    using schema = scv_tr_schema<T>;
+    using attribute = typename schema::attribute;
+
+    scv_tr_schema_cache(std::function<void(attribute&)> init = std::function<void(attribute&)>())
+    : init(init) {}
+    //! the schema of the begin resp. end attributes of generator gen, ext is the actual value being recorded
+    schema& get(scv_tr_generator_base const& gen, bool end, const scv_extensions_if* ext) {
+        auto idx = 2 * gen.get_id() + (end ? 1 : 0);
+        if(idx >= generator_schemas.size())
+            generator_schemas.resize(idx + 1);
+        auto& ret = generator_schemas[idx];
+        if(!ret) {
+            auto* prefix = end ? gen.get_end_attribute_name() : gen.get_begin_attribute_name();
+            ret = create(prefix, ext);
+        }
+        return *ret;
+    }
+    //! the schema of an attribute recorded with name during a transaction
+    schema& get(char const* name, const scv_extensions_if* ext) {
+        auto& by_name = record_schemas[std::type_index(typeid(*ext))];
+        std::string key{name ? name : ""};
+        auto it = by_name.find(key);
+        if(it == by_name.end())
+            it = by_name.emplace(key, create(name, ext)).first;
+        return *it->second;
+    }
+
+    void clear() {
+        generator_schemas.clear();
+        record_schemas.clear();
+    }
+
+private:
+    std::unique_ptr<schema> create(char const* prefix, const scv_extensions_if* ext) {
+        std::unique_ptr<schema> ret(new schema(prefix, ext));
+        if(init)
+            for(auto& attr : ret->attributes())
+                init(attr);
+        return ret;
+    }
+    std::function<void(attribute&)> init;
+    std::vector<std::unique_ptr<schema>> generator_schemas;
+    std::unordered_map<std::type_index, std::unordered_map<std::string, std::unique_ptr<schema>>> record_schemas;
+};
+
+#ifndef HAS_SCV
+}
+#endif
+#endif /* _SCC_SCV_TR_SCHEMA_H_ */
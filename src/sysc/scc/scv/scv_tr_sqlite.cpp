@@ -13,13 +13,22 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include "scv_tr_schema.h"
 #include "sqlite3.h"
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
+#include <cstring>
+#include <deque>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #ifdef HAS_SCV
@@ -30,7 +39,14 @@ namespace scv_tr {
 #endif
 // ----------------------------------------------------------------------------
 constexpr auto SQLITEWRAPPER_ERROR = 1000;
-constexpr auto with_transactions = false;
+//! the number of rows being collected before they are handed over to the writer thread
+constexpr size_t batch_rows = 16384;
+//! the maximum wall clock time between two commits so that the database can be inspected while the simulation runs
+constexpr auto commit_interval = std::chrono::seconds(2);
+//! the number of batches waiting for the writer thread before the simulation is stalled
+constexpr size_t max_pending_batches = 4;
+//! the number of rows inserted by a single multi-row INSERT statement
+constexpr size_t rows_per_insert = 64;
 // ----------------------------------------------------------------------------
 using namespace std;
 
@@ -59,7 +75,8 @@ public:
             throw SQLiteException(nRet, sqlite3_errmsg(db), false);
         sqlite3_busy_timeout(db, busyTimeoutMs);
         sqlite3_config(SQLITE_CONFIG_MMAP_SIZE, 1ULL << 26, 1ULL << 30);
-        char* zSql = sqlite3_mprintf("PRAGMA journal_mode=OFF;\n"
+        // the write-ahead log allows readers to access the committed part while the simulation runs
+        char* zSql = sqlite3_mprintf("PRAGMA journal_mode=WAL;\n"
                                      "PRAGMA synchronous=OFF;\n");
         char* zErrMsg = nullptr;
         nRet = sqlite3_exec(db, zSql, 0, 0, &zErrMsg);
@@ -115,7 +132,7 @@ public:
             sqlite3_reset(stmt);
             return sqlite3_changes(db);
         } else
-            throw SQLiteException(nRet, sqlite3_errmsg(db));
+            throw SQLiteException(nRet, sqlite3_errmsg(db), false);
     }
 
 protected:
@@ -128,11 +145,6 @@ private:
     int busyTimeoutMs{60000};
     sqlite3* db{nullptr};
 };
-// ----------------------------------------------------------------------------
-static SQLiteDB db;
-static vector<vector<uint64_t>*> concurrencyLevel;
-static sqlite3_stmt *string_stmt, *stream_stmt, *gen_stmt, *tx_stmt, *evt_stmt, *attr_stmt, *rel_stmt;
-
 // ----------------------------------------------------------------------------
 enum EventType { BEGIN, RECORD, END };
 using data_type = scv_extensions_if::data_type;
@@ -145,9 +157,253 @@ using data_type = scv_extensions_if::data_type;
 #define TX_EVENT_TABLE "ScvTxEvent"
 #define TX_ATTRIBUTE_TABLE "ScvTxAttribute"
 #define TX_RELATION_TABLE "ScvTxRelation"
+// ----------------------------------------------------------------------------
+namespace {
+//! the rows collected on the simulation thread between two commits
+struct Batch {
+    std::vector<std::pair<int64_t, std::string>> strings;
+    std::vector<std::array<int64_t, 3>> streams, generators, events, relations;
+    std::vector<std::array<int64_t, 4>> txs;
+    std::vector<std::array<int64_t, 5>> attributes;
+    size_t rows{0};
+};
+/**
+ * Owns the database connection once the schema has been created. Batches are written by a background thread, each
+ * one in its own SQL transaction using multi-row INSERT statements, so the database can be read while the
+ * simulation is running. The indices are created when the database is closed.
+ */
+class Writer {
+public:
+    void open(std::string const& name) {
+        db.open(name);
+        db.exec("PRAGMA count_changes=OFF");
+        db.exec("PRAGMA temp_store=MEMORY");
+        db.exec("CREATE TABLE  IF NOT EXISTS " STRING_TABLE "("
+                "id INTEGER NOT null PRIMARY KEY, "
+                "value TEXT"
+                ");");
+        db.exec("CREATE TABLE  IF NOT EXISTS " STREAM_TABLE "("
+                "id INTEGER  NOT null PRIMARY KEY,  "
+                "name INTEGER REFERENCES " STRING_TABLE "(id), "
+                "kind INTEGER REFERENCES " STRING_TABLE "(id)"
+                ");");
+        db.exec("CREATE TABLE  IF NOT EXISTS " GENERATOR_TABLE "("
+                "id INTEGER  NOT null PRIMARY KEY, "
+                "stream INTEGER REFERENCES " STREAM_TABLE "(id), "
+                "name INTEGER REFERENCES " STRING_TABLE "(id), "
+                "begin_attr INTEGER, "
+                "end_attr INTEGER"
+                ");");
+        db.exec("CREATE TABLE  IF NOT EXISTS " TX_TABLE "("
+                "id INTEGER  NOT null PRIMARY KEY, "
+                "generator INTEGER REFERENCES " GENERATOR_TABLE "(id), "
+                "stream INTEGER REFERENCES " STREAM_TABLE "(id), "
+                "concurrencyLevel INTEGER"
+                ");");
+        db.exec("CREATE TABLE  IF NOT EXISTS " TX_EVENT_TABLE "("
+                "tx INTEGER REFERENCES " TX_TABLE "(id), "
+                "type INTEGER, "
+                "time INTEGER"
+                ");");
+        db.exec("CREATE TABLE  IF NOT EXISTS " TX_ATTRIBUTE_TABLE "("
+                "tx INTEGER REFERENCES " TX_TABLE "(id), "
+                "type INTEGER, "
+                "name INTEGER REFERENCES " STRING_TABLE "(id), "
+                "data_type INTEGER, "
+                "data_value TEXT"
+                ");");
+        db.exec("CREATE TABLE  IF NOT EXISTS " TX_RELATION_TABLE "("
+                "name INTEGER REFERENCES " STRING_TABLE "(id), "
+                "src INTEGER REFERENCES " TX_TABLE "(id), "
+                "sink INTEGER REFERENCES " TX_TABLE "(id)"
+                ");");
+        db.exec("CREATE TABLE IF NOT EXISTS " SIM_PROPS "(time_resolution INTEGER);");
+        std::ostringstream ss;
+        ss << "INSERT INTO " SIM_PROPS " (time_resolution) values (" << (long)(sc_core::sc_get_time_resolution().to_seconds() * 1e15)
+           << ");";
+        db.exec(ss.str().c_str());
+        prepare(string_stmt, STRING_TABLE " (id, value)");
+        prepare(stream_stmt, STREAM_TABLE " (id, name, kind)");
+        prepare(gen_stmt, GENERATOR_TABLE " (id, stream, name)");
+        prepare(tx_stmt, TX_TABLE " (id, generator, stream, concurrencyLevel)");
+        prepare(evt_stmt, TX_EVENT_TABLE " (tx, type, time)");
+        prepare(attr_stmt, TX_ATTRIBUTE_TABLE " (tx, type, name, data_type, data_value)");
+        prepare(rel_stmt, TX_RELATION_TABLE " (name, sink, src)");
+        thread = std::thread([this]() { run(); });
+    }
+    //! hand a batch over to the writer thread, blocks if too many batches are pending
+    void push(std::unique_ptr<Batch>&& batch) {
+        std::unique_lock<std::mutex> lock(mtx);
+        space_available.wait(lock, [this]() { return queue.size() < max_pending_batches; });
+        queue.push_back(std::move(batch));
+        lock.unlock();
+        data_available.notify_one();
+    }
+    //! write all pending batches, create the indices and close the database. Returns the first error which occurred
+    std::string close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            done = true;
+        }
+        data_available.notify_one();
+        if(thread.joinable())
+            thread.join();
+        try {
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_EVENT_TABLE "_tx ON " TX_EVENT_TABLE "(tx)");
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_ATTRIBUTE_TABLE "_tx ON " TX_ATTRIBUTE_TABLE "(tx)");
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_TABLE "_stream ON " TX_TABLE "(stream)");
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_RELATION_TABLE "_src ON " TX_RELATION_TABLE "(src)");
+            db.exec("CREATE INDEX IF NOT EXISTS " TX_RELATION_TABLE "_sink ON " TX_RELATION_TABLE "(sink)");
+            db.exec("PRAGMA wal_checkpoint(TRUNCATE)");
+            for(auto* stmt : {&string_stmt, &stream_stmt, &gen_stmt, &tx_stmt, &evt_stmt, &attr_stmt, &rel_stmt}) {
+                sqlite3_finalize(stmt->single);
+                sqlite3_finalize(stmt->multi);
+            }
+            db.close();
+        } catch(SQLiteDB::SQLiteException& e) {
+            if(error.empty())
+                error = e.what();
+        }
+        return error;
+    }
+
+private:
+    struct Statement {
+        sqlite3_stmt* single{nullptr};
+        sqlite3_stmt* multi{nullptr};
+    };
+
+    void prepare(Statement& stmt, char const* table_and_columns) {
+        auto columns = std::count(table_and_columns, table_and_columns + strlen(table_and_columns), ',') + 1;
+        std::string row = "(?";
+        for(auto i = 1; i < columns; ++i)
+            row += ",?";
+        row += ")";
+        std::string sql = std::string("INSERT INTO ") + table_and_columns + " VALUES " + row;
+        stmt.single = db.prepare(sql);
+        for(size_t i = 1; i < rows_per_insert; ++i)
+            sql += "," + row;
+        stmt.multi = db.prepare(sql);
+        if(!stmt.single || !stmt.multi)
+            throw SQLiteDB::SQLiteException(SQLITEWRAPPER_ERROR, "Can't prepare insert statement", false);
+    }
 
+    template <size_t N> void insert(Statement& stmt, std::vector<std::array<int64_t, N>> const& rows) {
+        size_t i = 0;
+        for(; i + rows_per_insert <= rows.size(); i += rows_per_insert) {
+            int idx = 1;
+            for(auto r = i; r < i + rows_per_insert; ++r)
+                for(auto v : rows[r])
+                    sqlite3_bind_int64(stmt.multi, idx++, v);
+            db.exec(stmt.multi);
+        }
+        for(; i < rows.size(); ++i) {
+            int idx = 1;
+            for(auto v : rows[i])
+                sqlite3_bind_int64(stmt.single, idx++, v);
+            db.exec(stmt.single);
+        }
+    }
+
+    void insert(Statement& stmt, std::vector<std::pair<int64_t, std::string>> const& rows) {
+        size_t i = 0;
+        for(; i + rows_per_insert <= rows.size(); i += rows_per_insert) {
+            int idx = 1;
+            for(auto r = i; r < i + rows_per_insert; ++r) {
+                sqlite3_bind_int64(stmt.multi, idx++, rows[r].first);
+                sqlite3_bind_text(stmt.multi, idx++, rows[r].second.c_str(), -1, SQLITE_STATIC);
+            }
+            db.exec(stmt.multi);
+        }
+        for(; i < rows.size(); ++i) {
+            sqlite3_bind_int64(stmt.single, 1, rows[i].first);
+            sqlite3_bind_text(stmt.single, 2, rows[i].second.c_str(), -1, SQLITE_STATIC);
+            db.exec(stmt.single);
+        }
+    }
+
+    void write(Batch const& batch) {
+        db.exec("BEGIN TRANSACTION");
+        insert(string_stmt, batch.strings);
+        insert(stream_stmt, batch.streams);
+        insert(gen_stmt, batch.generators);
+        insert(tx_stmt, batch.txs);
+        insert(evt_stmt, batch.events);
+        insert(attr_stmt, batch.attributes);
+        insert(rel_stmt, batch.relations);
+        db.exec("COMMIT TRANSACTION");
+    }
+
+    void run() {
+        while(true) {
+            std::unique_ptr<Batch> batch;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                data_available.wait(lock, [this]() { return done || !queue.empty(); });
+                if(queue.empty())
+                    return;
+                batch = std::move(queue.front());
+                queue.pop_front();
+            }
+            space_available.notify_one();
+            try {
+                write(*batch);
+            } catch(SQLiteDB::SQLiteException& e) {
+                if(error.empty())
+                    error = e.what();
+                try {
+                    db.exec("ROLLBACK TRANSACTION");
+                } catch(SQLiteDB::SQLiteException& e) {
+                }
+            }
+        }
+    }
+
+    SQLiteDB db;
+    Statement string_stmt, stream_stmt, gen_stmt, tx_stmt, evt_stmt, attr_stmt, rel_stmt;
+    std::thread thread;
+    std::mutex mtx;
+    std::condition_variable data_available, space_available;
+    std::deque<std::unique_ptr<Batch>> queue;
+    bool done{false};
+    std::string error;
+};
+
+std::unique_ptr<Writer> writer;
+std::unique_ptr<Batch> batch;
+auto last_commit = std::chrono::steady_clock::now();
+std::unordered_map<std::string, uint64_t> str_map;
+//! the transactions being active per stream, the index is the concurrency level
+std::unordered_map<uint64_t, std::vector<uint64_t>> concurrencyLevel;
+
+void flush() {
+    if(batch->rows)
+        writer->push(std::move(batch));
+    batch.reset(new Batch);
+    last_commit = std::chrono::steady_clock::now();
+}
+//! count a row and hand the batch over if it is full or the commit interval has passed, the interval is checked on
+//! every row so that sparse recordings get committed in time as well
+inline void added_row() {
+    if(++batch->rows >= batch_rows || std::chrono::steady_clock::now() - last_commit >= commit_interval)
+        flush();
+}
+
+uint64_t getStringId(std::string const& s) {
+    auto it = str_map.find(s);
+    if(it != std::end(str_map))
+        return it->second;
+    auto id = str_map.size();
+    str_map.insert({s, id});
+    batch->strings.emplace_back(id, s);
+    added_row();
+    return id;
+}
+//! the attribute schemas, the per attribute data is the id of the attribute name
+scv_tr_schema_cache<> schemas([](scv_tr_schema_cache<>::attribute& attr) { attr.data = getStringId(attr.name); });
+} // namespace
+// ----------------------------------------------------------------------------
 static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
-    char* tail = nullptr;
     // This is called from the scv_tr_db ctor.
     static string fName("DEFAULT_scv_tr_sqlite");
     switch(reason) {
@@ -156,86 +412,26 @@ static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason,
             fName = _scv_tr_db.get_name();
         try {
             remove(fName.c_str());
-            db.open(fName);
-            // performance related according to
-            // http://blog.quibb.org/2010/08/fast-bulk-inserts-into-sqlite/
-            db.exec("PRAGMA synchronous=OFF");
-            db.exec("PRAGMA count_changes=OFF");
-            db.exec("PRAGMA journal_mode=OFF");
-            db.exec("PRAGMA temp_store=MEMORY");
-            // scv_out << "TB Transaction Recording has started, file = " <<
-            // my_sqlite_file_name << endl;
-            db.exec("CREATE TABLE  IF NOT EXISTS " STRING_TABLE "("
-                    "id INTEGER NOT null PRIMARY KEY, "
-                    "value TEXT"
-                    ");");
-            db.exec("CREATE TABLE  IF NOT EXISTS " STREAM_TABLE "("
-                    "id INTEGER  NOT null PRIMARY KEY,  "
-                    "name INTEGER REFERENCES " STRING_TABLE "(id), "
-                    "kind INTEGER REFERENCES " STRING_TABLE "(id)"
-                    ");");
-            db.exec("CREATE TABLE  IF NOT EXISTS " GENERATOR_TABLE "("
-                    "id INTEGER  NOT null PRIMARY KEY, "
-                    "stream INTEGER REFERENCES " STREAM_TABLE "(id), "
-                    "name INTEGER REFERENCES " STRING_TABLE "(id), "
-                    "begin_attr INTEGER, "
-                    "end_attr INTEGER"
-                    ");");
-            db.exec("CREATE TABLE  IF NOT EXISTS " TX_TABLE "("
-                    "id INTEGER  NOT null PRIMARY KEY, "
-                    "generator INTEGER REFERENCES " GENERATOR_TABLE "(id), "
-                    "stream INTEGER REFERENCES " STREAM_TABLE "(id), "
-                    "concurrencyLevel INTEGER"
-                    ");");
-            db.exec("CREATE TABLE  IF NOT EXISTS " TX_EVENT_TABLE "("
-                    "tx INTEGER REFERENCES " TX_TABLE "(id), "
-                    "type INTEGER, "
-                    "time INTEGER"
-                    ");");
-            db.exec("CREATE TABLE  IF NOT EXISTS " TX_ATTRIBUTE_TABLE "("
-                    "tx INTEGER REFERENCES " TX_TABLE "(id), "
-                    "type INTEGER, "
-                    "name INTEGER REFERENCES " STRING_TABLE "(id), "
-                    "data_type INTEGER, "
-                    "data_value TEXT"
-                    ");");
-            db.exec("CREATE TABLE  IF NOT EXISTS " TX_RELATION_TABLE "("
-                    "name INTEGER REFERENCES " STRING_TABLE "(id), "
-                    "src INTEGER REFERENCES " TX_TABLE "(id), "
-                    "sink INTEGER REFERENCES " TX_TABLE "(id)"
-                    ");");
-            db.exec("CREATE TABLE IF NOT EXISTS " SIM_PROPS "(time_resolution INTEGER);");
-            if(with_transactions)
-                db.exec("BEGIN TRANSACTION");
-            std::ostringstream ss;
-            ss << "INSERT INTO " SIM_PROPS " (time_resolution) values (" << (long)(sc_core::sc_get_time_resolution().to_seconds() * 1e15)
-               << ");";
-            db.exec(ss.str().c_str());
-            string_stmt = db.prepare("INSERT INTO " STRING_TABLE " (id, value) values (@ID,@VALUE);");
-            stream_stmt = db.prepare("INSERT INTO " STREAM_TABLE " (id, name, kind) values (@ID,@NAME,@KIND);");
-            gen_stmt = db.prepare("INSERT INTO " GENERATOR_TABLE " (id,stream, name)"
-                                  " values (@ID,@STRM_DI,@NAME);");
-            tx_stmt = db.prepare("INSERT INTO " TX_TABLE " (id,generator,stream, concurrencyLevel)"
-                                 " values (@ID,@GEN_ID,@STREAM_ID,@CONC_LEVEL);");
-            evt_stmt = db.prepare("INSERT INTO " TX_EVENT_TABLE " (tx,type,time)"
-                                  " values (@TX_ID,@TYPE,@TIMESTAMP);");
-            attr_stmt = db.prepare("INSERT INTO " TX_ATTRIBUTE_TABLE " (tx,type,name,data_type,data_value) "
-                                   "values (@ID,@EVENTID,@NAME,@TYPE,@VALUE);");
-            rel_stmt = db.prepare("INSERT INTO " TX_RELATION_TABLE " (name,sink,src)"
-                                  "values (@NAME,@ID1,@ID2);");
+            remove((fName + "-wal").c_str());
+            remove((fName + "-shm").c_str());
+            writer.reset(new Writer);
+            writer->open(fName);
+            batch.reset(new Batch);
+            last_commit = std::chrono::steady_clock::now();
         } catch(SQLiteDB::SQLiteException& e) {
+            writer.reset();
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't open recording file");
         }
         break;
     case scv_tr_db::DELETE:
-        try {
-            // scv_out << "Transaction Recording is closing file: " <<
-            // my_sqlite_file_name << endl;
-            if(with_transactions)
-                db.exec("COMMIT TRANSACTION");
-            db.close();
-        } catch(SQLiteDB::SQLiteException& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't close recording file");
+        if(writer) {
+            flush();
+            auto error = writer->close();
+            writer.reset();
+            str_map.clear();
+            schemas.clear();
+            if(!error.empty())
+                _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, ("Can't write recording file: " + error).c_str());
         }
         break;
     default:
@@ -243,253 +439,155 @@ static void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason,
     }
 }
 // ----------------------------------------------------------------------------
-static std::unordered_map<std::string, uint64_t> str_map;
-uint64_t getStringId(std::string const& s) {
-    auto it = str_map.find(s);
-    if(it != std::end(str_map))
-        return it->second;
-    auto id = str_map.size();
-    str_map.insert({s, id});
-    try {
-        sqlite3_bind_int64(string_stmt, 1, id);
-        sqlite3_bind_text(string_stmt, 2, s.c_str(), -1, SQLITE_TRANSIENT);
-        db.exec(string_stmt);
-    } catch(SQLiteDB::SQLiteException& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create string entry");
-    }
-    return id;
-}
-// ----------------------------------------------------------------------------
 static void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, void* data) {
-    if(reason == scv_tr_stream::CREATE && db.isOpen()) {
-        try {
-            sqlite3_bind_int64(stream_stmt, 1, s.get_id());
-            sqlite3_bind_int64(stream_stmt, 2, getStringId(s.get_name()));
-            sqlite3_bind_int64(stream_stmt, 3, getStringId(s.get_stream_kind() ? s.get_stream_kind() : "<unnamed>"));
-            db.exec(stream_stmt);
-            if(concurrencyLevel.size() <= s.get_id())
-                concurrencyLevel.resize(s.get_id() + 1);
-            concurrencyLevel[s.get_id()] = new vector<uint64_t>();
-        } catch(SQLiteDB::SQLiteException& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create stream");
-        }
+    if(reason == scv_tr_stream::CREATE && writer) {
+        int64_t name = getStringId(s.get_name());
+        int64_t kind = getStringId(s.get_stream_kind() ? s.get_stream_kind() : "<unnamed>");
+        batch->streams.push_back({static_cast<int64_t>(s.get_id()), name, kind});
+        added_row();
     }
 }
 // ----------------------------------------------------------------------------
-void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, const string& value) {
-    try {
-        sqlite3_bind_int64(attr_stmt, 1, id);
-        sqlite3_bind_int64(attr_stmt, 2, event);
-        sqlite3_bind_int64(attr_stmt, 3, getStringId(name));
-        sqlite3_bind_int64(attr_stmt, 4, type);
-        sqlite3_bind_int64(attr_stmt, 5, getStringId(value));
-        db.exec(attr_stmt);
-    } catch(SQLiteDB::SQLiteException& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create attribute entry");
-    }
+void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, const string& value) {
+    int64_t value_id = getStringId(value);
+    batch->attributes.push_back({static_cast<int64_t>(id), event, static_cast<int64_t>(name), type, value_id});
+    added_row();
 }
 // ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, long long value) {
+inline void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, long long value) {
     recordAttribute(id, event, name, type, std::to_string(value));
 }
 // ----------------------------------------------------------------------------
-inline void recordAttribute(uint64_t id, EventType event, const string& name, data_type type, double value) {
+inline void recordAttribute(uint64_t id, EventType event, uint64_t name, data_type type, double value) {
     recordAttribute(id, event, name, type, std::to_string(value));
 }
 // ----------------------------------------------------------------------------
-static void recordAttributes(uint64_t id, EventType eventType, string& prefix, const scv_extensions_if* my_exts_p) {
-    if(my_exts_p == nullptr)
-        return;
-    string name;
-    if(prefix == "") {
-        name = my_exts_p->get_name();
-    } else {
-        if((my_exts_p->get_name() == nullptr) || (strlen(my_exts_p->get_name()) == 0)) {
-            name = prefix;
-        } else {
-            name = prefix + "." + my_exts_p->get_name();
+static void recordAttributes(uint64_t id, EventType eventType, scv_tr_schema<>& schema, const scv_extensions_if* my_exts_p) {
+    for(auto& attr : schema.attributes()) {
+        auto* leaf_p = scv_tr_schema<>::leaf(my_exts_p, attr);
+        if(!leaf_p)
+            continue;
+        auto name = attr.data;
+        switch(attr.type) {
+        case scv_extensions_if::ENUMERATION:
+            recordAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, leaf_p->get_enum_string((int)(leaf_p->get_integer())));
+            break;
+        case scv_extensions_if::BOOLEAN:
+            recordAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, leaf_p->get_bool() ? "TRUE" : "FALSE");
+            break;
+        case scv_extensions_if::INTEGER:
+        case scv_extensions_if::FIXED_POINT_INTEGER:
+            recordAttribute(id, eventType, name, scv_extensions_if::INTEGER, leaf_p->get_integer());
+            break;
+        case scv_extensions_if::UNSIGNED:
+            recordAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, leaf_p->get_integer());
+            break;
+        case scv_extensions_if::POINTER:
+            recordAttribute(id, eventType, name, scv_extensions_if::POINTER, (long long)leaf_p->get_pointer());
+            break;
+        case scv_extensions_if::STRING:
+            recordAttribute(id, eventType, name, scv_extensions_if::STRING, leaf_p->get_string());
+            break;
+        case scv_extensions_if::FLOATING_POINT_NUMBER:
+            recordAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, leaf_p->get_double());
+            break;
+        case scv_extensions_if::BIT_VECTOR: {
+            sc_bv_base tmp_bv(leaf_p->get_bitwidth());
+            leaf_p->get_value(tmp_bv);
+            recordAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
+        } break;
+        case scv_extensions_if::LOGIC_VECTOR: {
+            sc_lv_base tmp_lv(leaf_p->get_bitwidth());
+            leaf_p->get_value(tmp_lv);
+            recordAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
+        } break;
+        default: {
+            std::array<char, 100> tmpString{};
+            sprintf(tmpString.data(), "Unsupported attribute type = %d", attr.type);
+            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
         }
-    }
-    if(name == "")
-        name = "<unnamed>";
-    switch(my_exts_p->get_type()) {
-    case scv_extensions_if::RECORD: {
-        int num_fields = my_exts_p->get_num_fields();
-        if(num_fields > 0) {
-            for(int field_counter = 0; field_counter < num_fields; field_counter++) {
-                const scv_extensions_if* field_data_p = my_exts_p->get_field(field_counter);
-                recordAttributes(id, eventType, prefix, field_data_p);
-            }
         }
-    } break;
-    case scv_extensions_if::ENUMERATION:
-        recordAttribute(id, eventType, name, scv_extensions_if::ENUMERATION, my_exts_p->get_enum_string((int)(my_exts_p->get_integer())));
-        break;
-    case scv_extensions_if::BOOLEAN:
-        recordAttribute(id, eventType, name, scv_extensions_if::BOOLEAN, my_exts_p->get_bool() ? "TRUE" : "FALSE");
-        break;
-    case scv_extensions_if::INTEGER:
-    case scv_extensions_if::FIXED_POINT_INTEGER:
-        recordAttribute(id, eventType, name, scv_extensions_if::INTEGER, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::UNSIGNED:
-        recordAttribute(id, eventType, name, scv_extensions_if::UNSIGNED, my_exts_p->get_integer());
-        break;
-    case scv_extensions_if::POINTER:
-        recordAttribute(id, eventType, name, scv_extensions_if::POINTER, (long long)my_exts_p->get_pointer());
-        break;
-    case scv_extensions_if::STRING:
-        recordAttribute(id, eventType, name, scv_extensions_if::STRING, my_exts_p->get_string());
-        break;
-    case scv_extensions_if::FLOATING_POINT_NUMBER:
-        recordAttribute(id, eventType, name, scv_extensions_if::FLOATING_POINT_NUMBER, my_exts_p->get_double());
-        break;
-    case scv_extensions_if::BIT_VECTOR: {
-        sc_bv_base tmp_bv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_bv);
-        recordAttribute(id, eventType, name, scv_extensions_if::BIT_VECTOR, tmp_bv.to_string());
-    } break;
-    case scv_extensions_if::LOGIC_VECTOR: {
-        sc_lv_base tmp_lv(my_exts_p->get_bitwidth());
-        my_exts_p->get_value(tmp_lv);
-        recordAttribute(id, eventType, name, scv_extensions_if::LOGIC_VECTOR, tmp_lv.to_string());
-    } break;
-    case scv_extensions_if::ARRAY:
-        for(int array_elt_index = 0; array_elt_index < my_exts_p->get_array_size(); array_elt_index++) {
-            const scv_extensions_if* field_data_p = my_exts_p->get_array_elt(array_elt_index);
-            recordAttributes(id, eventType, prefix, field_data_p);
-        }
-        break;
-    default: {
-        std::array<char, 100> tmpString{};
-        sprintf(tmpString.data(), "Unsupported attribute type = %d", my_exts_p->get_type());
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, tmpString.data());
-    }
     }
 }
 // ----------------------------------------------------------------------------
 static void generatorCb(const scv_tr_generator_base& g, scv_tr_generator_base::callback_reason reason, void* data) {
-    if(reason == scv_tr_generator_base::CREATE && db.isOpen()) {
-        try {
-            sqlite3_bind_int64(gen_stmt, 1, g.get_id());
-            sqlite3_bind_int64(gen_stmt, 2, g.get_scv_tr_stream().get_id());
-            sqlite3_bind_int64(gen_stmt, 3, getStringId(g.get_name()));
-            db.exec(gen_stmt);
-        } catch(SQLiteDB::SQLiteException& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create generator entry");
-        }
+    if(reason == scv_tr_generator_base::CREATE && writer) {
+        int64_t name = getStringId(g.get_name());
+        batch->generators.push_back({static_cast<int64_t>(g.get_id()), static_cast<int64_t>(g.get_scv_tr_stream().get_id()), name});
+        added_row();
     }
 }
 // ----------------------------------------------------------------------------
 static void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason reason, void* data) {
-    if(!db.isOpen())
+    if(!writer)
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db() == nullptr)
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
 
-    uint64_t id = t.get_id();
+    int64_t id = t.get_id();
     uint64_t streamId = t.get_scv_tr_stream().get_id();
-    vector<uint64_t>::size_type concurrencyIdx;
     const scv_extensions_if* my_exts_p;
     switch(reason) {
     case scv_tr_handle::BEGIN: {
-        try {
-            if(concurrencyLevel.size() <= streamId)
-                concurrencyLevel.resize(streamId + 1);
-            vector<uint64_t>* levels = concurrencyLevel[streamId];
-            if(levels == nullptr) {
-                levels = new vector<uint64_t>();
-                concurrencyLevel[id] = levels;
-            }
-            for(concurrencyIdx = 0; concurrencyIdx < levels->size(); ++concurrencyIdx)
-                if((*levels)[concurrencyIdx] == 0)
-                    break;
-            if(concurrencyIdx == levels->size())
-                levels->push_back(id);
-            else
-                (*levels)[concurrencyIdx] = id;
-
-            sqlite3_bind_int64(tx_stmt, 1, id);
-            sqlite3_bind_int64(tx_stmt, 2, t.get_scv_tr_generator_base().get_id());
-            sqlite3_bind_int64(tx_stmt, 3, t.get_scv_tr_stream().get_id());
-            sqlite3_bind_int64(tx_stmt, 3, concurrencyIdx);
-            db.exec(tx_stmt);
-
-            sqlite3_bind_int64(evt_stmt, 1, id);
-            sqlite3_bind_int(evt_stmt, 2, BEGIN);
-            sqlite3_bind_int64(evt_stmt, 3, t.get_begin_sc_time().value());
-            db.exec(evt_stmt);
-
-        } catch(SQLiteDB::SQLiteException& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, e.errorMessage());
-        }
+        auto& levels = concurrencyLevel[streamId];
+        auto it = std::find(levels.begin(), levels.end(), 0);
+        if(it == levels.end())
+            it = levels.insert(it, id);
+        else
+            *it = id;
+        batch->txs.push_back({id, static_cast<int64_t>(t.get_scv_tr_generator_base().get_id()), static_cast<int64_t>(streamId),
+                              static_cast<int64_t>(it - levels.begin())});
+        added_row();
+        batch->events.push_back({id, BEGIN, static_cast<int64_t>(t.get_begin_sc_time().value())});
+        added_row();
         my_exts_p = t.get_begin_exts_p();
         if(my_exts_p == nullptr) {
             my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
         }
-        string tmp_str =
-            t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-        recordAttributes(id, BEGIN, tmp_str, my_exts_p);
+        if(my_exts_p)
+            recordAttributes(id, BEGIN, schemas.get(t.get_scv_tr_generator_base(), false, my_exts_p), my_exts_p);
     } break;
     case scv_tr_handle::END: {
-        try {
-            vector<uint64_t>* levels = concurrencyLevel[streamId];
-            for(concurrencyIdx = 0; concurrencyIdx < levels->size(); ++concurrencyIdx)
-                if((*levels)[concurrencyIdx] == id)
-                    break;
-            if(concurrencyIdx == levels->size())
-                levels->push_back(id);
-            else
-                levels->at(concurrencyIdx) = id;
-
-            sqlite3_bind_int64(evt_stmt, 1, t.get_id());
-            sqlite3_bind_int(evt_stmt, 2, END);
-            sqlite3_bind_int64(evt_stmt, 3, t.get_end_sc_time().value());
-            db.exec(evt_stmt);
-
-        } catch(SQLiteDB::SQLiteException& e) {
-            _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create transaction end");
-        }
+        auto& levels = concurrencyLevel[streamId];
+        auto it = std::find(levels.begin(), levels.end(), id);
+        if(it != levels.end())
+            *it = 0;
+        batch->events.push_back({id, END, static_cast<int64_t>(t.get_end_sc_time().value())});
+        added_row();
         my_exts_p = t.get_end_exts_p();
         if(my_exts_p == nullptr) {
             my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
         }
-        string tmp_str =
-            t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-        recordAttributes(t.get_id(), END, tmp_str, my_exts_p);
+        if(my_exts_p)
+            recordAttributes(t.get_id(), END, schemas.get(t.get_scv_tr_generator_base(), true, my_exts_p), my_exts_p);
     } break;
     default:;
     }
 }
 // ----------------------------------------------------------------------------
 static void attributeCb(const scv_tr_handle& t, const char* name, const scv_extensions_if* ext, void* data) {
-    if(!db.isOpen())
+    if(!writer)
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db() == nullptr)
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    string tmp_str(name == nullptr ? "" : name);
-    recordAttributes(t.get_id(), RECORD, tmp_str, ext);
+    if(ext)
+        recordAttributes(t.get_id(), RECORD, schemas.get(name, ext), ext);
 }
 // ----------------------------------------------------------------------------
 static void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
-    if(!db.isOpen())
+    if(!writer)
         return;
     if(tr_1.get_scv_tr_stream().get_scv_tr_db() == nullptr)
         return;
     if(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    try {
-        sqlite3_bind_int64(rel_stmt, 1, getStringId(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_relation_name(relation_handle)));
-        sqlite3_bind_int64(rel_stmt, 2, tr_1.get_id());
-        sqlite3_bind_int64(rel_stmt, 3, tr_2.get_id());
-        db.exec(rel_stmt);
-    } catch(SQLiteDB::SQLiteException& e) {
-        _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create transaction relation");
-    }
+    int64_t name = getStringId(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_relation_name(relation_handle));
+    batch->relations.push_back({name, static_cast<int64_t>(tr_1.get_id()), static_cast<int64_t>(tr_2.get_id())});
+    added_row();
 }
 // ----------------------------------------------------------------------------
 void scv_tr_sqlite_init() {
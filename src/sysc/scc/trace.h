@@ -18,7 +18,9 @@
 #define SCC_TRACE_H
 
 #include "observer.h"
+#include <cstdint>
 #include <functional>
+#include <sysc/kernel/sc_time.h>
 #include <sysc/tracing/sc_trace.h>
 
 /** \ingroup scc-sysc
@@ -27,25 +29,81 @@
 /**@{*/
 //! @brief SCC SystemC utilities
 namespace scc {
+/**
+ * @struct trace_rotation
+ * @brief controls the splitting of a waveform trace into self-contained chunks
+ *
+ * If a limit is set the trace file is written as numbered chunks (e.g. name.0.vcd, name.1.vcd, ...) each
+ * starting with the complete signal state. An index file (name.vcd.idx resp. name.fst.idx) lists the time
+ * range covered by each chunk. A value of 0 disables the respective limit.
+ */
+struct trace_rotation {
+    //! maximum size of a chunk in bytes
+    uint64_t max_size{0};
+    //! maximum simulated time covered by a chunk
+    sc_core::sc_time max_time{sc_core::SC_ZERO_TIME};
+    //! returns true if any limit is set
+    bool enabled() const { return max_size > 0 || max_time > sc_core::SC_ZERO_TIME; }
+};
+/**
+ * @struct sampling_policy
+ * @brief reduces the number of value changes being recorded for a signal
+ *
+ * Signals with an active policy are not compared at every time step of the trace file. If every_nth is larger than 1
+ * only every n-th time step is considered, if min_interval is set a change is only recorded if the previously recorded
+ * change is at least min_interval ago. Changes in between are coalesced into the value seen at the next recorded
+ * time step, glitches shorter than the interval are suppressed.
+ */
+struct sampling_policy {
+    //! consider only every n-th time step of the trace file, 0 and 1 consider all
+    unsigned every_nth{0};
+    //! minimum distance between two recorded changes
+    sc_core::sc_time min_interval{sc_core::SC_ZERO_TIME};
+    //! returns true if any reduction is set
+    bool active() const { return every_nth > 1 || min_interval > sc_core::SC_ZERO_TIME; }
+};
+/**
+ * @struct sampling_control
+ * @brief interface of trace files supporting sampling policies
+ */
+struct sampling_control {
+    //! set the policy being applied to all subsequently traced objects
+    virtual void set_sampling_policy(sampling_policy const& policy) = 0;
+
+    virtual ~sampling_control() = default;
+};
 //! create VCD file which uses pull mechanism
 sc_core::sc_trace_file* create_vcd_pull_trace_file(const char* name, std::function<bool()> enable = std::function<bool()>());
+//! create VCD file which uses pull mechanism and is split into chunks
+sc_core::sc_trace_file* create_vcd_pull_trace_file(const char* name, std::function<bool()> enable, trace_rotation const& rotation);
 //! close the VCD file
 void close_vcd_pull_trace_file(sc_core::sc_trace_file* tf);
 
 //! create VCD file which uses push mechanism
 sc_core::sc_trace_file* create_vcd_push_trace_file(const char* name, std::function<bool()> enable = std::function<bool()>());
+//! create VCD file which uses push mechanism and is split into chunks
+sc_core::sc_trace_file* create_vcd_push_trace_file(const char* name, std::function<bool()> enable, trace_rotation const& rotation);
 //! close the VCD file
 void close_vcd_push_trace_file(sc_core::sc_trace_file* tf);
 
 //! create compressed VCD file which uses push mechanism and multithreading
 sc_core::sc_trace_file* create_vcd_mt_trace_file(const char* name, std::function<bool()> enable = std::function<bool()>());
+//! create compressed VCD file which uses push mechanism and multithreading and is split into chunks
+sc_core::sc_trace_file* create_vcd_mt_trace_file(const char* name, std::function<bool()> enable, trace_rotation const& rotation);
 //! close the VCD file
 void close_vcd_mt_trace_file(sc_core::sc_trace_file* tf);
 
 //! create FST file which uses pull mechanism
 sc_core::sc_trace_file* create_fst_trace_file(const char* name, std::function<bool()> enable = std::function<bool()>());
+//! create FST file which uses pull mechanism and is split into chunks
+sc_core::sc_trace_file* create_fst_trace_file(const char* name, std::function<bool()> enable, trace_rotation const& rotation);
 //! close the FST file
 void close_fst_trace_file(sc_core::sc_trace_file* tf);
+
+//! create columnar waveform (CWF) file with indexed LZ4 compressed blocks, see util::cwf_reader for access
+sc_core::sc_trace_file* create_cwf_trace_file(const char* name, std::function<bool()> enable = std::function<bool()>());
+//! close the CWF file
+void close_cwf_trace_file(sc_core::sc_trace_file* tf);
 } // namespace scc
 /** @} */ // end of scc-sysc
 #endif    // SCC_SC_VCD_TRACE_H
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#ifndef _SCC_TRACE_CHUNK_INDEX_HH_
+#define _SCC_TRACE_CHUNK_INDEX_HH_
+
+#include "time_stamp.hh"
+#include <scc/trace.h>
+#include <cstdio>
+#include <fmt/format.h>
+#include <string>
+
+namespace scc {
+namespace trace {
+/**
+ * @brief keeps track of the chunks of a rotated waveform file
+ *
+ * Each finished chunk is appended to the index file as line '<chunk> <start ps> <end ps> <file name>'. The index
+ * is flushed after each entry so that it is usable even if the simulation does not terminate regularly.
+ */
+class chunk_index {
+public:
+    chunk_index(std::string const& basename, std::string const& extension, trace_rotation const& rotation)
+    : basename(basename)
+    , extension(extension)
+    , max_size(rotation.max_size)
+    , max_time_ps(rotation.max_time > sc_core::SC_ZERO_TIME ? to_ps(rotation.max_time) : 0) {
+        if(enabled())
+            idx_out = fopen(fmt::format("{}.{}.idx", basename, extension).c_str(), "w");
+    }
+
+    ~chunk_index() {
+        if(idx_out)
+            fclose(idx_out);
+    }
+
+    chunk_index(chunk_index const&) = delete;
+    chunk_index& operator=(chunk_index const&) = delete;
+
+    bool enabled() const { return max_size > 0 || max_time_ps > 0; }
+    //! the name of the file the current chunk has to be written to
+    std::string file_name() const {
+        return enabled() ? fmt::format("{}.{}.{}", basename, chunk, extension) : fmt::format("{}.{}", basename, extension);
+    }
+    //! check if a new chunk needs to be started before emitting time stamp ts_ps
+    bool needs_rotation(uint64_t ts_ps, uint64_t size) const {
+        if(!enabled() || ts_ps == start_ps)
+            return false;
+        return (max_size && size >= max_size) || (max_time_ps && ts_ps - start_ps >= max_time_ps);
+    }
+    //! record the end of the current chunk and start the next one at ts_ps
+    void rotate(uint64_t ts_ps) {
+        add_entry(ts_ps);
+        ++chunk;
+        start_ps = first_ps = ts_ps;
+    }
+    //! extend the time range listed for the current chunk to ts_ps if the time stamps are not written in order
+    void cover(uint64_t ts_ps) {
+        if(ts_ps < first_ps)
+            first_ps = ts_ps;
+    }
+    //! record the end of the last chunk
+    void finish(uint64_t ts_ps) {
+        if(idx_out) {
+            add_entry(ts_ps);
+            fclose(idx_out);
+            idx_out = nullptr;
+        }
+    }
+
+private:
+    void add_entry(uint64_t end_ps) {
+        if(idx_out) {
+            auto buf = fmt::format("{} {} {} {}\n", chunk, first_ps, end_ps, file_name());
+            std::fwrite(buf.c_str(), 1, buf.size(), idx_out);
+            fflush(idx_out);
+        }
+    }
+    const std::string basename;
+    const std::string extension;
+    const uint64_t max_size;
+    const uint64_t max_time_ps;
+    FILE* idx_out{nullptr};
+    unsigned chunk{0};
+    //! the time the current chunk started, the base of the time limit
+    uint64_t start_ps{0};
+    //! the earliest time stamp written to the current chunk
+    uint64_t first_ps{0};
+};
+} // namespace trace
+} // namespace scc
+#endif /* _SCC_TRACE_CHUNK_INDEX_HH_ */
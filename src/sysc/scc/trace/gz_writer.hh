@@ -31,6 +31,7 @@ class gz_writer {
     std::deque<char*> pool_buffer;
     gzFile vcd_out{nullptr};
     std::thread logger;
+    uint64_t bytes_written{0};
 
     inline void write_out(){
         while (!write_queue.empty()) {
@@ -85,8 +86,12 @@ public:
         for(auto b:pool_buffer) delete b;
     }
 
+    //! the number of uncompressed bytes handed to the writer so far
+    inline uint64_t size() const { return bytes_written; }
+
     inline void write_single(std::string const& msg){
         lock_type lock(writer_mtx);
+        bytes_written += msg.length();
         if(pool.empty()) enlarge_pool();
         auto value = pool.front();
         pool.pop_front();
@@ -94,6 +99,7 @@ public:
         write_queue.push_back(value);
     }
     inline void write(std::string const& msg){
+        bytes_written += msg.length();
         if(pool.empty()) enlarge_pool();
 //        auto value = pool.front();
 //        pool.pop_front();
@@ -101,6 +107,7 @@ public:
 //        write_queue.push_back(value);
     }
     inline void write(char const* msg, size_t size){
+        bytes_written += size;
         if(pool.empty()) enlarge_pool();
 //        auto value = pool.front();
 //        pool.pop_front();
@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#ifndef _SCC_TRACE_HIERARCHY_FILTER_HH_
+#define _SCC_TRACE_HIERARCHY_FILTER_HH_
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace scc {
+namespace trace {
+/**
+ * @brief include/exclude filter for hierarchical names
+ *
+ * The patterns are lists separated by comma, semicolon or white space. Each pattern consists of '.' separated
+ * segments which are matched against the segments of a hierarchical name using glob syntax ('*', '?', '[...]'). A
+ * segment '**' matches any number of hierarchy levels. A pattern selects the matching object and its complete
+ * subtree, excludes take precedence over includes. If no include pattern is given everything not excluded is
+ * selected.
+ *
+ * The patterns are compiled into a trie over the segments. While walking the design hierarchy depth-first via
+ * enter() only the trie nodes reachable by the current path are tracked, so subtrees which are excluded or cannot be
+ * reached by any include pattern can be skipped without visiting their children.
+ */
+class hierarchy_filter {
+public:
+    enum decision { UNDECIDED, INCLUDED, EXCLUDED };
+
+    hierarchy_filter(std::string const& includes, std::string const& excludes) {
+        has_includes = compile(inc_root, includes);
+        has_excludes = compile(exc_root, excludes);
+        stack.emplace_back();
+        auto& root = stack.back();
+        add_closure(root.inc, &inc_root);
+        add_closure(root.exc, &exc_root);
+    }
+
+    hierarchy_filter(hierarchy_filter const&) = delete;
+    hierarchy_filter& operator=(hierarchy_filter const&) = delete;
+    //! true if no pattern is given at all
+    bool empty() const { return !has_includes && !has_excludes; }
+    /**
+     * @brief determine the decision for the object with the hierarchical name and make it the current path
+     *
+     * The names need to be passed in depth-first order, the previous path is unwound up to the closest ancestor.
+     */
+    decision enter(std::string const& name) {
+        while(stack.size() > 1 && !is_ancestor(stack.back().name, name)) {
+            auto cnt = stack.back().count;
+            finish(stack.back());
+            stack.pop_back();
+            stack.back().count += cnt;
+        }
+        auto pos = stack.back().name.size();
+        if(pos)
+            ++pos; // skip the separator
+        while(pos <= name.size()) {
+            auto end = name.find('.', pos);
+            if(end == std::string::npos)
+                end = name.size();
+            state next;
+            next.name = name.substr(0, end);
+            advance(stack.back(), next, name.c_str() + pos, end - pos);
+            stack.emplace_back(std::move(next));
+            pos = end + 1;
+        }
+        return stack.back().dec;
+    }
+    //! the decision of the current path
+    decision current_decision() const { return stack.back().dec; }
+    //! returns true if no object in the subtree of the current path can be selected
+    bool prune() const {
+        auto& s = stack.back();
+        return s.dec == EXCLUDED || (s.dec == UNDECIDED && has_includes && s.inc.empty());
+    }
+    //! returns true if the object of the current path is selected
+    bool selected() const {
+        auto& s = stack.back();
+        return s.dec == INCLUDED || (s.dec == UNDECIDED && !has_includes);
+    }
+    //! count a traced object in the current path
+    void count() { stack.back().count++; }
+    //! set the depth up to which the number of traced objects is collected, top level objects have depth 1
+    void set_report_depth(unsigned depth) { report_depth = depth; }
+    //! unwind the remaining path and return the number of traced objects per subtree
+    std::vector<std::pair<std::string, unsigned>> report() {
+        while(stack.size() > 1) {
+            auto cnt = stack.back().count;
+            finish(stack.back());
+            stack.pop_back();
+            stack.back().count += cnt;
+        }
+        stack.back().count = 0;
+        std::vector<std::pair<std::string, unsigned>> ret(std::begin(counts), std::end(counts));
+        counts.clear();
+        return ret;
+    }
+
+private:
+    struct node {
+        std::string pattern;
+        bool terminal{false};
+        std::vector<std::unique_ptr<node>> children;
+        node* any_depth{nullptr};
+    };
+    struct state {
+        std::string name;
+        std::vector<node const*> inc, exc;
+        decision dec{UNDECIDED};
+        unsigned count{0};
+    };
+
+    static bool compile(node& root, std::string const& patterns) {
+        bool any = false;
+        size_t pos = 0;
+        while(pos < patterns.size()) {
+            auto end = patterns.find_first_of(",; \t\n", pos);
+            if(end == std::string::npos)
+                end = patterns.size();
+            if(end > pos) {
+                add_pattern(root, patterns.substr(pos, end - pos));
+                any = true;
+            }
+            pos = end + 1;
+        }
+        return any;
+    }
+
+    static void add_pattern(node& root, std::string const& pattern) {
+        node* n = &root;
+        size_t pos = 0;
+        while(pos <= pattern.size()) {
+            auto end = pattern.find('.', pos);
+            if(end == std::string::npos)
+                end = pattern.size();
+            auto seg = pattern.substr(pos, end - pos);
+            auto it = std::find_if(std::begin(n->children), std::end(n->children),
+                                   [&seg](std::unique_ptr<node> const& c) { return c->pattern == seg; });
+            if(it == std::end(n->children)) {
+                n->children.emplace_back(new node);
+                n->children.back()->pattern = seg;
+                if(seg == "**")
+                    n->any_depth = n->children.back().get();
+                it = std::prev(std::end(n->children));
+            }
+            n = it->get();
+            pos = end + 1;
+        }
+        n->terminal = true;
+    }
+
+    static bool is_ancestor(std::string const& anc, std::string const& name) {
+        return anc.size() < name.size() && name[anc.size()] == '.' && name.compare(0, anc.size(), anc) == 0;
+    }
+
+    static void add_closure(std::vector<node const*>& nodes, node const* n) {
+        if(std::find(std::begin(nodes), std::end(nodes), n) != std::end(nodes))
+            return;
+        nodes.push_back(n);
+        if(n->any_depth)
+            add_closure(nodes, n->any_depth);
+    }
+
+    static bool step(std::vector<node const*> const& from, std::vector<node const*>& to, char const* seg, size_t len) {
+        for(auto n : from) {
+            if(n->pattern == "**")
+                add_closure(to, n);
+            for(auto& c : n->children)
+                if(c.get() != n->any_depth && glob_match(c->pattern.c_str(), seg, seg + len))
+                    add_closure(to, c.get());
+        }
+        return std::any_of(std::begin(to), std::end(to), [](node const* n) { return n->terminal; });
+    }
+
+    void advance(state const& parent, state& next, char const* seg, size_t len) const {
+        next.dec = parent.dec;
+        if(next.dec == EXCLUDED)
+            return;
+        if(step(parent.exc, next.exc, seg, len)) {
+            next.dec = EXCLUDED;
+            next.exc.clear();
+            return;
+        }
+        if(next.dec == INCLUDED)
+            return;
+        if(step(parent.inc, next.inc, seg, len)) {
+            next.dec = INCLUDED;
+            next.inc.clear();
+        }
+    }
+
+    void finish(state const& s) {
+        if(s.count && report_depth && static_cast<unsigned>(std::count(std::begin(s.name), std::end(s.name), '.')) < report_depth)
+            counts[s.name] += s.count;
+    }
+
+    static bool glob_match(char const* p, char const* s, char const* end) {
+        while(*p) {
+            switch(*p) {
+            case '*':
+                while(*p == '*')
+                    ++p;
+                if(!*p)
+                    return true;
+                for(; s <= end; ++s)
+                    if(glob_match(p, s, end))
+                        return true;
+                return false;
+            case '?':
+                if(s == end)
+                    return false;
+                break;
+            case '[': {
+                if(s == end)
+                    return false;
+                auto close = strchr(p + 1, ']');
+                if(!close)
+                    return false;
+                bool negate = p[1] == '!' || p[1] == '^';
+                bool found = false;
+                for(auto c = p + (negate ? 2 : 1); c < close; ++c) {
+                    if(c + 2 < close && c[1] == '-') {
+                        found |= *s >= c[0] && *s <= c[2];
+                        c += 2;
+                    } else
+                        found |= *s == *c;
+                }
+                if(found == negate)
+                    return false;
+                p = close;
+            } break;
+            default:
+                if(s == end || *p != *s)
+                    return false;
+            }
+            ++p;
+            ++s;
+        }
+        return s == end;
+    }
+
+    node inc_root, exc_root;
+    bool has_includes{false}, has_excludes{false};
+    std::vector<state> stack;
+    unsigned report_depth{0};
+    std::map<std::string, unsigned> counts;
+};
+} // namespace trace
+} // namespace scc
+#endif /* _SCC_TRACE_HIERARCHY_FILTER_HH_ */
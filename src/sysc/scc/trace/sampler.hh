@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#ifndef _SCC_TRACE_SAMPLER_HH_
+#define _SCC_TRACE_SAMPLER_HH_
+
+#include "time_stamp.hh"
+#include <cstdint>
+#include <memory>
+#include <scc/trace.h>
+#include <vector>
+
+namespace scc {
+namespace trace {
+/**
+ * @brief applies a sampling_policy to the traced objects
+ *
+ * Traced objects with a sampler are always pulled by the trace file, the sampler decides at which time steps the
+ * comparison takes place. A sampler is shared by all objects of a trace file being traced with the same policy, the
+ * time of the last recorded change is kept per object.
+ */
+struct sampler {
+    explicit sampler(sampling_policy const& policy)
+    : every_nth(policy.every_nth > 1 ? policy.every_nth : 1)
+    , min_interval_ps(policy.min_interval > sc_core::SC_ZERO_TIME ? to_ps(policy.min_interval) : 0) {}
+    //! returns true if an object whose last change was recorded at last_ps shall be compared at time step step taking
+    //! place at time_ps
+    bool due(uint64_t step, uint64_t time_ps, uint64_t last_ps) const {
+        return step % every_nth == 0 && time_ps - last_ps >= min_interval_ps;
+    }
+
+    const uint64_t every_nth;
+    const uint64_t min_interval_ps;
+};
+//! returns the sampler of samplers applying the policy, it is created if there is none yet
+inline sampler* get_sampler(std::vector<std::unique_ptr<sampler>>& samplers, sampling_policy const& policy) {
+    sampler s(policy);
+    for(auto& e : samplers)
+        if(e->every_nth == s.every_nth && e->min_interval_ps == s.min_interval_ps)
+            return e.get();
+    samplers.emplace_back(new sampler(s));
+    return samplers.back().get();
+}
+} // namespace trace
+} // namespace scc
+#endif /* _SCC_TRACE_SAMPLER_HH_ */
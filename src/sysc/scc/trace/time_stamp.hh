@@ -0,0 +1,37 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+#ifndef _SCC_TRACE_TIME_STAMP_HH_
+#define _SCC_TRACE_TIME_STAMP_HH_
+
+#include <cstdint>
+#include <sysc/kernel/sc_time.h>
+
+namespace scc {
+namespace trace {
+/**
+ * @brief converts a time into ps, the unit of the time stamps of the trace files
+ *
+ * The time resolution of the kernel might be coarser than 1ps so dividing by the value of sc_time(1, SC_PS) is not
+ * possible. As the resolution is a power of 10 of seconds the conversion is a multiplication respectively a division
+ * by an integral factor.
+ */
+inline uint64_t to_ps(sc_core::sc_time const& t) {
+    static const double res_ps = sc_core::sc_get_time_resolution().to_seconds() * 1e12;
+    return res_ps >= 1.0 ? t.value() * static_cast<uint64_t>(res_ps + 0.5) : t.value() / static_cast<uint64_t>(1.0 / res_ps + 0.5);
+}
+} // namespace trace
+} // namespace scc
+#endif /* _SCC_TRACE_TIME_STAMP_HH_ */
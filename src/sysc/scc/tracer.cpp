@@ -49,6 +49,11 @@ using namespace scc;
 static char const* const tx_trace_type_name = "scc_tracer.tx_trace_type";
 static char const* const sig_trace_type_name = "scc_tracer.sig_trace_type";
 static char const* const close_db_in_eos_name = "scc_tracer.close_db_in_eos";
+static char const* const tx_trace_async_name = "scc_tracer.tx_trace_async";
+static char const* const sig_trace_chunk_size_name = "scc_tracer.sig_trace_chunk_size";
+static char const* const sig_trace_chunk_time_name = "scc_tracer.sig_trace_chunk_time";
+static char const* const tx_trace_chunk_time_name = "scc_tracer.tx_trace_chunk_time";
+static char const* const tx_trace_chunk_size_name = "scc_tracer.tx_trace_chunk_size";
 
 tracer::tracer(std::string const&& name, file_type tx_type, file_type sig_type, sc_core::sc_object* top, sc_core::sc_module_name const& nm)
 : tracer_base(nm)
@@ -60,19 +65,27 @@ tracer::tracer(std::string const&& name, file_type tx_type, file_type sig_type,
     if(sig_type == ENABLE)
         sig_type = static_cast<file_type>(sig_trace_type_handle.get_cci_value().get<unsigned>());
     if(sig_type != NONE) {
+        trace_rotation rotation;
+        rotation.max_size = sig_trace_chunk_size_handle.get_cci_value().get<sc_dt::uint64>();
+        rotation.max_time = sig_trace_chunk_time_handle.get_cci_value().get<sc_core::sc_time>();
         switch(sig_type) {
         default:
             trf = sc_create_vcd_trace_file(name.c_str());
             break;
         case PULL_VCD:
-            trf = scc::create_vcd_pull_trace_file(name.c_str());
+            trf = scc::create_vcd_pull_trace_file(name.c_str(), std::function<bool()>(), rotation);
             break;
         case PUSH_VCD:
-            trf = scc::create_vcd_push_trace_file(name.c_str());
+            trf = scc::create_vcd_push_trace_file(name.c_str(), std::function<bool()>(), rotation);
             break;
         case FST:
-            trf = scc::create_fst_trace_file(name.c_str());
+            trf = scc::create_fst_trace_file(name.c_str(), std::function<bool()>(), rotation);
             break;
+#ifdef WITH_CWF
+        case CWF:
+            trf = scc::create_cwf_trace_file(name.c_str());
+            break;
+#endif
         }
     }
     if(trf)
@@ -101,6 +114,7 @@ tracer::~tracer() {
 
 void tracer::init_tx_db(file_type type, std::string const&& name) {
     if(type != NONE) {
+        auto async = tx_trace_async_handle.get_cci_value().get<bool>();
         std::stringstream ss;
         ss << name;
         switch(type) {
@@ -113,13 +127,13 @@ void tracer::init_tx_db(file_type type, std::string const&& name) {
             auto level = val ? atoi(val) : std::numeric_limits<unsigned>::max();
             switch(level) {
             case 0:
-                SCVNS scv_tr_plain_init();
+                SCVNS scv_tr_plain_init(async);
                 break;
             case 2:
                 SCVNS scv_tr_compressed_init();
                 break;
             default:
-                SCVNS scv_tr_lz4_init();
+                SCVNS scv_tr_lz4_init(async);
                 break;
             }
             ss << ".txlog";
@@ -131,10 +145,12 @@ void tracer::init_tx_db(file_type type, std::string const&& name) {
             break;
 #endif
         case FTR:
-            SCVNS scv_tr_ftr_init(false);
+            SCVNS scv_tr_ftr_init(false, async, tx_trace_chunk_time_handle.get_cci_value().get<sc_core::sc_time>(),
+                                  tx_trace_chunk_size_handle.get_cci_value().get<sc_dt::uint64>());
             break;
         case CFTR:
-            SCVNS scv_tr_ftr_init(true);
+            SCVNS scv_tr_ftr_init(true, async, tx_trace_chunk_time_handle.get_cci_value().get<sc_core::sc_time>(),
+                                  tx_trace_chunk_size_handle.get_cci_value().get<sc_dt::uint64>());
             break;
         case LWFTR:
             lwtr::tx_ftr_init(false);
@@ -144,7 +160,7 @@ void tracer::init_tx_db(file_type type, std::string const&& name) {
             break;
         case CUSTOM:
             SCVNS scv_tr_mtc_init();
-            ss << ".txlog";
+            ss << ".txmtc";
             break;
         }
         if(type == LWFTR || type == LWCFTR) {
@@ -160,8 +176,10 @@ void tracer::init_tx_db(file_type type, std::string const&& name) {
 
 void tracer::end_of_elaboration() {
     if(trf) {
+        init_filter();
         for(auto o : sc_get_top_level_objects())
             descend(o, default_trace_enable_handle.get_cci_value().get<bool>());
+        report_filter();
     }
 }
 
@@ -200,4 +218,41 @@ void tracer::init_cci_handles() {
             cci::CCI_ABSOLUTE_NAME);
         close_db_in_eos_handle = cci_broker.get_param_handle(close_db_in_eos_name);
     }
+    tx_trace_async_handle = cci_broker.get_param_handle(tx_trace_async_name);
+    if(!tx_trace_async_handle.is_valid()) {
+        tx_trace_async = scc::make_unique<cci::cci_param<bool>>(
+            tx_trace_async_name, false,
+            "Format and write transaction records in a background thread (text and FTR databases only)", cci::CCI_ABSOLUTE_NAME);
+        tx_trace_async_handle = cci_broker.get_param_handle(tx_trace_async_name);
+    }
+    sig_trace_chunk_size_handle = cci_broker.get_param_handle(sig_trace_chunk_size_name);
+    if(!sig_trace_chunk_size_handle.is_valid()) {
+        sig_trace_chunk_size = scc::make_unique<cci::cci_param<sc_dt::uint64>>(
+            sig_trace_chunk_size_name, 0, "Size in bytes after which the signal trace is continued in a new chunk (0 disables rotation)",
+            cci::CCI_ABSOLUTE_NAME);
+        sig_trace_chunk_size_handle = cci_broker.get_param_handle(sig_trace_chunk_size_name);
+    }
+    sig_trace_chunk_time_handle = cci_broker.get_param_handle(sig_trace_chunk_time_name);
+    if(!sig_trace_chunk_time_handle.is_valid()) {
+        sig_trace_chunk_time = scc::make_unique<cci::cci_param<sc_core::sc_time>>(
+            sig_trace_chunk_time_name, sc_core::SC_ZERO_TIME,
+            "Simulated time after which the signal trace is continued in a new chunk (0 disables rotation)", cci::CCI_ABSOLUTE_NAME);
+        sig_trace_chunk_time_handle = cci_broker.get_param_handle(sig_trace_chunk_time_name);
+    }
+    tx_trace_chunk_time_handle = cci_broker.get_param_handle(tx_trace_chunk_time_name);
+    if(!tx_trace_chunk_time_handle.is_valid()) {
+        tx_trace_chunk_time = scc::make_unique<cci::cci_param<sc_core::sc_time>>(
+            tx_trace_chunk_time_name, sc_core::SC_ZERO_TIME,
+            "Simulated time after which the FTR transaction database is continued in a new chunk (0 disables chunking)",
+            cci::CCI_ABSOLUTE_NAME);
+        tx_trace_chunk_time_handle = cci_broker.get_param_handle(tx_trace_chunk_time_name);
+    }
+    tx_trace_chunk_size_handle = cci_broker.get_param_handle(tx_trace_chunk_size_name);
+    if(!tx_trace_chunk_size_handle.is_valid()) {
+        tx_trace_chunk_size = scc::make_unique<cci::cci_param<sc_dt::uint64>>(
+            tx_trace_chunk_size_name, 0,
+            "Size in bytes after which the FTR transaction database is continued in a new chunk (0 disables size based chunking)",
+            cci::CCI_ABSOLUTE_NAME);
+        tx_trace_chunk_size_handle = cci_broker.get_param_handle(tx_trace_chunk_size_name);
+    }
 }
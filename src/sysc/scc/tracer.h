@@ -70,7 +70,8 @@ public:
         SC_VCD = TEXT,
         PULL_VCD = COMPRESSED,
         PUSH_VCD = SQLITE,
-        FST
+        FST,
+        CWF
     };
 
     /**
@@ -87,6 +88,26 @@ public:
      * cci parameter handle to determine the file type being used to trace signals if not specified explicitly
      */
     cci::cci_param_handle close_db_in_eos_handle;
+    /**
+     * cci parameter handle to determine if transactions are recorded by a background thread
+     */
+    cci::cci_param_handle tx_trace_async_handle;
+    /**
+     * cci parameter handle to determine the maximum size of a signal trace chunk, 0 disables size based rotation
+     */
+    cci::cci_param_handle sig_trace_chunk_size_handle;
+    /**
+     * cci parameter handle to determine the maximum time span of a signal trace chunk, 0 disables time based rotation
+     */
+    cci::cci_param_handle sig_trace_chunk_time_handle;
+    /**
+     * cci parameter handle to determine the time span of a FTR transaction database chunk, 0 disables chunking
+     */
+    cci::cci_param_handle tx_trace_chunk_time_handle;
+    /**
+     * cci parameter handle to determine the maximum size of a FTR transaction database chunk, 0 disables size based chunking
+     */
+    cci::cci_param_handle tx_trace_chunk_size_handle;
     /**
      * @fn  tracer(const std::string&&, file_type, bool=true)
      * @brief the constructor
@@ -170,6 +191,11 @@ protected:
     std::unique_ptr<cci::cci_param<unsigned>> tx_trace_type;
     std::unique_ptr<cci::cci_param<unsigned>> sig_trace_type;
     std::unique_ptr<cci::cci_param<bool>> close_db_in_eos;
+    std::unique_ptr<cci::cci_param<bool>> tx_trace_async;
+    std::unique_ptr<cci::cci_param<sc_dt::uint64>> sig_trace_chunk_size;
+    std::unique_ptr<cci::cci_param<sc_core::sc_time>> sig_trace_chunk_time;
+    std::unique_ptr<cci::cci_param<sc_core::sc_time>> tx_trace_chunk_time;
+    std::unique_ptr<cci::cci_param<sc_dt::uint64>> tx_trace_chunk_size;
 
 private:
     void init_tx_db(file_type type, std::string const&& name);
@@ -16,6 +16,7 @@
 
 #include "tracer_base.h"
 #include "observer.h"
+#include "report.h"
 #include "sc_variable.h"
 #include "traceable.h"
 #include <cstring>
@@ -105,190 +106,215 @@ template <size_t size> struct sc_lv_tester {
     }
 };
 
-void tracer_base::try_trace(sc_trace_file* trace_file, const sc_object* object, trace_types types_to_trace) {
+bool tracer_base::try_trace(sc_trace_file* trace_file, const sc_object* object, trace_types types_to_trace) {
     if(try_trace_obj<bool>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(try_trace_obj<char>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<unsigned char>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(try_trace_obj<short>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<unsigned short>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(try_trace_obj<int>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<unsigned int>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(try_trace_obj<long>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<unsigned long>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(try_trace_obj<long long>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<unsigned long long>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(try_trace_obj<float>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<double>(trace_file, object, types_to_trace))
-        return;
+        return true;
 #if(SYSTEMC_VERSION >= 20171012)
     if(try_trace_obj<sc_core::sc_time>(trace_file, object, types_to_trace))
-        return;
+        return true;
 #endif
     if(try_trace_obj<sc_bit>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_logic>(trace_file, object, types_to_trace))
-        return;
+        return true;
 #if defined(FULL_TRACE_TYPE_LIST)
     if(ForLoop<64>::iterate<sc_uint_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(ForLoop<64>::iterate<sc_int_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(ForLoop<1024>::iterate<sc_biguint_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(ForLoop<1024>::iterate<sc_bigint_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(ForLoop<1024>::iterate<sc_bv_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(ForLoop<1024>::iterate<sc_lv_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
 #else
     if(ForLoop<31>::iterate<sc_uint_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_uint<32>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_uint<40>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_uint<48>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_uint<56>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_uint<64>>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(ForLoop<31>::iterate<sc_int_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_int<32>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_int<40>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_int<48>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_int<56>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_int<64>>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(try_trace_obj<sc_biguint<32>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_biguint<64>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_biguint<128>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_biguint<256>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_biguint<384>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_biguint<512>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_biguint<1024>>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(try_trace_obj<sc_bigint<32>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bigint<64>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bigint<128>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bigint<256>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bigint<384>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bigint<512>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bigint<1024>>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(ForLoop<31>::iterate<sc_bv_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<32>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<40>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<48>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<56>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<64>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<128>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<256>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<384>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<512>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_bv<1024>>(trace_file, object, types_to_trace))
-        return;
+        return true;
 
     if(ForLoop<31>::iterate<sc_lv_tester>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<32>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<40>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<48>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<56>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<64>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<128>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<256>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<384>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<512>>(trace_file, object, types_to_trace))
-        return;
+        return true;
     if(try_trace_obj<sc_lv<1024>>(trace_file, object, types_to_trace))
-        return;
+        return true;
 #endif
+    return false;
 }
 
 std::string tracer_base::get_name() { return sc_core::sc_gen_unique_name("$$$scc_tracer$$$", true); }
 
 void tracer_base::descend(const sc_object* obj, bool trace_all) {
-    if(obj == this)
+    if(obj == this || !enter_filter(obj))
         return;
+    if(filter_included())
+        trace_all = true;
     const char* kind = obj->kind();
     if(strcmp(kind, "tlm_signal") == 0) {
-        obj->trace(trf);
+        trace_object(obj);
     } else if(strcmp(kind, "sc_vector") == 0) {
         for(auto o : obj->get_child_objects())
             descend(o, trace_all);
     } else if((strcmp(kind, "sc_module") == 0 && trace_all) || dynamic_cast<const traceable*>(obj)) {
-        obj->trace(trf);
+        if(filter_selected())
+            obj->trace(trf);
         for(auto o : obj->get_child_objects())
             descend(o, trace_all);
     } else if(strcmp(kind, "sc_variable") == 0) {
         if((types_to_trace & trace_types::VARIABLES) == trace_types::VARIABLES)
-            obj->trace(trf);
+            trace_object(obj);
+    } else if(strcmp(kind, "fifo_w_cb") == 0 || strcmp(kind, "sc_owning_signal") == 0) {
+        if((types_to_trace & trace_types::SIGNALS) == trace_types::SIGNALS)
+            trace_object(obj);
     } else if(const auto* tr = dynamic_cast<const scc::traceable*>(obj)) {
         if(tr->is_trace_enabled())
-            obj->trace(trf);
+            trace_object(obj);
         for(auto o : obj->get_child_objects())
             descend(o, tr->is_trace_enabled());
     } else {
-        try_trace(trf, obj, types_to_trace);
+        try_trace_object(obj);
+    }
+}
+
+void tracer_base::init_filter() {
+    auto includes = trace_include_handle.get_cci_value().get<std::string>();
+    auto excludes = trace_exclude_handle.get_cci_value().get<std::string>();
+    filter.reset(new trace::hierarchy_filter(includes, excludes));
+    if(filter->empty())
+        filter.reset();
+    else
+        filter->set_report_depth(trace_report_depth_handle.get_cci_value().get<unsigned>());
+}
+
+void tracer_base::report_filter() {
+    if(filter) {
+        for(auto& e : filter->report())
+            SCCINFO(SCMOD) << "tracing " << e.second << " objects in " << e.first;
+        filter.reset();
     }
 }
 
@@ -305,6 +331,9 @@ tracer_base* find_tracer_base(sc_core::sc_object* obj) {
 } // namespace
 
 static char const* const default_trace_enable_name = "scc_tracer.default_trace_enable";
+static char const* const trace_include_name = "scc_tracer.trace_include";
+static char const* const trace_exclude_name = "scc_tracer.trace_exclude";
+static char const* const trace_report_depth_name = "scc_tracer.trace_report_depth";
 tracer_base::tracer_base(const sc_core::sc_module_name& nm, sc_core::sc_trace_file* tf, bool owned)
 : sc_core::sc_module(nm)
 , trf(tf) {
@@ -315,6 +344,27 @@ tracer_base::tracer_base(const sc_core::sc_module_name& nm, sc_core::sc_trace_fi
             default_trace_enable_name, false, "the default for tracing if no attribute is configured", cci::CCI_ABSOLUTE_NAME);
         default_trace_enable_handle = cci_broker.get_param_handle(default_trace_enable_name);
     }
+    trace_include_handle = cci_broker.get_param_handle(trace_include_name);
+    if(!trace_include_handle.is_valid()) {
+        trace_include = scc::make_unique<cci::cci_param<std::string>>(
+            trace_include_name, "", "comma separated list of hierarchy patterns (glob syntax, '**' for any depth) to be traced",
+            cci::CCI_ABSOLUTE_NAME);
+        trace_include_handle = cci_broker.get_param_handle(trace_include_name);
+    }
+    trace_exclude_handle = cci_broker.get_param_handle(trace_exclude_name);
+    if(!trace_exclude_handle.is_valid()) {
+        trace_exclude = scc::make_unique<cci::cci_param<std::string>>(
+            trace_exclude_name, "", "comma separated list of hierarchy patterns (glob syntax, '**' for any depth) not to be traced",
+            cci::CCI_ABSOLUTE_NAME);
+        trace_exclude_handle = cci_broker.get_param_handle(trace_exclude_name);
+    }
+    trace_report_depth_handle = cci_broker.get_param_handle(trace_report_depth_name);
+    if(!trace_report_depth_handle.is_valid()) {
+        trace_report_depth = scc::make_unique<cci::cci_param<unsigned>>(
+            trace_report_depth_name, 2, "hierarchy depth up to which the number of traced objects is reported if filters are set",
+            cci::CCI_ABSOLUTE_NAME);
+        trace_report_depth_handle = cci_broker.get_param_handle(trace_report_depth_name);
+    }
 }
 
 bool tracer_base::get_default_trace_enable() {
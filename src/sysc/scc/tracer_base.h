@@ -17,6 +17,7 @@
 #ifndef _SCC_TRACER_BASE_H_
 #define _SCC_TRACER_BASE_H_
 
+#include "trace/hierarchy_filter.hh"
 #include "utilities.h"
 #include <sysc/tracing/sc_trace.h>
 #include <type_traits>
@@ -81,6 +82,18 @@ struct tracer_base : public sc_core::sc_module {
      * cci parameter handle to determine if the tracing is enabled if not specified explicitly
      */
     cci::cci_param_handle default_trace_enable_handle;
+    /**
+     * cci parameter handle of the list of hierarchy patterns to be traced, see trace::hierarchy_filter
+     */
+    cci::cci_param_handle trace_include_handle;
+    /**
+     * cci parameter handle of the list of hierarchy patterns not to be traced, see trace::hierarchy_filter
+     */
+    cci::cci_param_handle trace_exclude_handle;
+    /**
+     * cci parameter handle of the hierarchy depth up to which the number of traced objects is reported
+     */
+    cci::cci_param_handle trace_report_depth_handle;
     /**
      * @fn  tracer_base(const sc_core::sc_module_name&)
      * @brief named constructor
@@ -143,13 +156,55 @@ protected:
 
     virtual void descend(const sc_core::sc_object*, bool trace_all);
 
-    static void try_trace(sc_core::sc_trace_file* trace_file, const sc_core::sc_object* object, trace_types t);
+    static bool try_trace(sc_core::sc_trace_file* trace_file, const sc_core::sc_object* object, trace_types t);
+    //! compile the include/exclude patterns of the cci parameters, the filter is only active if a pattern is given
+    void init_filter();
+    //! report the number of traced objects per subtree and release the filter
+    void report_filter();
+    /**
+     * @fn bool enter_filter(const sc_core::sc_object*)
+     * @brief make obj the current object of the hierarchy filter
+     *
+     * @param obj the object being visited
+     * @return false if the subtree of obj does not need to be visited
+     */
+    bool enter_filter(const sc_core::sc_object* obj) {
+        if(!filter)
+            return true;
+        filter->enter(obj->name());
+        return !filter->prune();
+    }
+    //! returns true if the current object has been explicitly selected by an include pattern
+    bool filter_included() const { return filter && filter->current_decision() == trace::hierarchy_filter::INCLUDED; }
+    //! returns true if the current object passes the hierarchy filter
+    bool filter_selected() const { return !filter || filter->selected(); }
+    //! call the trace() function of the current object if it passes the hierarchy filter
+    void trace_object(const sc_core::sc_object* obj) {
+        if(filter_selected()) {
+            obj->trace(trf);
+            if(filter)
+                filter->count();
+        }
+    }
+    //! trace the current object as port or signal if it passes the hierarchy filter
+    void try_trace_object(const sc_core::sc_object* obj) {
+        if(filter_selected() && try_trace(trf, obj, types_to_trace) && filter)
+            filter->count();
+    }
 
     sc_core::sc_trace_file* trf{nullptr};
 
     trace_types types_to_trace{trace_types::ALL};
 
     std::unique_ptr<cci::cci_param<bool>> default_trace_enable;
+
+    std::unique_ptr<cci::cci_param<std::string>> trace_include;
+
+    std::unique_ptr<cci::cci_param<std::string>> trace_exclude;
+
+    std::unique_ptr<cci::cci_param<unsigned>> trace_report_depth;
+
+    std::unique_ptr<trace::hierarchy_filter> filter;
 };
 
 } // namespace scc
@@ -19,6 +19,7 @@
 #define SCC_VCD_MT_TRACE_H
 
 #include <scc/observer.h>
+#include <scc/trace.h>
 #include <sysc/tracing/sc_trace.h>
 #include <sysc/kernel/sc_ver.h>
 #include <util/thread_pool.h>
@@ -38,13 +39,17 @@ namespace scc {
 namespace trace {
 class vcd_trace;
 class gz_writer;
+class chunk_index;
+struct sampler;
 }
-struct vcd_mt_trace_file : public sc_core::sc_trace_file, public observer {
+struct vcd_mt_trace_file : public sc_core::sc_trace_file, public observer, public sampling_control {
 
-    vcd_mt_trace_file(const char *name, std::function<bool()>& enable);
+    vcd_mt_trace_file(const char *name, std::function<bool()>& enable, trace_rotation const& rotation = trace_rotation());
 
     virtual ~vcd_mt_trace_file();
 
+    void set_sampling_policy(sampling_policy const& policy) override { sampling = policy; }
+
 protected:
 #define DECL_TRACE_METHOD_A(tp) void trace(const tp& object, const std::string& name) override;
 #define DECL_TRACE_METHOD_B(tp) void trace(const tp& object, const std::string& name, int width) override;
@@ -138,13 +143,19 @@ private:
 #endif
 
     void init();
+    void write_header();
+    void rotate(uint64_t time_stamp);
     std::string prune_name(std::string const& name);
     std::string obtain_name();
     std::function<bool()> check_enabled;
     std::unique_ptr<trace::gz_writer> vcd_out{nullptr};
+    std::unique_ptr<trace::chunk_index> chunks;
     struct trace_entry: public observer::notification_handle {
         bool (*compare_and_update)(trace::vcd_trace*);
         trace::vcd_trace* trc;
+        trace::sampler* smplr{nullptr};
+        //! the time of the last recorded change if sampled
+        uint64_t last_sample_ps{0};
         vcd_mt_trace_file* that;
         bool notify() override;
         trace_entry(vcd_mt_trace_file* owner, bool (*compare_and_update)(trace::vcd_trace*), trace::vcd_trace* trc)
@@ -152,6 +163,10 @@ private:
         virtual ~trace_entry(){}
     };
     std::deque<trace_entry> all_traces;
+    sampling_policy sampling;
+    std::vector<std::unique_ptr<trace::sampler>> samplers;
+    uint64_t sample_step{0};
+    void attach_sampler(trace_entry& e);
     std::vector<trace_entry> active_traces;
     std::vector<trace::vcd_trace*> changed_traces;
     std::vector<trace::vcd_trace*> triggered_traces;
@@ -16,6 +16,8 @@
 
 #include "vcd_pull_trace.hh"
 #include "sc_vcd_trace.h"
+#include "trace/chunk_index.hh"
+#include "trace/sampler.hh"
 #include "trace/vcd_trace.hh"
 #include "utilities.h"
 
@@ -48,10 +50,11 @@ namespace scc {
 /*******************************************************************************************************
  *
  *******************************************************************************************************/
-vcd_pull_trace_file::vcd_pull_trace_file(const char* name, std::function<bool()>& enable)
+vcd_pull_trace_file::vcd_pull_trace_file(const char* name, std::function<bool()>& enable, trace_rotation const& rotation)
 : name(name)
-, check_enabled(enable) {
-    vcd_out = fopen(fmt::format("{}.vcd", name).c_str(), "w");
+, check_enabled(enable)
+, chunks(new trace::chunk_index(name, "vcd", rotation)) {
+    vcd_out = fopen(chunks->file_name().c_str(), "w");
 
 #if SC_VERSION_MAJOR < 3
 #if defined(WITH_SC_TRACING_PHASE_CALLBACKS)
@@ -70,6 +73,7 @@ vcd_pull_trace_file::~vcd_pull_trace_file() {
         FPRINTF(vcd_out, "#{}\n", sc_core::sc_time_stamp() / 1_ps);
         fclose(vcd_out);
     }
+    chunks->finish(trace::to_ps(sc_core::sc_time_stamp()));
     for(auto t : all_traces)
         delete t.trc;
 }
@@ -81,17 +85,27 @@ template <typename T, typename OT = T> bool changed(trace::vcd_trace* trace) {
     } else
         return false;
 }
+
+void vcd_pull_trace_file::attach_sampler(trace_entry& e) {
+    if(sampling.active()) {
+        e.smplr = trace::get_sampler(samplers, sampling);
+    }
+}
+
 #define DECL_TRACE_METHOD_A(tp)                                                                                                            \
     void vcd_pull_trace_file::trace(const tp& object, const std::string& name) {                                                           \
         all_traces.emplace_back(&changed<tp>, new trace::vcd_trace_t<tp>(object, name));                                                   \
+        attach_sampler(all_traces.back());                                                                                                 \
     }
 #define DECL_TRACE_METHOD_B(tp)                                                                                                            \
     void vcd_pull_trace_file::trace(const tp& object, const std::string& name, int width) {                                                \
         all_traces.emplace_back(&changed<tp>, new trace::vcd_trace_t<tp>(object, name));                                                   \
+        attach_sampler(all_traces.back());                                                                                                 \
     }
 #define DECL_TRACE_METHOD_C(tp, tpo)                                                                                                       \
     void vcd_pull_trace_file::trace(const tp& object, const std::string& name) {                                                           \
         all_traces.emplace_back(&changed<tp, tpo>, new trace::vcd_trace_t<tp, tpo>(object, name));                                         \
+        attach_sampler(all_traces.back());                                                                                                 \
     }
 
 #if(SYSTEMC_VERSION >= 20171012) || defined(NCSC)
@@ -136,6 +150,7 @@ DECL_TRACE_METHOD_A(sc_dt::sc_lv_base)
 
 void vcd_pull_trace_file::trace(const unsigned int& object, const std::string& name, const char** enum_literals) {
     all_traces.emplace_back(&changed<unsigned int>, new trace::vcd_trace_enum(object, name, enum_literals));
+    attach_sampler(all_traces.back());
 }
 
 std::string vcd_pull_trace_file::obtain_name() {
@@ -172,18 +187,23 @@ void vcd_pull_trace_file::init() {
               [](trace_entry const& a, trace_entry const& b) -> bool { return a.trc->name < b.trc->name; });
     std::unordered_map<uintptr_t, std::string> alias_map;
 
-    trace::vcd_scope_stack<trace::vcd_trace> scope;
     for(auto& e : all_traces) {
         auto alias_it = alias_map.find(e.trc->get_hash());
         e.trc->is_alias = alias_it != std::end(alias_map);
         e.trc->trc_hndl = e.trc->is_alias ? alias_it->second : obtain_name();
         if(!e.trc->is_alias)
             alias_map.insert({e.trc->get_hash(), e.trc->trc_hndl});
-        scope.add_trace(e.trc);
     }
     std::copy_if(std::begin(all_traces), std::end(all_traces), std::back_inserter(active_traces),
                  [](trace_entry const& e) { return !e.trc->is_alias; });
     changed_traces.reserve(active_traces.size());
+    write_header();
+}
+
+void vcd_pull_trace_file::write_header() {
+    trace::vcd_scope_stack<trace::vcd_trace> scope;
+    for(auto& e : all_traces)
+        scope.add_trace(e.trc);
     // date:
     char tbuf[200];
     time_t long_time;
@@ -201,6 +221,18 @@ void vcd_pull_trace_file::init() {
     scope.print(vcd_out);
 }
 
+void vcd_pull_trace_file::rotate(uint64_t time_stamp) {
+    FPRINTF(vcd_out, "#{}\n", time_stamp);
+    fclose(vcd_out);
+    chunks->rotate(time_stamp);
+    vcd_out = fopen(chunks->file_name().c_str(), "w");
+    write_header();
+    FPRINTF(vcd_out, "$enddefinitions  $end\n\n#{}\n$dumpvars\n", time_stamp);
+    for(auto& e : active_traces)
+        e.trc->record(vcd_out);
+    FPRINT(vcd_out, "$end\n\n");
+}
+
 std::string vcd_pull_trace_file::prune_name(std::string const& orig_name) {
     static bool warned = false;
     bool braces_removed = false;
@@ -244,12 +276,23 @@ void vcd_pull_trace_file::cycle(bool delta_cycle) {
         if(check_enabled && !check_enabled())
             return;
         changed_traces.clear();
+        uint64_t time_stamp = trace::to_ps(sc_core::sc_time_stamp());
+        ++sample_step;
         for(auto& e : active_traces) {
-            if(e.compare_and_update(e.trc))
+            if(e.smplr && !e.smplr->due(sample_step, time_stamp, e.last_sample_ps))
+                continue;
+            if(e.compare_and_update(e.trc)) {
                 changed_traces.push_back(e.trc);
+                if(e.smplr)
+                    e.last_sample_ps = time_stamp;
+            }
         }
         if(changed_traces.size()) {
-            FPRINTF(vcd_out, "#{}\n", sc_core::sc_time_stamp() / 1_ps);
+            if(chunks->needs_rotation(time_stamp, ftell(vcd_out))) {
+                rotate(time_stamp);
+                return;
+            }
+            FPRINTF(vcd_out, "#{}\n", time_stamp);
             for(auto& t : changed_traces)
                 t->record(vcd_out);
         }
@@ -262,6 +305,10 @@ sc_core::sc_trace_file* create_vcd_pull_trace_file(const char* name, std::functi
     return new vcd_pull_trace_file(name, enable);
 }
 
+sc_core::sc_trace_file* create_vcd_pull_trace_file(const char* name, std::function<bool()> enable, trace_rotation const& rotation) {
+    return new vcd_pull_trace_file(name, enable, rotation);
+}
+
 void close_vcd_pull_trace_file(sc_core::sc_trace_file* tf) {
     vcd_pull_trace_file* vcd_tf = static_cast<vcd_pull_trace_file*>(tf);
     delete vcd_tf;
@@ -17,10 +17,12 @@
 #ifndef SCC_VCD_PULL_TRACE_H
 #define SCC_VCD_PULL_TRACE_H
 
+#include <scc/trace.h>
 #include <sysc/tracing/sc_trace.h>
 #include <sysc/kernel/sc_ver.h>
 #include <vector>
 #include <functional>
+#include <memory>
 
 namespace sc_core {
 class sc_time;
@@ -33,14 +35,18 @@ class sc_time;
 namespace scc {
 namespace trace {
 class vcd_trace;
+class chunk_index;
+struct sampler;
 }
 
-struct vcd_pull_trace_file : public sc_core::sc_trace_file {
+struct vcd_pull_trace_file : public sc_core::sc_trace_file, public sampling_control {
 
-    vcd_pull_trace_file(const char *name, std::function<bool()>& enable);
+    vcd_pull_trace_file(const char *name, std::function<bool()>& enable, trace_rotation const& rotation = trace_rotation());
 
     virtual ~vcd_pull_trace_file();
 
+    void set_sampling_policy(sampling_policy const& policy) override { sampling = policy; }
+
 protected:
 #define DECL_TRACE_METHOD_A(tp) void trace(const tp& object, const std::string& name) override;
 #define DECL_TRACE_METHOD_B(tp) void trace(const tp& object, const std::string& name, int width) override;
@@ -103,17 +109,27 @@ private:
 #endif
 
     void init();
+    void write_header();
+    void rotate(uint64_t time_stamp);
     std::string prune_name(std::string const& name);
     std::string obtain_name();
     std::function<bool()> check_enabled;
 
     FILE* vcd_out{nullptr};
+    std::unique_ptr<trace::chunk_index> chunks;
     struct trace_entry {
         bool (*compare_and_update)(trace::vcd_trace*);
         trace::vcd_trace* trc;
+        trace::sampler* smplr{nullptr};
+        //! the time of the last recorded change if sampled
+        uint64_t last_sample_ps{0};
         trace_entry(bool (*compare_and_update)(trace::vcd_trace*), trace::vcd_trace* trc):compare_and_update{compare_and_update}, trc{trc}{}
     };
     std::vector<trace_entry> all_traces, active_traces;
+    sampling_policy sampling;
+    std::vector<std::unique_ptr<trace::sampler>> samplers;
+    uint64_t sample_step{0};
+    void attach_sampler(trace_entry& e);
     std::vector<trace::vcd_trace*> changed_traces;;
     bool initialized{false};
     unsigned vcd_name_index{0};
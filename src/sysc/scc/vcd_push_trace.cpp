@@ -16,6 +16,8 @@
 
 #include "vcd_push_trace.hh"
 #include "sc_vcd_trace.h"
+#include "trace/chunk_index.hh"
+#include "trace/sampler.hh"
 #include "trace/vcd_trace.hh"
 #include "utilities.h"
 #include <cmath>
@@ -47,10 +49,11 @@ namespace scc {
 /*******************************************************************************************************
  *
  *******************************************************************************************************/
-vcd_push_trace_file::vcd_push_trace_file(const char* name, std::function<bool()>& enable)
+vcd_push_trace_file::vcd_push_trace_file(const char* name, std::function<bool()>& enable, trace_rotation const& rotation)
 : name(name)
-, check_enabled(enable) {
-    vcd_out = fopen(fmt::format("{}.vcd", name).c_str(), "w");
+, check_enabled(enable)
+, chunks(new trace::chunk_index(name, "vcd", rotation)) {
+    vcd_out = fopen(chunks->file_name().c_str(), "w");
 
 #if SC_VERSION_MAJOR < 3
 #if defined(WITH_SC_TRACING_PHASE_CALLBACKS)
@@ -69,6 +72,7 @@ vcd_push_trace_file::~vcd_push_trace_file() {
         FPRINTF(vcd_out, "#{}\n", sc_core::sc_time_stamp() / 1_ps);
         fclose(vcd_out);
     }
+    chunks->finish(trace::to_ps(sc_core::sc_time_stamp()));
     for(auto t : all_traces)
         delete t.trc;
 }
@@ -80,22 +84,32 @@ template <typename T, typename OT = T> bool changed(trace::vcd_trace* trace) {
     } else
         return false;
 }
+
+void vcd_push_trace_file::attach_sampler(trace_entry& e) {
+    if(sampling.active()) {
+        e.smplr = trace::get_sampler(samplers, sampling);
+    }
+}
+
 #define DECL_TRACE_METHOD_A(tp)                                                                                                            \
     void vcd_push_trace_file::trace(const tp& object, const std::string& name) {                                                           \
         all_traces.emplace_back(this, &changed<tp>, new trace::vcd_trace_t<tp>(object, name));                                             \
+        attach_sampler(all_traces.back());                                                                                                 \
     }
 #define DECL_TRACE_METHOD_B(tp)                                                                                                            \
     void vcd_push_trace_file::trace(const tp& object, const std::string& name, int width) {                                                \
         all_traces.emplace_back(this, &changed<tp>, new trace::vcd_trace_t<tp>(object, name));                                             \
+        attach_sampler(all_traces.back());                                                                                                 \
     }
 #define DECL_TRACE_METHOD_C(tp, tpo)                                                                                                       \
     void vcd_push_trace_file::trace(const tp& object, const std::string& name) {                                                           \
         all_traces.emplace_back(this, &changed<tp, tpo>, new trace::vcd_trace_t<tp, tpo>(object, name));                                   \
+        attach_sampler(all_traces.back());                                                                                                 \
     }
 
 #if(SYSTEMC_VERSION >= 20171012) || defined(NCSC)
 void vcd_push_trace_file::trace(const sc_core::sc_event& object, const std::string& name) {}
-void vcd_push_trace_file::trace(const sc_core::sc_time& object, const std::string& name) {}
+DECL_TRACE_METHOD_A(sc_core::sc_time)
 #endif
 DECL_TRACE_METHOD_A(bool)
 DECL_TRACE_METHOD_A(sc_dt::sc_bit)
@@ -135,23 +149,26 @@ DECL_TRACE_METHOD_A(sc_dt::sc_lv_base)
 
 void vcd_push_trace_file::trace(const unsigned int& object, const std::string& name, const char** enum_literals) {
     all_traces.emplace_back(this, &changed<unsigned int>, new trace::vcd_trace_enum(object, name, enum_literals));
+    attach_sampler(all_traces.back());
 }
 
 #define DECL_REGISTER_METHOD_A(tp)                                                                                                         \
     observer::notification_handle* vcd_push_trace_file::observe(const tp& object, const std::string& name) {                               \
         all_traces.emplace_back(this, &changed<tp>, new trace::vcd_trace_t<tp>(object, name));                                             \
-        all_traces.back().trc->is_triggered = true;                                                                                        \
+        attach_sampler(all_traces.back());                                                                                                 \
+        all_traces.back().trc->is_triggered = all_traces.back().smplr == nullptr;                                                          \
         return &all_traces.back();                                                                                                         \
     }
 #define DECL_REGISTER_METHOD_C(tp, tpo)                                                                                                    \
     observer::notification_handle* vcd_push_trace_file::observe(const tp& object, const std::string& name) {                               \
         all_traces.emplace_back(this, &changed<tp, tpo>, new trace::vcd_trace_t<tp, tpo>(object, name));                                   \
-        all_traces.back().trc->is_triggered = true;                                                                                        \
+        attach_sampler(all_traces.back());                                                                                                 \
+        all_traces.back().trc->is_triggered = all_traces.back().smplr == nullptr;                                                          \
         return &all_traces.back();                                                                                                         \
     }
 #if(SYSTEMC_VERSION >= 20171012)
 observer::notification_handle* vcd_push_trace_file::observe(const sc_core::sc_event& object, const std::string& name) { return nullptr; }
-observer::notification_handle* vcd_push_trace_file::observe(const sc_core::sc_time& object, const std::string& name) { return nullptr; }
+DECL_REGISTER_METHOD_A(sc_core::sc_time)
 #endif
 
 DECL_REGISTER_METHOD_A(bool)
@@ -190,9 +207,12 @@ DECL_REGISTER_METHOD_A(sc_dt::sc_lv_base)
 #undef DECL_REGISTER_METHOD_C
 
 bool vcd_push_trace_file::trace_entry::notify() {
-    if(!trc->is_alias && compare_and_update(trc))
+    // aliases and sampled traces are not recorded on change, returning false suspends the notifications
+    if(trc->is_alias || !trc->is_triggered)
+        return false;
+    if(compare_and_update(trc))
         that->triggered_traces.push_back(trc);
-    return !trc->is_alias;
+    return true;
 }
 
 std::string vcd_push_trace_file::obtain_name() {
@@ -233,19 +253,30 @@ void vcd_push_trace_file::init() {
               [](trace_entry const* a, trace_entry const* b) -> bool { return a->trc->name < b->trc->name; });
 
     std::unordered_map<uintptr_t, std::string> alias_map;
-    trace::vcd_scope_stack<trace::vcd_trace> scope;
     for(auto e : traces) {
         auto alias_it = alias_map.find(e->trc->get_hash());
         e->trc->is_alias = alias_it != std::end(alias_map);
         e->trc->trc_hndl = e->trc->is_alias ? alias_it->second : obtain_name();
         if(!e->trc->is_alias)
             alias_map.insert({e->trc->get_hash(), e->trc->trc_hndl});
-        scope.add_trace(e->trc);
     }
     std::copy_if(std::begin(traces), std::end(traces), std::back_inserter(pull_traces),
                  [](trace_entry const* e) { return !(e->trc->is_alias || e->trc->is_triggered); });
     changed_traces.reserve(pull_traces.size());
     triggered_traces.reserve(traces.size());
+    write_header();
+}
+
+void vcd_push_trace_file::write_header() {
+    std::vector<trace::vcd_trace*> traces;
+    traces.reserve(all_traces.size());
+    for(auto& e : all_traces)
+        traces.push_back(e.trc);
+    std::sort(std::begin(traces), std::end(traces),
+              [](trace::vcd_trace const* a, trace::vcd_trace const* b) -> bool { return a->name < b->name; });
+    trace::vcd_scope_stack<trace::vcd_trace> scope;
+    for(auto t : traces)
+        scope.add_trace(t);
     // date:
     char tbuf[200];
     time_t long_time;
@@ -263,6 +294,21 @@ void vcd_push_trace_file::init() {
     scope.print(vcd_out);
 }
 
+void vcd_push_trace_file::rotate(uint64_t time_stamp) {
+    FPRINTF(vcd_out, "#{}\n", time_stamp);
+    fclose(vcd_out);
+    chunks->rotate(time_stamp);
+    vcd_out = fopen(chunks->file_name().c_str(), "w");
+    write_header();
+    FPRINTF(vcd_out, "$enddefinitions  $end\n\n#{}\n$dumpvars\n", time_stamp);
+    for(auto& e : all_traces)
+        if(!e.trc->is_alias)
+            e.trc->record(vcd_out);
+    FPRINT(vcd_out, "$end\n\n");
+    triggered_traces.clear();
+    changed_traces.clear();
+}
+
 std::string vcd_push_trace_file::prune_name(std::string const& orig_name) {
     static bool warned = false;
     bool braces_removed = false;
@@ -302,16 +348,27 @@ void vcd_push_trace_file::cycle(bool delta_cycle) {
                 e.trc->record(vcd_out);
             }
         FPRINT(vcd_out, "$end\n\n");
-        last_emitted_ts = sc_core::sc_time_stamp().value() / (1_ps).value();
+        last_emitted_ts = trace::to_ps(sc_core::sc_time_stamp());
     } else {
         if(check_enabled && !check_enabled())
             return;
+        uint64_t time_stamp = trace::to_ps(sc_core::sc_time_stamp());
+        ++sample_step;
         for(auto e : pull_traces) {
-            if(e->compare_and_update(e->trc))
+            if(e->smplr && !e->smplr->due(sample_step, time_stamp, e->last_sample_ps))
+                continue;
+            if(e->compare_and_update(e->trc)) {
                 changed_traces.push_back(e->trc);
+                if(e->smplr)
+                    e->last_sample_ps = time_stamp;
+            }
         }
         if(triggered_traces.size() || changed_traces.size()) {
-            uint64_t time_stamp = sc_core::sc_time_stamp().value() / (1_ps).value();
+            if(chunks->needs_rotation(time_stamp, ftell(vcd_out))) {
+                rotate(time_stamp);
+                last_emitted_ts = time_stamp;
+                return;
+            }
             FPRINTF(vcd_out, "#{}\n", time_stamp);
             auto end = std::unique(std::begin(triggered_traces), std::end(triggered_traces));
             triggered_traces.erase(end, triggered_traces.end());
@@ -337,5 +394,9 @@ sc_core::sc_trace_file* create_vcd_push_trace_file(const char* name, std::functi
     return new vcd_push_trace_file(name, enable);
 }
 
+sc_core::sc_trace_file* create_vcd_push_trace_file(const char* name, std::function<bool()> enable, trace_rotation const& rotation) {
+    return new vcd_push_trace_file(name, enable, rotation);
+}
+
 void close_vcd_push_trace_file(sc_core::sc_trace_file* tf) { delete static_cast<vcd_push_trace_file*>(tf); }
 } // namespace scc
@@ -19,6 +19,7 @@
 #include "lwtr4tlm2.h"
 #include <array>
 #include <cci_configuration>
+#include <memory>
 #include <regex>
 #include <scc/peq.h>
 #include <sstream>
@@ -27,7 +28,10 @@
 #include <tlm/scc/lwtr/lwtr4tlm2_extension_registry.h>
 #include <tlm/scc/tlm_gp_shared.h>
 #include <tlm/scc/tlm_mm.h>
+#include <tlm/scc/tlm_recording_filter.h>
+#include <tlm/scc/tlm_statistics.h>
 #include <unordered_map>
+#include <unordered_set>
 
 /**
  * LWTR components for TLM2
@@ -113,6 +117,10 @@ struct nb_rec_entry {
  * The handle of the created transaction is stored in an tlm_extension so that
  * another instance of the tlm2_lwtr
  * e.g. further down the path can link to it.
+ * The parameters sampleRate, addressRanges, commands, errorsOnly and latencyThreshold select the transactions being
+ * recorded, see tlm_recording_filter.
+ * If enableStatistics is set latency, bandwidth and outstanding transaction statistics are collected independent of a
+ * transaction database being open, see tlm_statistics.
  */
 template <typename TYPES = tlm::tlm_base_protocol_types>
 class tlm2_lwtr : public virtual tlm::tlm_fw_transport_if<TYPES>, public virtual tlm::tlm_bw_transport_if<TYPES> {
@@ -129,6 +137,30 @@ public:
     //! \brief the attribute to selectively enable/disable DMI recording
     cci::cci_param<bool> enableDmiTracing{"enableDmiTracing", false};
 
+    //! \brief the parameter to record only every n-th transaction
+    cci::cci_param<unsigned> sampleRate{"sampleRate", 1};
+
+    //! \brief the parameter to record only transactions within the comma separated address ranges (start-end or start+size)
+    cci::cci_param<std::string> addressRanges{"addressRanges", ""};
+
+    //! \brief the parameter to record only transactions with the comma separated commands (read, write, ignore)
+    cci::cci_param<std::string> commands{"commands", ""};
+
+    //! \brief the parameter to record only blocking transactions finishing with an error response
+    cci::cci_param<bool> errorsOnly{"errorsOnly", false};
+
+    //! \brief the parameter to record only blocking transactions taking at least the given time
+    cci::cci_param<sc_core::sc_time> latencyThreshold{"latencyThreshold", sc_core::SC_ZERO_TIME};
+
+    //! \brief the parameter to enable the collection of transaction statistics
+    cci::cci_param<bool> enableStatistics{"enableStatistics", false};
+
+    //! \brief the parameter setting the length of the time windows the bandwidth is accumulated in
+    cci::cci_param<sc_core::sc_time> statisticsWindow{"statisticsWindow", sc_core::sc_time(1, sc_core::SC_US)};
+
+    //! \brief the parameter naming the file the statistics are written to, CSV if it ends with .csv, JSON otherwise
+    cci::cci_param<std::string> statisticsFile{"statisticsFile", ""};
+
     /**
      * @fn  tlm2_lwtr(bool=true, tr_db*=tr_db::get_default_db())
      * @brief The constructor of the component
@@ -255,6 +287,18 @@ public:
      * recording is bypassed
      */
     inline bool isRecordingNonBlockingTxEnabled() const { return m_db && enableNbTracing.get_value(); }
+    /*! \brief get the transaction statistics
+     *
+     * \return the statistics or nullptr if they are not enabled
+     */
+    tlm_statistics* get_statistics() { return stats.get(); }
+    /*! \brief writes the statistics to statisticsFile or <name>_stats.json if no file name is given
+     *
+     */
+    void dump_statistics() {
+        if(stats)
+            stats->dump(statisticsFile.get_value().size() ? statisticsFile.get_value() : full_name + "_stats.json");
+    }
 
 protected:
     //! \brief the port where fw accesses are forwarded to
@@ -272,6 +316,20 @@ private:
      * to generate the timed view of non-blocking tx
      */
     void nbtx_cb();
+    /*! \brief forwards a blocking transaction and records it afterwards if it passes the post check of the filter
+     *
+     * Since the transaction handles are created after forwarding, other recorders further down the path cannot link
+     * to them.
+     */
+    void b_transport_post_checked(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay);
+    //! the blocking transport function doing the recording
+    void b_transport_recorded(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay);
+    //! the non-blocking forward transport function doing the recording
+    tlm::tlm_sync_enum nb_transport_fw_recorded(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
+                                                sc_core::sc_time& delay);
+    //! the non-blocking backward transport function doing the recording
+    tlm::tlm_sync_enum nb_transport_bw_recorded(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
+                                                sc_core::sc_time& delay);
     //! transaction recording database
     tx_db* m_db{nullptr};
     //! the relationship name handles
@@ -297,6 +355,12 @@ private:
     std::array<tx_generator<>*, 2> nb_trTimedHandle{{nullptr, nullptr}};
     std::unordered_map<uint64_t, tx_handle> nbtx_req_handle_map;
     std::unordered_map<uint64_t, tx_handle> nbtx_last_req_handle_map;
+    //! the non-blocking transactions rejected by the filter
+    std::unordered_set<uint64_t> nbtx_filtered;
+    //! the recording policy
+    tlm_recording_filter filter;
+    //! the transaction statistics if enabled
+    std::unique_ptr<tlm_statistics> stats;
 
     //! dmi transaction recording stream handle
     tx_fiber* dmi_streamHandle{nullptr};
@@ -306,6 +370,10 @@ private:
 
 protected:
     void initialize_streams() {
+        filter.configure(sampleRate.get_value(), addressRanges.get_value(), commands.get_value(), errorsOnly.get_value(),
+                         latencyThreshold.get_value());
+        if(enableStatistics.get_value() && !stats)
+            stats.reset(new tlm_statistics(full_name, statisticsWindow.get_value()));
         if(m_db) {
             pred_succ_hndl = m_db->create_relation("PREDECESSOR_SUCCESSOR");
             par_chld_hndl = m_db->create_relation("PARENT_CHILD");
@@ -366,6 +434,9 @@ public:
         this->bw_port(ts.get_base_port());
         this->fw_port(is.get_base_port());
     }
+
+private:
+    void end_of_simulation() override { this->dump_statistics(); }
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -373,9 +444,22 @@ public:
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename TYPES> void tlm2_lwtr<TYPES>::b_transport(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay) {
-    if(!isRecordingBlockingTxEnabled()) {
+    if(stats) {
+        auto const start = sc_core::sc_time_stamp() + delay;
+        stats->begin(trans, start);
+        b_transport_recorded(trans, delay);
+        stats->end(trans, start, sc_core::sc_time_stamp() + delay);
+    } else
+        b_transport_recorded(trans, delay);
+}
+
+template <typename TYPES> void tlm2_lwtr<TYPES>::b_transport_recorded(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay) {
+    if(!isRecordingBlockingTxEnabled() || !filter.pre_check(trans)) {
         fw_port->b_transport(trans, delay);
         return;
+    } else if(filter.has_post_check()) {
+        b_transport_post_checked(trans, delay);
+        return;
     }
     // Get a handle for the new transaction
     tx_handle h = b_trHandle[trans.get_command()]->begin_tx(delay);
@@ -435,11 +519,66 @@ template <typename TYPES> void tlm2_lwtr<TYPES>::b_transport(typename TYPES::tlm
     }
 }
 
+template <typename TYPES>
+void tlm2_lwtr<TYPES>::b_transport_post_checked(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay) {
+    auto const start = sc_core::sc_time_stamp();
+    auto const start_delay = delay;
+    fw_port->b_transport(trans, delay);
+    auto const timed_begin = start + start_delay;
+    auto const timed_end = sc_core::sc_time_stamp() + delay;
+    if(!filter.post_check(trans, timed_end > timed_begin ? timed_end - timed_begin : sc_core::SC_ZERO_TIME))
+        return;
+    tx_handle h = b_trHandle[trans.get_command()]->begin_tx_delayed(start, start_delay);
+    tx_handle htim;
+    if(b_streamHandleTimed)
+        htim = b_trTimedHandle[trans.get_command()]->begin_tx_delayed(timed_begin, par_chld_hndl, h);
+    h.record_attribute("trans", trans);
+    if(registered)
+        for(auto& extensionRecording : lwtr4tlm2_extension_registry<TYPES>::inst().get())
+            if(extensionRecording) {
+                extensionRecording->recordBeginTx(h, trans);
+                extensionRecording->recordEndTx(h, trans);
+                if(htim.is_valid()) {
+                    extensionRecording->recordBeginTx(htim, trans);
+                    extensionRecording->recordEndTx(htim, trans);
+                }
+            }
+    h.end_tx(delay);
+    if(htim.is_valid()) {
+        htim.record_attribute("trans", trans);
+        htim.end_tx_delayed(timed_end);
+    }
+}
+
 template <typename TYPES>
 tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_fw(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
                                                      sc_core::sc_time& delay) {
+    if(!stats)
+        return nb_transport_fw_recorded(trans, phase, delay);
+    if(phase == tlm::BEGIN_REQ)
+        stats->begin_nb(trans, sc_core::sc_time_stamp() + delay);
+    auto status = nb_transport_fw_recorded(trans, phase, delay);
+    if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+        stats->end_nb(trans, sc_core::sc_time_stamp() + delay);
+    return status;
+}
+
+template <typename TYPES>
+tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_fw_recorded(typename TYPES::tlm_payload_type& trans,
+                                                              typename TYPES::tlm_phase_type& phase, sc_core::sc_time& delay) {
     if(!isRecordingNonBlockingTxEnabled())
         return fw_port->nb_transport_fw(trans, phase, delay);
+    if(filter.has_pre_check()) {
+        auto const id = reinterpret_cast<uintptr_t>(&trans);
+        if(phase == tlm::BEGIN_REQ && !filter.pre_check(trans))
+            nbtx_filtered.insert(id);
+        if(nbtx_filtered.count(id)) {
+            auto status = fw_port->nb_transport_fw(trans, phase, delay);
+            if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+                nbtx_filtered.erase(id);
+            return status;
+        }
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
@@ -516,8 +655,25 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_fw(typename TYPES::tlm_payload
 template <typename TYPES>
 tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_bw(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
                                                      sc_core::sc_time& delay) {
+    if(!stats)
+        return nb_transport_bw_recorded(trans, phase, delay);
+    auto status = nb_transport_bw_recorded(trans, phase, delay);
+    if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+        stats->end_nb(trans, sc_core::sc_time_stamp() + delay);
+    return status;
+}
+
+template <typename TYPES>
+tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_bw_recorded(typename TYPES::tlm_payload_type& trans,
+                                                              typename TYPES::tlm_phase_type& phase, sc_core::sc_time& delay) {
     if(!isRecordingNonBlockingTxEnabled())
         return bw_port->nb_transport_bw(trans, phase, delay);
+    if(!nbtx_filtered.empty() && nbtx_filtered.count(reinterpret_cast<uintptr_t>(&trans))) {
+        auto status = bw_port->nb_transport_bw(trans, phase, delay);
+        if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+            nbtx_filtered.erase(reinterpret_cast<uintptr_t>(&trans));
+        return status;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
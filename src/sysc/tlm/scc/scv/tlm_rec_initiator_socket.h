@@ -65,6 +65,7 @@ public:
 #endif
                                 >()
     , recorder(this->name(), fw_port, bw_port) {
+        add_statistics_attributes();
     }
 
     explicit tlm_rec_initiator_socket(const char* name)
@@ -77,6 +78,7 @@ public:
     , fw_port(sc_core::sc_gen_unique_name("$$$_fw"))
     , bw_port(sc_core::sc_gen_unique_name("$$$_bw"))
     , recorder(this->name(), fw_port, bw_port) {
+        add_statistics_attributes();
     }
 
     virtual ~tlm_rec_initiator_socket() {}
@@ -121,6 +123,14 @@ public:
     }
 
 protected:
+    void end_of_simulation() override { recorder.dump_statistics(); }
+
+    void add_statistics_attributes() {
+        this->add_attribute(recorder.enableStatistics);
+        this->add_attribute(recorder.statisticsWindow);
+        this->add_attribute(recorder.statisticsFile);
+    }
+
     sc_core::sc_port<tlm::tlm_fw_transport_if<TYPES>> fw_port{sc_core::sc_gen_unique_name("$$$__rec_fw__$$$")};
     sc_core::sc_port<tlm::tlm_bw_transport_if<TYPES>> bw_port{sc_core::sc_gen_unique_name("$$$__rec_bw__$$$")};
     scv::tlm_recorder<TYPES> recorder;
@@ -66,6 +66,7 @@ public:
 #endif
                              >()
     , recorder(this->name(), fw_port, this->get_base_port()) {
+        add_statistics_attributes();
     }
 
     explicit tlm_rec_target_socket(const char* name)
@@ -76,6 +77,7 @@ public:
 #endif
                              >(name)
     , recorder(this->name(), fw_port, this->get_base_port()) {
+        add_statistics_attributes();
     }
 
     virtual ~tlm_rec_target_socket() = default; // NOLINT
@@ -115,6 +117,14 @@ public:
     }
 
 protected:
+    void end_of_simulation() override { recorder.dump_statistics(); }
+
+    void add_statistics_attributes() {
+        this->add_attribute(recorder.enableStatistics);
+        this->add_attribute(recorder.statisticsWindow);
+        this->add_attribute(recorder.statisticsFile);
+    }
+
     sc_core::sc_port<fw_interface_type> fw_port{sc_core::sc_gen_unique_name("$$$__rec_fw__$$$")};
     scv::tlm_recorder<TYPES> recorder;
 };
@@ -20,14 +20,17 @@
 #include "tlm_extension_recording_registry.h"
 #include "tlm_recording_extension.h"
 #include <array>
+#include <memory>
 #include <regex>
 #include <sstream>
 #include <string>
 #include <sysc/kernel/sc_dynamic_processes.h>
 #include <tlm/scc/tlm_mm.h>
+#include <tlm/scc/tlm_recording_filter.h>
+#include <tlm/scc/tlm_statistics.h>
 #include <tlm>
 #include <tlm_utils/peq_with_cb_and_phase.h>
-#include <unordered_map>
+#include <util/open_hash_map.h>
 
 //! @brief SystemC TLM
 namespace tlm {
@@ -76,6 +79,13 @@ template <typename TYPES = tlm::tlm_base_protocol_types> struct tlm_recording_ty
  * The handle of the created transaction is storee in an tlm_extension so that
  * another instance of the scv_tlm_recorder
  * e.g. further down the opath can link to it.
+ * The time points of the timed view are scheduled in payload event queues and recorded when they are reached. If
+ * enableTimedPeq is cleared they are recorded directly using the annotated times, this saves the payload copies and
+ * the events but the transaction database receives begin and end times lying in the future and thus out of order.
+ * The attributes sampleRate, addressRanges, commands, errorsOnly and latencyThreshold select the transactions being
+ * recorded, see tlm_recording_filter. They are evaluated when the streams are initialized.
+ * If enableStatistics is set latency, bandwidth and outstanding transaction statistics are collected independent of a
+ * transaction database being open, see tlm_statistics.
  */
 template <typename TYPES = tlm::tlm_base_protocol_types>
 class tlm_recorder : public virtual tlm::tlm_fw_transport_if<TYPES>, public virtual tlm::tlm_bw_transport_if<TYPES> {
@@ -102,6 +112,33 @@ public:
     //! \brief the attribute to selectively enable/disable DMI recording
     sc_core::sc_attribute<bool> enableDmiTracing{"enableDmiTracing", false};
 
+    //! \brief the attribute to record the timed view using payload event queues instead of the annotated times
+    sc_core::sc_attribute<bool> enableTimedPeq{"enableTimedPeq", true};
+
+    //! \brief the attribute to record only every n-th transaction
+    sc_core::sc_attribute<unsigned> sampleRate{"sampleRate", 1};
+
+    //! \brief the attribute to record only transactions within the comma separated address ranges (start-end or start+size)
+    sc_core::sc_attribute<std::string> addressRanges{"addressRanges", ""};
+
+    //! \brief the attribute to record only transactions with the comma separated commands (read, write, ignore)
+    sc_core::sc_attribute<std::string> commands{"commands", ""};
+
+    //! \brief the attribute to record only blocking transactions finishing with an error response
+    sc_core::sc_attribute<bool> errorsOnly{"errorsOnly", false};
+
+    //! \brief the attribute to record only blocking transactions taking at least the given time
+    sc_core::sc_attribute<sc_core::sc_time> latencyThreshold{"latencyThreshold", sc_core::SC_ZERO_TIME};
+
+    //! \brief the attribute to enable the collection of transaction statistics
+    sc_core::sc_attribute<bool> enableStatistics{"enableStatistics", false};
+
+    //! \brief the attribute setting the length of the time windows the bandwidth is accumulated in
+    sc_core::sc_attribute<sc_core::sc_time> statisticsWindow{"statisticsWindow", sc_core::sc_time(1, sc_core::SC_US)};
+
+    //! \brief the attribute naming the file the statistics are written to, CSV if it ends with .csv, JSON otherwise
+    sc_core::sc_attribute<std::string> statisticsFile{"statisticsFile", ""};
+
     //! \brief the port where fw accesses are forwarded to
     sc_core::sc_port_b<tlm::tlm_fw_transport_if<TYPES>>& fw_port;
 
@@ -240,6 +277,18 @@ public:
      * recording is bypassed
      */
     inline bool isRecordingNonBlockingTxEnabled() const { return m_db && enableNbTracing.value; }
+    /*! \brief get the transaction statistics
+     *
+     * \return the statistics or nullptr if they are not enabled
+     */
+    tlm_statistics* get_statistics() { return stats.get(); }
+    /*! \brief writes the statistics to statisticsFile or <name>_stats.json if no file name is given
+     *
+     */
+    void dump_statistics() {
+        if(stats)
+            stats->dump(statisticsFile.value.size() ? statisticsFile.value : fixed_basename + "_stats.json");
+    }
 
 private:
     //! event queue to hold time points of blocking transactions
@@ -251,11 +300,41 @@ private:
      *  to generate the timed view of blocking tx
      */
     void btx_cb(tlm_recording_payload& rec_parts, const typename TYPES::tlm_phase_type& phase);
+    /*! \brief forwards a blocking transaction and records it afterwards if it passes the post check of the filter
+     *
+     * Since the transaction handles are created after forwarding, other recorders further down the path cannot link
+     * to them.
+     */
+    void b_transport_post_checked(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay);
+    //! the blocking transport function doing the recording
+    void b_transport_recorded(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay);
+    //! the non-blocking forward transport function doing the recording
+    tlm::tlm_sync_enum nb_transport_fw_recorded(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
+                                                sc_core::sc_time& delay);
+    //! the non-blocking backward transport function doing the recording
+    tlm::tlm_sync_enum nb_transport_bw_recorded(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
+                                                sc_core::sc_time& delay);
     /*! \brief The thread processing the non-blocking requests with their
      * annotated times
      * to generate the timed view of non-blocking tx
      */
     void nbtx_cb(tlm_recording_payload& rec_parts, const typename TYPES::tlm_phase_type& phase);
+    /*! \brief records a time point of the timed view of non-blocking tx
+     *
+     * \param id identifies the transaction, usually the address of the generic payload
+     * \param trans is the payload to record
+     * \param phase is the phase reached at time t
+     * \param parent is the handle of the non-blocking tx announcing the time point
+     * \param t is the time of the time point
+     */
+    void nbtx_record(uint64_t id, tlm::tlm_generic_payload const& trans, tlm::tlm_phase const& phase, SCVNS scv_tr_handle const& parent,
+                     sc_core::sc_time const& t);
+    /*! \brief announces a time point of the timed view of non-blocking tx
+     *
+     * Depending on enableTimedPeq the time point is recorded directly or scheduled in the nb_timed_peq.
+     */
+    void nbtx_timed(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type const& phase, SCVNS scv_tr_handle const& parent,
+                    sc_core::sc_time const& delay);
     //! transaction recording database
     SCVNS scv_tr_db* m_db{nullptr};
     //! blocking transaction recording stream handle
@@ -267,7 +346,7 @@ private:
     //! transaction generator handle for blocking transactions with annotated
     //! delays
     std::array<SCVNS scv_tr_generator<>*, 3> b_trTimedHandle{{nullptr, nullptr, nullptr}};
-    std::unordered_map<uint64_t, SCVNS scv_tr_handle> btx_handle_map;
+    util::open_hash_map<SCVNS scv_tr_handle> btx_handle_map;
 
     enum DIR { FW, BW, REQ = FW, RESP = BW };
     //! non-blocking transaction recording stream handle
@@ -278,8 +357,14 @@ private:
     std::array<SCVNS scv_tr_generator<std::string, std::string>*, 2> nb_trHandle{{nullptr, nullptr}};
     //! transaction generator handle for non-blocking transactions with annotated delays
     std::array<SCVNS scv_tr_generator<>*, 2> nb_trTimedHandle{{nullptr, nullptr}};
-    std::unordered_map<uint64_t, SCVNS scv_tr_handle> nbtx_req_handle_map;
-    std::unordered_map<uint64_t, SCVNS scv_tr_handle> nbtx_last_req_handle_map;
+    util::open_hash_map<SCVNS scv_tr_handle> nbtx_req_handle_map;
+    util::open_hash_map<SCVNS scv_tr_handle> nbtx_last_req_handle_map;
+    //! the non-blocking transactions rejected by the filter
+    util::open_hash_map<bool> nbtx_filtered;
+    //! the recording policy
+    tlm_recording_filter filter;
+    //! the transaction statistics if enabled
+    std::unique_ptr<tlm_statistics> stats;
 
     //! dmi transaction recording stream handle
     SCVNS scv_tr_stream* dmi_streamHandle{nullptr};
@@ -289,6 +374,10 @@ private:
 
 public:
     void initialize_streams() {
+        if(!filter.is_configured())
+            filter.configure(sampleRate.value, addressRanges.value, commands.value, errorsOnly.value, latencyThreshold.value);
+        if(enableStatistics.value && !stats)
+            stats.reset(new tlm_statistics(fixed_basename, statisticsWindow.value));
         if(isRecordingBlockingTxEnabled() && !b_streamHandle) {
             b_streamHandle = new SCVNS scv_tr_stream((fixed_basename + "_bl").c_str(), "[TLM][base-protocol][b]", m_db);
             b_trHandle[tlm::TLM_READ_COMMAND] =
@@ -340,18 +429,37 @@ private:
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename TYPES> void tlm_recorder<TYPES>::b_transport(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay) {
+    if(stats) {
+        auto const start = sc_core::sc_time_stamp() + delay;
+        stats->begin(trans, start);
+        b_transport_recorded(trans, delay);
+        stats->end(trans, start, sc_core::sc_time_stamp() + delay);
+    } else
+        b_transport_recorded(trans, delay);
+}
+
+template <typename TYPES>
+void tlm_recorder<TYPES>::b_transport_recorded(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay) {
     tlm_recording_payload* req{nullptr};
     if(!isRecordingBlockingTxEnabled()) {
         fw_port->b_transport(trans, delay);
         return;
     } else if(!b_streamHandle)
         initialize_streams();
+    if(!filter.pre_check(trans)) {
+        fw_port->b_transport(trans, delay);
+        return;
+    } else if(filter.has_post_check()) {
+        b_transport_post_checked(trans, delay);
+        return;
+    }
     // Get a handle for the new transaction
     SCVNS scv_tr_handle h = b_trHandle[trans.get_command()]->begin_transaction(delay.value(), sc_core::sc_time_stamp());
+    auto const timed_begin = sc_core::sc_time_stamp() + delay;
     /*************************************************************************
      * do the timed notification
      *************************************************************************/
-    if(b_streamHandleTimed) {
+    if(b_streamHandleTimed && enableTimedPeq.value) {
         req = mm::get().allocate();
         req->acquire();
         (*req) = trans;
@@ -369,7 +477,7 @@ template <typename TYPES> void tlm_recorder<TYPES>::b_transport(typename TYPES::
 
     trans.get_extension(preExt);
     if(preExt == nullptr) { // we are the first recording this transaction
-        preExt = new tlm_recording_extension(h, this);
+        preExt = tlm_recording_extension::create(h, this);
         if(trans.has_mm())
             trans.set_auto_extension(preExt);
         else
@@ -384,7 +492,7 @@ template <typename TYPES> void tlm_recorder<TYPES>::b_transport(typename TYPES::
         // clean-up the extension if this is the original creator
         trans.set_extension(static_cast<tlm_recording_extension*>(nullptr));
         if(!trans.has_mm()) {
-            delete preExt;
+            preExt->free();
         }
     } else {
         preExt->txHandle = preTx;
@@ -397,9 +505,56 @@ template <typename TYPES> void tlm_recorder<TYPES>::b_transport(typename TYPES::
     // End the transaction
     b_trHandle[trans.get_command()]->end_transaction(h, delay.value(), sc_core::sc_time_stamp());
     // and now the stuff for the timed tx
-    if(b_streamHandleTimed) {
+    if(req) {
         tlm::tlm_phase end_resp = tlm::END_RESP;
         b_timed_peq.notify(*req, end_resp, delay);
+    } else if(b_streamHandleTimed) {
+        auto* gen = b_trTimedHandle[trans.get_command()];
+        SCVNS scv_tr_handle th = gen->begin_transaction(timed_begin, rel_str(PARENT_CHILD), h);
+        record(th, trans);
+        gen->end_transaction(th, sc_core::sc_time_stamp() + delay);
+    }
+}
+
+template <typename TYPES>
+void tlm_recorder<TYPES>::b_transport_post_checked(typename TYPES::tlm_payload_type& trans, sc_core::sc_time& delay) {
+    auto const start = sc_core::sc_time_stamp();
+    auto const start_delay = delay;
+    fw_port->b_transport(trans, delay);
+    auto const timed_begin = start + start_delay;
+    auto const timed_end = sc_core::sc_time_stamp() + delay;
+    if(!filter.post_check(trans, timed_end > timed_begin ? timed_end - timed_begin : sc_core::SC_ZERO_TIME))
+        return;
+    auto* gen = b_trHandle[trans.get_command()];
+    SCVNS scv_tr_handle h = gen->begin_transaction(start_delay.value(), start);
+    for(auto& extensionRecording : tlm_extension_recording_registry<TYPES>::inst().get())
+        if(extensionRecording)
+            extensionRecording->recordBeginTx(h, trans);
+    record(h, trans);
+    for(auto& extensionRecording : tlm_extension_recording_registry<TYPES>::inst().get())
+        if(extensionRecording)
+            extensionRecording->recordEndTx(h, trans);
+    gen->end_transaction(h, delay.value(), sc_core::sc_time_stamp());
+    if(b_streamHandleTimed) {
+        auto* timed_gen = b_trTimedHandle[trans.get_command()];
+        auto const now = sc_core::sc_time_stamp();
+        if(enableTimedPeq.value && timed_end > now) {
+            // the transaction is known only now, so its timed begin is not recorded later than the current time while
+            // its end is scheduled to be recorded when it is reached
+            SCVNS scv_tr_handle th = timed_gen->begin_transaction(timed_begin < now ? timed_begin : now, rel_str(PARENT_CHILD), h);
+            auto* req = mm::get().allocate();
+            req->acquire();
+            (*req) = trans;
+            req->parent = h;
+            req->id = h.get_id();
+            btx_handle_map[req->id] = th;
+            tlm::tlm_phase end_resp = tlm::END_RESP;
+            b_timed_peq.notify(*req, end_resp, timed_end - now);
+        } else {
+            SCVNS scv_tr_handle th = timed_gen->begin_transaction(timed_begin, rel_str(PARENT_CHILD), h);
+            record(th, trans);
+            timed_gen->end_transaction(th, timed_end);
+        }
     }
 }
 
@@ -413,10 +568,10 @@ template <typename TYPES> void tlm_recorder<TYPES>::btx_cb(tlm_recording_payload
         btx_handle_map[rec_parts.id] = h;
     } break;
     case tlm::END_RESP: {
-        auto it = btx_handle_map.find(rec_parts.id);
-        sc_assert(it != btx_handle_map.end());
-        h = it->second;
-        btx_handle_map.erase(it);
+        auto* it = btx_handle_map.find(rec_parts.id);
+        sc_assert(it != nullptr);
+        h = *it;
+        btx_handle_map.erase(rec_parts.id);
         record(h, rec_parts);
         h.end_transaction();
         rec_parts.release();
@@ -430,10 +585,34 @@ template <typename TYPES> void tlm_recorder<TYPES>::btx_cb(tlm_recording_payload
 template <typename TYPES>
 tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
                                                         sc_core::sc_time& delay) {
+    if(!stats)
+        return nb_transport_fw_recorded(trans, phase, delay);
+    if(phase == tlm::BEGIN_REQ)
+        stats->begin_nb(trans, sc_core::sc_time_stamp() + delay);
+    auto status = nb_transport_fw_recorded(trans, phase, delay);
+    if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+        stats->end_nb(trans, sc_core::sc_time_stamp() + delay);
+    return status;
+}
+
+template <typename TYPES>
+tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw_recorded(typename TYPES::tlm_payload_type& trans,
+                                                                 typename TYPES::tlm_phase_type& phase, sc_core::sc_time& delay) {
     if(!isRecordingNonBlockingTxEnabled())
         return fw_port->nb_transport_fw(trans, phase, delay);
     else if(!nb_streamHandle)
         initialize_streams();
+    if(filter.has_pre_check()) {
+        auto const id = reinterpret_cast<uintptr_t>(&trans);
+        if(phase == tlm::BEGIN_REQ && !filter.pre_check(trans))
+            nbtx_filtered[id] = true;
+        if(nbtx_filtered.find(id)) {
+            auto status = fw_port->nb_transport_fw(trans, phase, delay);
+            if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+                nbtx_filtered.erase(id);
+            return status;
+        }
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
@@ -442,7 +621,7 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payl
     tlm_recording_extension* preExt = nullptr;
     trans.get_extension(preExt);
     if(preExt == nullptr) { // we are the first recording this transaction
-        preExt = new tlm_recording_extension(h, this);
+        preExt = tlm_recording_extension::create(h, this);
         if(trans.has_mm())
             trans.set_auto_extension(preExt);
         else
@@ -461,13 +640,8 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payl
     /*************************************************************************
      * do the timed notification
      *************************************************************************/
-    if(nb_streamHandleTimed) {
-        auto* req = mm::get().allocate();
-        req->acquire();
-        (*req) = trans;
-        req->parent = h;
-        nb_timed_peq.notify(*req, phase, delay);
-    }
+    if(nb_streamHandleTimed)
+        nbtx_timed(trans, phase, h, delay);
     /*************************************************************************
      * do the access
      *************************************************************************/
@@ -487,27 +661,18 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payl
         if(preExt && preExt->get_creator() == this) {
             trans.set_extension(static_cast<tlm_recording_extension*>(nullptr));
             if(!trans.has_mm()) {
-                delete preExt;
+                preExt->free();
             }
         }
         /*************************************************************************
          * do the timed notification if req. finished here
          *************************************************************************/
         if(nb_streamHandleTimed) {
-            tlm_recording_payload* req = mm::get().allocate();
-            req->acquire();
-            (*req) = trans;
-            req->parent = h;
             tlm::tlm_phase end_resp = tlm::END_RESP;
-            nb_timed_peq.notify(*req, (status == tlm::TLM_COMPLETED && phase == tlm::BEGIN_REQ) ? end_resp : phase, delay);
+            nbtx_timed(trans, (status == tlm::TLM_COMPLETED && phase == tlm::BEGIN_REQ) ? end_resp : phase, h, delay);
         }
-    } else if(nb_streamHandleTimed && status == tlm::TLM_UPDATED) {
-        tlm_recording_payload* req = mm::get().allocate();
-        req->acquire();
-        (*req) = trans;
-        req->parent = h;
-        nb_timed_peq.notify(*req, phase, delay);
-    }
+    } else if(nb_streamHandleTimed && status == tlm::TLM_UPDATED)
+        nbtx_timed(trans, phase, h, delay);
     // End the transaction
     nb_trHandle[FW]->end_transaction(h, phase2string(phase));
     return status;
@@ -516,10 +681,27 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payl
 template <typename TYPES>
 tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
                                                         sc_core::sc_time& delay) {
+    if(!stats)
+        return nb_transport_bw_recorded(trans, phase, delay);
+    auto status = nb_transport_bw_recorded(trans, phase, delay);
+    if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+        stats->end_nb(trans, sc_core::sc_time_stamp() + delay);
+    return status;
+}
+
+template <typename TYPES>
+tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw_recorded(typename TYPES::tlm_payload_type& trans,
+                                                                 typename TYPES::tlm_phase_type& phase, sc_core::sc_time& delay) {
     if(!isRecordingNonBlockingTxEnabled())
         return bw_port->nb_transport_bw(trans, phase, delay);
     else if(!nb_streamHandle)
         initialize_streams();
+    if(!nbtx_filtered.empty() && nbtx_filtered.find(reinterpret_cast<uintptr_t>(&trans))) {
+        auto status = bw_port->nb_transport_bw(trans, phase, delay);
+        if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP)
+            nbtx_filtered.erase(reinterpret_cast<uintptr_t>(&trans));
+        return status;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
@@ -541,13 +723,8 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw(typename TYPES::tlm_payl
     /*************************************************************************
      * do the timed notification
      *************************************************************************/
-    if(nb_streamHandleTimed) {
-        tlm_recording_payload* req = mm::get().allocate();
-        req->acquire();
-        (*req) = trans;
-        req->parent = h;
-        nb_timed_peq.notify(*req, phase, delay);
-    }
+    if(nb_streamHandleTimed)
+        nbtx_timed(trans, phase, h, delay);
     /*************************************************************************
      * do the access
      *************************************************************************/
@@ -569,72 +746,85 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw(typename TYPES::tlm_payl
             // clean-up the extension if this is the original creator
             trans.set_extension(static_cast<tlm_recording_extension*>(nullptr));
             if(!trans.has_mm()) {
-                delete preExt;
+                preExt->free();
             }
         }
         /*************************************************************************
          * do the timed notification if req. finished here
          *************************************************************************/
-        if(nb_streamHandleTimed) {
-            tlm_recording_payload* req = mm::get().allocate();
-            req->acquire();
-            (*req) = trans;
-            req->parent = h;
-            nb_timed_peq.notify(*req, phase, delay);
-        }
+        if(nb_streamHandleTimed)
+            nbtx_timed(trans, phase, h, delay);
     }
     return status;
 }
 
+template <typename TYPES>
+void tlm_recorder<TYPES>::nbtx_timed(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type const& phase,
+                                     SCVNS scv_tr_handle const& parent, sc_core::sc_time const& delay) {
+    if(enableTimedPeq.value) {
+        tlm_recording_payload* req = mm::get().allocate();
+        req->acquire();
+        (*req) = trans;
+        req->parent = parent;
+        nb_timed_peq.notify(*req, phase, delay);
+    } else
+        nbtx_record(reinterpret_cast<uintptr_t>(&trans), trans, phase, parent, sc_core::sc_time_stamp() + delay);
+}
+
 template <typename TYPES> void tlm_recorder<TYPES>::nbtx_cb(tlm_recording_payload& rec_parts, const typename TYPES::tlm_phase_type& phase) {
+    nbtx_record(rec_parts.id, rec_parts, phase, rec_parts.parent, sc_core::sc_time_stamp());
+    rec_parts.release();
+}
+
+template <typename TYPES>
+void tlm_recorder<TYPES>::nbtx_record(uint64_t id, tlm::tlm_generic_payload const& trans, tlm::tlm_phase const& phase,
+                                      SCVNS scv_tr_handle const& parent, sc_core::sc_time const& t) {
     SCVNS scv_tr_handle h;
-    std::unordered_map<uint64_t, SCVNS scv_tr_handle>::iterator it;
+    SCVNS scv_tr_handle* it;
     switch(phase) { // Now process outstanding recordings
     case tlm::BEGIN_REQ:
-        h = nb_trTimedHandle[REQ]->begin_transaction(rel_str(PARENT_CHILD), rec_parts.parent);
-        record(h, rec_parts);
-        nbtx_req_handle_map[rec_parts.id] = h;
+        h = nb_trTimedHandle[REQ]->begin_transaction(t, rel_str(PARENT_CHILD), parent);
+        record(h, trans);
+        nbtx_req_handle_map[id] = h;
         break;
     case tlm::END_REQ:
-        it = nbtx_req_handle_map.find(rec_parts.id);
-        sc_assert(it != nbtx_req_handle_map.end());
-        h = it->second;
-        nbtx_req_handle_map.erase(it);
-        h.end_transaction();
-        nbtx_last_req_handle_map[rec_parts.id] = h;
+        it = nbtx_req_handle_map.find(id);
+        sc_assert(it != nullptr);
+        h = *it;
+        nbtx_req_handle_map.erase(id);
+        nb_trTimedHandle[REQ]->end_transaction(h, t);
+        nbtx_last_req_handle_map[id] = h;
         break;
     case tlm::BEGIN_RESP:
-        it = nbtx_req_handle_map.find(rec_parts.id);
-        if(it != nbtx_req_handle_map.end()) {
-            h = it->second;
-            nbtx_req_handle_map.erase(it);
-            h.end_transaction();
-            nbtx_last_req_handle_map[rec_parts.id] = h;
+        it = nbtx_req_handle_map.find(id);
+        if(it != nullptr) {
+            h = *it;
+            nbtx_req_handle_map.erase(id);
+            nb_trTimedHandle[REQ]->end_transaction(h, t);
+            nbtx_last_req_handle_map[id] = h;
         }
-        h = nb_trTimedHandle[RESP]->begin_transaction(rel_str(PARENT_CHILD), rec_parts.parent);
-        record(h, rec_parts);
-        nbtx_req_handle_map[rec_parts.id] = h;
-        it = nbtx_last_req_handle_map.find(rec_parts.id);
-        if(it != nbtx_last_req_handle_map.end()) {
-            SCVNS scv_tr_handle pred = it->second;
-            nbtx_last_req_handle_map.erase(it);
+        h = nb_trTimedHandle[RESP]->begin_transaction(t, rel_str(PARENT_CHILD), parent);
+        record(h, trans);
+        nbtx_req_handle_map[id] = h;
+        it = nbtx_last_req_handle_map.find(id);
+        if(it != nullptr) {
+            SCVNS scv_tr_handle pred = *it;
+            nbtx_last_req_handle_map.erase(id);
             h.add_relation(rel_str(PREDECESSOR_SUCCESSOR), pred);
         }
         break;
     case tlm::END_RESP:
-        it = nbtx_req_handle_map.find(rec_parts.id);
-        if(it != nbtx_req_handle_map.end()) {
-            h = it->second;
-            nbtx_req_handle_map.erase(it);
-            h.end_transaction();
+        it = nbtx_req_handle_map.find(id);
+        if(it != nullptr) {
+            h = *it;
+            nbtx_req_handle_map.erase(id);
+            nb_trTimedHandle[RESP]->end_transaction(h, t);
         }
         break;
     default:
         // sc_assert(!"phase not supported!");
         break;
     }
-    rec_parts.release();
-    return;
 }
 
 template <typename TYPES> bool tlm_recorder<TYPES>::get_direct_mem_ptr(typename TYPES::tlm_payload_type& trans, tlm::tlm_dmi& dmi_data) {
@@ -62,6 +62,15 @@ public:
         add_attribute(recorder->enableNbTracing);
         add_attribute(recorder->enableTimedTracing);
         add_attribute(recorder->enableDmiTracing);
+        add_attribute(recorder->enableTimedPeq);
+        add_attribute(recorder->sampleRate);
+        add_attribute(recorder->addressRanges);
+        add_attribute(recorder->commands);
+        add_attribute(recorder->errorsOnly);
+        add_attribute(recorder->latencyThreshold);
+        add_attribute(recorder->enableStatistics);
+        add_attribute(recorder->statisticsWindow);
+        add_attribute(recorder->statisticsFile);
         // bind the sockets to the module
         is.bind(*recorder);
         ts.bind(*recorder);
@@ -75,6 +84,8 @@ public:
 
 private:
     void start_of_simulation() override { recorder->initialize_streams(); }
+
+    void end_of_simulation() override { recorder->dump_statistics(); }
 };
 } // namespace scv
 } // namespace scc
@@ -18,6 +18,8 @@
 #define _SCV4TLM_TLM_RECORDING_EXTENSION_H_
 
 #include <array>
+#include <new>
+#include <util/pool_allocator.h>
 #ifdef HAS_SCV
 #include <scv.h>
 #else
@@ -57,7 +59,8 @@ inline const char* rel_str(tx_rel rel) { return (tx_rel_str[rel]); }
  * stores the handle to the generated SCV transaction and
  * forwards it along with the generic payload. If the recorder finds an extension
  * containing a valid handle it links the generated
- * SCV transaction to the found one using the \ref PREDECESSOR_SUCCESSOR relationship
+ * SCV transaction to the found one using the \ref PREDECESSOR_SUCCESSOR relationship.
+ * Extensions obtained from create() are taken from a pool and returned to it by free().
  */
 class tlm_recording_extension : public tlm::tlm_extension<tlm_recording_extension> {
 public:
@@ -86,6 +89,16 @@ public:
     tlm_recording_extension(SCVNS scv_tr_handle handle, void* creator_)
     : txHandle(handle)
     , creator(creator_) {}
+    /*! \brief create an extension using pooled memory
+     *
+     * \param handle is the handle of the created SCV transaction.
+     * \param creator_ is the pointer to the owner of this extension.
+     */
+    static tlm_recording_extension* create(SCVNS scv_tr_handle handle, void* creator_);
+    /*! \brief release the extension, pooled extensions go back to the pool.
+     *
+     */
+    void free() override;
     /*! \brief accessor to the owner, the property is read only.
      *
      */
@@ -98,7 +111,23 @@ public:
 private:
     //! the owner of this transaction
     void* creator;
+    //! true if the memory is owned by the pool
+    bool pooled{false};
 };
+
+inline tlm_recording_extension* tlm_recording_extension::create(SCVNS scv_tr_handle handle, void* creator_) {
+    auto* ret = new(util::pool_allocator<sizeof(tlm_recording_extension)>::get().allocate()) tlm_recording_extension(handle, creator_);
+    ret->pooled = true;
+    return ret;
+}
+
+inline void tlm_recording_extension::free() {
+    if(pooled) {
+        this->~tlm_recording_extension();
+        util::pool_allocator<sizeof(tlm_recording_extension)>::get().free(this);
+    } else
+        delete this;
+}
 } // namespace scv
 } // namespace scc
 } // namespace tlm
@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SYSC_TLM_TLM_RECORDING_FILTER_H_
+#define _SYSC_TLM_TLM_RECORDING_FILTER_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <tlm>
+#include <util/ities.h>
+#include <utility>
+#include <vector>
+
+//! @brief SystemC TLM
+namespace tlm {
+//! @brief SCC TLM utilities
+namespace scc {
+/**
+ * @class tlm_recording_filter
+ * @brief the recording policy of a TLM transaction recorder
+ *
+ * The filter decides which transactions are being recorded. Sampling, address ranges and commands are checked by
+ * pre_check() before a recorder creates any transaction handle. The response status and the latency are only known
+ * once a transaction finished, they are checked by post_check(). Since the handles of a non-blocking transaction need
+ * to be created when its first phase is seen, post checks are applied to blocking transactions only.
+ */
+class tlm_recording_filter {
+public:
+    /**
+     * @fn void configure(unsigned, const std::string&, const std::string&, bool, const sc_core::sc_time&)
+     * @brief sets up the filter, a default constructed filter records all transactions
+     *
+     * @param sample_rate record only every n-th transaction, 0 and 1 record all transactions
+     * @param address_ranges comma separated list of address ranges given as start-end (inclusive) or start+size with
+     * a non-zero size, an empty string matches all addresses
+     * @param commands comma separated list of the commands to record (read, write, ignore), an empty string matches
+     * all commands
+     * @param errors_only record only transactions finishing with an error response
+     * @param latency_threshold record only transactions taking longer than the given time, SC_ZERO_TIME records
+     * transactions of any latency
+     */
+    void configure(unsigned sample_rate, std::string const& address_ranges, std::string const& commands, bool errors_only,
+                   sc_core::sc_time const& latency_threshold) {
+        this->sample_rate = sample_rate > 1 ? sample_rate : 1;
+        sample_cnt = 0;
+        ranges.clear();
+        for(auto& r : util::split(address_ranges, ',')) {
+            auto range = util::trim(r);
+            if(range.empty())
+                continue;
+            char* end = nullptr;
+            auto start = strtoull(range.c_str(), &end, 0);
+            auto last = start;
+            auto valid = true;
+            if(*end == '-') {
+                last = strtoull(end + 1, &end, 0);
+                valid = last >= start;
+            } else if(*end == '+') {
+                auto size = strtoull(end + 1, &end, 0);
+                // a size of 0 would yield an empty range or wrap around to the end of the address space
+                valid = size > 0 && size - 1 <= UINT64_MAX - start;
+                last = start + (size - 1);
+            }
+            if(!*end && valid)
+                ranges.emplace_back(start, last);
+            else {
+                std::stringstream s;
+                s << "Illegal address range '" << range << "' in recording filter";
+                SC_REPORT_ERROR("/SCC/tlm_recording_filter", s.str().c_str());
+            }
+        }
+        cmd_mask = commands.empty() ? ALL_CMDS : 0;
+        for(auto& c : util::split(commands, ',')) {
+            auto cmd = util::trim(c);
+            if(cmd == "read")
+                cmd_mask |= 1U << tlm::TLM_READ_COMMAND;
+            else if(cmd == "write")
+                cmd_mask |= 1U << tlm::TLM_WRITE_COMMAND;
+            else if(cmd == "ignore")
+                cmd_mask |= 1U << tlm::TLM_IGNORE_COMMAND;
+            else if(!cmd.empty()) {
+                std::stringstream s;
+                s << "Illegal command '" << cmd << "' in recording filter";
+                SC_REPORT_ERROR("/SCC/tlm_recording_filter", s.str().c_str());
+            }
+        }
+        this->errors_only = errors_only;
+        this->latency_threshold = latency_threshold;
+        configured = true;
+    }
+    //! true if configure() has been called
+    bool is_configured() const { return configured; }
+    //! true if a transaction might be filtered out by pre_check()
+    bool has_pre_check() const { return sample_rate > 1 || !ranges.empty() || cmd_mask != ALL_CMDS; }
+    //! true if the decision to record a transaction depends on its outcome
+    bool has_post_check() const { return errors_only || latency_threshold > sc_core::SC_ZERO_TIME; }
+    /**
+     * @fn bool pre_check(const tlm::tlm_generic_payload&)
+     * @brief checks the properties known when a transaction starts, to be called once per transaction
+     *
+     * @param gp the payload of the starting transaction
+     * @return true if the transaction shall be recorded
+     */
+    bool pre_check(tlm::tlm_generic_payload const& gp) {
+        if(!(cmd_mask & (1U << gp.get_command())))
+            return false;
+        if(!ranges.empty()) {
+            auto addr = gp.get_address();
+            auto match = false;
+            for(auto& r : ranges)
+                if(addr >= r.first && addr <= r.second) {
+                    match = true;
+                    break;
+                }
+            if(!match)
+                return false;
+        }
+        if(sample_rate > 1) {
+            auto sample = sample_cnt == 0;
+            if(++sample_cnt == sample_rate)
+                sample_cnt = 0;
+            return sample;
+        }
+        return true;
+    }
+    /**
+     * @fn bool post_check(const tlm::tlm_generic_payload&, const sc_core::sc_time&) const
+     * @brief checks the outcome of a finished transaction
+     *
+     * @param gp the payload of the finished transaction
+     * @param latency the time the transaction took
+     * @return true if the transaction shall be recorded
+     */
+    bool post_check(tlm::tlm_generic_payload const& gp, sc_core::sc_time const& latency) const {
+        if(errors_only && gp.get_response_status() == tlm::TLM_OK_RESPONSE)
+            return false;
+        return latency_threshold == sc_core::SC_ZERO_TIME || latency > latency_threshold;
+    }
+
+private:
+    enum { ALL_CMDS = 7 };
+    bool configured{false};
+    unsigned sample_rate{1};
+    unsigned sample_cnt{0};
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+    unsigned cmd_mask{ALL_CMDS};
+    bool errors_only{false};
+    sc_core::sc_time latency_threshold{sc_core::SC_ZERO_TIME};
+};
+} // namespace scc
+} // namespace tlm
+#endif /* _SYSC_TLM_TLM_RECORDING_FILTER_H_ */
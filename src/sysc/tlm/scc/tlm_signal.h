@@ -19,6 +19,7 @@
 
 #include "tlm_signal_gp.h"
 #include "tlm_signal_sockets.h"
+#include <scc/observer.h>
 #include <scc/peq.h>
 
 //! @brief SystemC TLM
@@ -86,7 +87,7 @@ private:
 };
 
 template <typename SIG, typename TYPES, int N> void tlm_signal<SIG, TYPES, N>::trace(sc_core::sc_trace_file* tf) const {
-    sc_trace(tf, value, name());
+    ::scc::sc_trace(tf, value, name());
 }
 
 template <typename SIG, typename TYPES, int N>
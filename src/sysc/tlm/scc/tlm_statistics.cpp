@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "tlm_statistics.h"
+#include <fstream>
+#include <ostream>
+
+namespace tlm {
+namespace scc {
+namespace {
+const std::array<char const*, 3> cmd_names{{"read", "write", "ignore"}};
+
+inline unsigned cmd_idx(tlm::tlm_generic_payload const& gp) {
+    return gp.get_command() < 3 ? static_cast<unsigned>(gp.get_command()) : 2U;
+}
+//! the factor to convert a time value into ps
+inline double ps_per_tick() { return sc_core::sc_get_time_resolution().to_seconds() * 1e12; }
+} // namespace
+
+tlm_statistics::tlm_statistics(std::string const& name, sc_core::sc_time const& window)
+: name(name)
+, window(window > sc_core::SC_ZERO_TIME ? window : sc_core::sc_time(1, sc_core::SC_US)) {}
+
+void tlm_statistics::update_outstanding() {
+    auto now = sc_core::sc_time_stamp();
+    if(now > last_update) {
+        outstanding_area += outstanding * (now - last_update).to_double();
+        last_update = now;
+    }
+}
+
+void tlm_statistics::begin(tlm::tlm_generic_payload const& gp, sc_core::sc_time const& t) {
+    update_outstanding();
+    ++outstanding;
+    if(outstanding > max_outstanding)
+        max_outstanding = outstanding;
+    depth.record(outstanding);
+}
+
+void tlm_statistics::end(tlm::tlm_generic_payload const& gp, sc_core::sc_time const& start, sc_core::sc_time const& t) {
+    update_outstanding();
+    if(outstanding)
+        --outstanding;
+    auto cmd = cmd_idx(gp);
+    latency[cmd].record(t > start ? (t - start).value() : 0);
+    if(gp.is_response_error())
+        ++errors[cmd];
+    if(cmd < 2) {
+        auto it = bytes.emplace(t.value() / window.value(), std::array<uint64_t, 2>{{0, 0}}).first;
+        it->second[cmd] += gp.get_data_length();
+        if(bytes.size() > max_windows) {
+            // double the window length and merge the windows falling into the same new one
+            window = window * 2;
+            std::map<uint64_t, std::array<uint64_t, 2>> merged;
+            for(auto& e : bytes) {
+                auto& m = merged.emplace_hint(merged.end(), e.first / 2, std::array<uint64_t, 2>{{0, 0}})->second;
+                m[0] += e.second[0];
+                m[1] += e.second[1];
+            }
+            bytes.swap(merged);
+        }
+    }
+}
+
+void tlm_statistics::begin_nb(tlm::tlm_generic_payload const& gp, sc_core::sc_time const& t) {
+    nb_start[reinterpret_cast<uintptr_t>(&gp)] = t;
+    begin(gp, t);
+}
+
+void tlm_statistics::end_nb(tlm::tlm_generic_payload const& gp, sc_core::sc_time const& t) {
+    auto id = reinterpret_cast<uintptr_t>(&gp);
+    if(auto* start = nb_start.find(id)) {
+        end(gp, *start, t);
+        nb_start.erase(id);
+    }
+}
+
+void tlm_statistics::dump_json(std::ostream& os) const {
+    auto const scale = ps_per_tick();
+    auto const now = sc_core::sc_time_stamp().to_double();
+    os << "{\n  \"name\": \"" << name << "\",\n  \"time_unit\": \"ps\",\n  \"latency\": {";
+    for(size_t i = 0; i < latency.size(); ++i) {
+        auto& h = latency[i];
+        os << (i ? "," : "") << "\n    \"" << cmd_names[i] << "\": {\"count\": " << h.count() << ", \"errors\": " << errors[i]
+           << ", \"min\": " << h.min() * scale << ", \"max\": " << h.max() * scale << ", \"mean\": " << h.mean() * scale
+           << ", \"p50\": " << h.percentile(50) * scale << ", \"p90\": " << h.percentile(90) * scale
+           << ", \"p99\": " << h.percentile(99) * scale << ", \"p999\": " << h.percentile(99.9) * scale << ", \"buckets\": [";
+        auto first = true;
+        h.for_each_bucket([&os, &first, scale](uint64_t lo, uint64_t hi, uint64_t cnt) {
+            os << (first ? "" : ", ") << "[" << lo * scale << ", " << hi * scale << ", " << cnt << "]";
+            first = false;
+        });
+        os << "]}";
+    }
+    os << "\n  },\n  \"outstanding\": {\"max\": " << max_outstanding << ", \"mean\": "
+       << (now > 0. ? (outstanding_area + outstanding * (now - last_update.to_double())) / now : 0.)
+       << ", \"p50\": " << depth.percentile(50) << ", \"p99\": " << depth.percentile(99) << "},\n  \"bandwidth\": {\"window\": "
+       << window.value() * scale << ", \"windows\": [";
+    auto first = true;
+    for(auto& e : bytes) {
+        os << (first ? "\n    " : ",\n    ") << "[" << e.first * window.value() * scale << ", " << e.second[0] << ", " << e.second[1]
+           << "]";
+        first = false;
+    }
+    os << "\n  ]}\n}\n";
+}
+
+void tlm_statistics::dump_csv(std::ostream& os) const {
+    auto const scale = ps_per_tick();
+    os << "section,key,value1,value2,value3\n";
+    for(size_t i = 0; i < latency.size(); ++i)
+        latency[i].for_each_bucket([&os, &i, scale](uint64_t lo, uint64_t hi, uint64_t cnt) {
+            os << "latency," << cmd_names[i] << "," << lo * scale << "," << hi * scale << "," << cnt << "\n";
+        });
+    depth.for_each_bucket(
+        [&os](uint64_t lo, uint64_t hi, uint64_t cnt) { os << "outstanding,," << lo << "," << hi << "," << cnt << "\n"; });
+    for(auto& e : bytes)
+        os << "bandwidth,," << e.first * window.value() * scale << "," << e.second[0] << "," << e.second[1] << "\n";
+}
+
+void tlm_statistics::dump(std::string const& file_name) const {
+    std::ofstream ofs(file_name);
+    if(!ofs.is_open()) {
+        SC_REPORT_WARNING("/SCC/tlm_statistics", ("Could not open " + file_name).c_str());
+        return;
+    }
+    if(file_name.size() > 4 && file_name.compare(file_name.size() - 4, 4, ".csv") == 0)
+        dump_csv(ofs);
+    else
+        dump_json(ofs);
+}
+} // namespace scc
+} // namespace tlm
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SYSC_TLM_TLM_STATISTICS_H_
+#define _SYSC_TLM_TLM_STATISTICS_H_
+
+#include <array>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <tlm>
+#include <util/hdr_histogram.h>
+#include <util/open_hash_map.h>
+#include <vector>
+
+//! @brief SystemC TLM
+namespace tlm {
+//! @brief SCC TLM utilities
+namespace scc {
+/**
+ * @class tlm_statistics
+ * @brief online transaction statistics of a socket
+ *
+ * The statistics comprise a latency histogram per command, the number of bytes read and written per time window and
+ * a histogram of the number of outstanding transactions. They are maintained independent of any transaction database
+ * and can be dumped as JSON or CSV at any time. Only windows with traffic are stored, if more than max_windows of them
+ * are collected the window length is doubled and neighbouring windows are merged so that the memory stays bounded.
+ */
+class tlm_statistics {
+public:
+    /**
+     * @fn  tlm_statistics(const std::string&, const sc_core::sc_time&)
+     * @brief constructor
+     *
+     * @param name the name of the socket or recorder reported in the dump
+     * @param window the length of the time windows to accumulate the bandwidth in
+     */
+    tlm_statistics(std::string const& name, sc_core::sc_time const& window);
+    /**
+     * @fn void begin(const tlm::tlm_generic_payload&, const sc_core::sc_time&)
+     * @brief notes the start of a transaction
+     *
+     * @param gp the payload of the transaction
+     * @param t the (annotated) time the transaction starts
+     */
+    void begin(tlm::tlm_generic_payload const& gp, sc_core::sc_time const& t);
+    /**
+     * @fn void end(const tlm::tlm_generic_payload&, const sc_core::sc_time&, const sc_core::sc_time&)
+     * @brief notes the end of a transaction started using begin()
+     *
+     * @param gp the payload of the transaction
+     * @param start the (annotated) time the transaction started
+     * @param t the (annotated) time the transaction ends
+     */
+    void end(tlm::tlm_generic_payload const& gp, sc_core::sc_time const& start, sc_core::sc_time const& t);
+    /**
+     * @fn void begin_nb(const tlm::tlm_generic_payload&, const sc_core::sc_time&)
+     * @brief notes the start of a non-blocking transaction, the start time is kept until end_nb() is called
+     */
+    void begin_nb(tlm::tlm_generic_payload const& gp, sc_core::sc_time const& t);
+    /**
+     * @fn void end_nb(const tlm::tlm_generic_payload&, const sc_core::sc_time&)
+     * @brief notes the end of a non-blocking transaction, ignored if the start has not been seen
+     */
+    void end_nb(tlm::tlm_generic_payload const& gp, sc_core::sc_time const& t);
+    //! writes the statistics as JSON object
+    void dump_json(std::ostream& os) const;
+    //! writes the statistics as CSV table with the columns section, key, value1, value2, value3
+    void dump_csv(std::ostream& os) const;
+    //! writes the statistics to the given file, CSV if the name ends with .csv, JSON otherwise
+    void dump(std::string const& file_name) const;
+    //! the maximum number of bandwidth windows being kept
+    static constexpr size_t max_windows = 4096;
+
+private:
+    void update_outstanding();
+    std::string const name;
+    sc_core::sc_time window;
+    std::array<util::hdr_histogram<>, 3> latency;
+    std::array<uint64_t, 3> errors{{0, 0, 0}};
+    //! bytes read and written per time window index, the window starts at index * window
+    std::map<uint64_t, std::array<uint64_t, 2>> bytes;
+    util::hdr_histogram<> depth;
+    unsigned outstanding{0};
+    unsigned max_outstanding{0};
+    //! integral of the number of outstanding transactions over time
+    double outstanding_area{0.};
+    sc_core::sc_time last_update;
+    util::open_hash_map<sc_core::sc_time> nb_start;
+};
+} // namespace scc
+} // namespace tlm
+#endif /* _SYSC_TLM_TLM_STATISTICS_H_ */
@@ -0,0 +1,260 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************
+ *
+ * converts a columnar waveform (CWF) file into VCD or FST. Since the input is randomly accessible the conversion can
+ * be limited to selected signals and a time window, only the blocks covering them are read. The signals are merged
+ * block by block so only one decoded block per signal is held in memory.
+ */
+
+#include <fstapi.h>
+#include <util/cwf_reader.h>
+#include <util/ities.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+struct selected_signal {
+    selected_signal(uint32_t id, std::string const& vcd_id)
+    : id(id)
+    , vcd_id(vcd_id) {}
+    uint32_t id;
+    std::string vcd_id;
+    fstHandle fst_hndl{0};
+    //! the value changes of the signal within the converted time window
+    std::unique_ptr<util::cwf_reader::cursor> changes;
+};
+
+struct scope {
+    std::vector<std::pair<std::string, selected_signal*>> signals;
+    std::map<std::string, std::unique_ptr<scope>> scopes;
+
+    void add(std::vector<std::string>::const_iterator beg, std::vector<std::string>::const_iterator end, selected_signal* s) {
+        if(std::distance(beg, end) == 1)
+            signals.emplace_back(*beg, s);
+        else {
+            auto& sc = scopes[*beg];
+            if(!sc)
+                sc.reset(new scope);
+            sc->add(beg + 1, end, s);
+        }
+    }
+};
+
+std::string vcd_identifier(size_t idx) {
+    std::string ret;
+    do {
+        ret += static_cast<char>('!' + idx % 94);
+        idx /= 94;
+    } while(idx);
+    return ret;
+}
+
+//! the VCD timescale of a time unit given as power of 10 of seconds, e.g. "10 ns" for -8
+std::string timescale_str(int exp) {
+    static char const* const units[] = {"fs", "ps", "ns", "us", "ms", "s"};
+    if(exp < -15 || exp > 2)
+        throw std::runtime_error("Timescale 1e" + std::to_string(exp) + "s cannot be expressed in VCD");
+    auto unit = std::min((exp + 15) / 3, 5);
+    std::ostringstream os;
+    os << (exp + 15 == unit * 3 ? "1" : exp + 15 == unit * 3 + 1 ? "10" : "100") << " " << units[unit];
+    return os.str();
+}
+//! the width a variable is declared with, reals are 64 bit wide in VCD and FST
+unsigned var_width(util::cwf::signal_desc const& desc) { return desc.kind == util::cwf::value_kind::REAL ? 64 : desc.bits; }
+
+struct vcd_writer {
+    FILE* out;
+    util::cwf_reader const& rd;
+
+    void write_scope(scope const& sc) {
+        for(auto& e : sc.signals) {
+            auto& desc = rd.get_signals()[e.second->id];
+            fprintf(out, "$var %s %u %s %s $end\n", desc.kind == util::cwf::value_kind::REAL ? "real" : "wire", var_width(desc),
+                    e.second->vcd_id.c_str(), e.first.c_str());
+        }
+        for(auto& e : sc.scopes) {
+            fprintf(out, "$scope module %s $end\n", e.first.c_str());
+            write_scope(*e.second);
+            fprintf(out, "$upscope $end\n");
+        }
+    }
+    void header(scope const& root) {
+        fprintf(out, "$version\n    converted from CWF\n$end\n$timescale %s $end\n", timescale_str(rd.get_timescale()).c_str());
+        write_scope(root);
+        fprintf(out, "$enddefinitions $end\n");
+    }
+    void time(uint64_t t) { fprintf(out, "#%llu\n", static_cast<unsigned long long>(t)); }
+    void value(selected_signal const& s, util::cwf_reader::value const& v) {
+        auto& desc = rd.get_signals()[s.id];
+        if(desc.kind == util::cwf::value_kind::REAL)
+            fprintf(out, "r%.16g %s\n", v.real, s.vcd_id.c_str());
+        else if(desc.bits == 1)
+            fprintf(out, "%c%s\n", v.bits[0], s.vcd_id.c_str());
+        else {
+            // strip leading zeros like the SCC VCD writers do
+            auto first = v.bits.find_first_not_of('0');
+            auto str = first == std::string::npos ? "0" : v.bits.c_str() + first;
+            fprintf(out, "b%s %s\n", str, s.vcd_id.c_str());
+        }
+    }
+};
+
+struct fst_writer {
+    void* ctx;
+    util::cwf_reader const& rd;
+
+    void write_scope(scope const& sc, char const* name) {
+        fstWriterSetScope(ctx, FST_ST_VCD_SCOPE, name, nullptr);
+        for(auto& e : sc.signals) {
+            auto& desc = rd.get_signals()[e.second->id];
+            e.second->fst_hndl = fstWriterCreateVar(ctx, desc.kind == util::cwf::value_kind::REAL ? FST_VT_VCD_REAL : FST_VT_VCD_WIRE,
+                                                    FST_VD_IMPLICIT, var_width(desc), e.first.c_str(), 0);
+        }
+        for(auto& e : sc.scopes)
+            write_scope(*e.second, e.first.c_str());
+        fstWriterSetUpscope(ctx);
+    }
+    void header(scope const& root) {
+        fstWriterSetPackType(ctx, FST_WR_PT_LZ4);
+        fstWriterSetTimescale(ctx, rd.get_timescale());
+        for(auto& e : root.signals) {
+            auto& desc = rd.get_signals()[e.second->id];
+            e.second->fst_hndl = fstWriterCreateVar(ctx, desc.kind == util::cwf::value_kind::REAL ? FST_VT_VCD_REAL : FST_VT_VCD_WIRE,
+                                                    FST_VD_IMPLICIT, var_width(desc), e.first.c_str(), 0);
+        }
+        for(auto& e : root.scopes)
+            write_scope(*e.second, e.first.c_str());
+    }
+    void time(uint64_t t) { fstWriterEmitTimeChange(ctx, t); }
+    void value(selected_signal const& s, util::cwf_reader::value const& v) {
+        if(rd.get_signals()[s.id].kind == util::cwf::value_kind::REAL)
+            fstWriterEmitValueChange(ctx, s.fst_hndl, &v.real);
+        else
+            fstWriterEmitValueChange(ctx, s.fst_hndl, v.bits.c_str());
+    }
+};
+
+template <typename WRITER> void convert(WRITER& wr, scope const& root, std::vector<selected_signal>& sigs, uint64_t from) {
+    wr.header(root);
+    using entry = std::pair<uint64_t, size_t>;
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue;
+    for(size_t i = 0; i < sigs.size(); ++i)
+        if(sigs[i].changes->next())
+            queue.emplace(std::max(from, sigs[i].changes->time()), i);
+    bool first = true;
+    uint64_t last_time = 0;
+    while(!queue.empty()) {
+        auto e = queue.top();
+        queue.pop();
+        if(first || e.first != last_time) {
+            wr.time(e.first);
+            last_time = e.first;
+            first = false;
+        }
+        auto& s = sigs[e.second];
+        wr.value(s, s.changes->get());
+        if(s.changes->next())
+            queue.emplace(s.changes->time(), e.second);
+        else
+            s.changes.reset();
+    }
+}
+
+void usage(char const* prog) {
+    std::cerr << "Usage: " << prog << " [-l] [-s <regex>]... [-f <from>] [-t <to>] <input.cwf> [<output.vcd|output.fst>]\n"
+              << "  -l          list the signals of the input file\n"
+              << "  -s <regex>  convert only signals matching the regular expression (may be given multiple times)\n"
+              << "  -f <from>   start of the time window in time units of the input file\n"
+              << "  -t <to>     end of the time window in time units of the input file\n";
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::regex> filters;
+    uint64_t from = 0, to = std::numeric_limits<uint64_t>::max();
+    bool list = false;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i) {
+        if(!strcmp(argv[i], "-l"))
+            list = true;
+        else if(!strcmp(argv[i], "-s") && i + 1 < argc)
+            filters.emplace_back(argv[++i]);
+        else if(!strcmp(argv[i], "-f") && i + 1 < argc)
+            from = strtoull(argv[++i], nullptr, 10);
+        else if(!strcmp(argv[i], "-t") && i + 1 < argc)
+            to = strtoull(argv[++i], nullptr, 10);
+        else if(argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else
+            files.emplace_back(argv[i]);
+    }
+    if(files.size() != (list ? 1U : 2U)) {
+        usage(argv[0]);
+        return 1;
+    }
+    try {
+        util::cwf_reader rd(files[0]);
+        auto& descs = rd.get_signals();
+        if(list) {
+            for(auto& d : descs)
+                std::cout << d.name << " [" << d.bits << "]" << (d.kind == util::cwf::value_kind::REAL ? " real" : "") << "\n";
+            return 0;
+        }
+        std::vector<selected_signal> sigs;
+        for(uint32_t id = 0; id < descs.size(); ++id) {
+            auto matches = filters.empty();
+            for(auto& f : filters)
+                if(std::regex_search(descs[id].name, f)) {
+                    matches = true;
+                    break;
+                }
+            if(matches)
+                sigs.emplace_back(id, vcd_identifier(sigs.size()));
+        }
+        scope root;
+        for(auto& s : sigs) {
+            auto hier = util::split(descs[s.id].name, '.');
+            root.add(hier.cbegin(), hier.cend(), &s);
+            s.changes.reset(new util::cwf_reader::cursor(rd, s.id, from, to));
+        }
+        auto const& out_name = files[1];
+        if(out_name.size() > 4 && out_name.compare(out_name.size() - 4, 4, ".fst") == 0) {
+            fst_writer wr{fstWriterCreate(out_name.c_str(), 1), rd};
+            if(!wr.ctx) {
+                std::cerr << "Could not open " << out_name << "\n";
+                return 2;
+            }
+            convert(wr, root, sigs, from);
+            fstWriterClose(wr.ctx);
+        } else {
+            vcd_writer wr{fopen(out_name.c_str(), "w"), rd};
+            if(!wr.out) {
+                std::cerr << "Could not open " << out_name << "\n";
+                return 2;
+            }
+            convert(wr, root, sigs, from);
+            fclose(wr.out);
+        }
+        std::cerr << "converted " << sigs.size() << " signals reading " << rd.get_blocks_read() << " blocks\n";
+    } catch(std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+    return 0;
+}
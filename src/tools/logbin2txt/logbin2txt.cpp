@@ -0,0 +1,357 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************
+ *
+ * converts a binary log written by the SCC report handler into the text format of the SCC log file.
+ */
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+#include <util/log_binary_format.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+namespace lb = util::log_binary;
+
+struct site {
+    uint64_t severity, verbosity, type, file, line, id;
+    //! the format string id of a call site of the formatting logging macros
+    uint64_t format;
+};
+//! the decoding state of the record stream of one thread
+struct thread_state {
+    std::vector<uint8_t> pending;
+    std::vector<std::string> strings{std::string()};
+    std::vector<site> sites;
+    uint64_t cycle_base{0};
+};
+
+class decoder {
+public:
+    decoder(std::istream& is, std::ostream& os)
+    : is(is)
+    , os(os) {
+        std::array<char, sizeof(lb::magic)> m;
+        // the version 1 files are a subset of the current format
+        if(!is.read(m.data(), m.size()) || memcmp(m.data(), lb::magic, m.size() - 1) || m.back() < 1 || m.back() > lb::magic[7])
+            throw std::runtime_error("Not a SCC binary log");
+        uint64_t flags;
+        if(!get(resolution) || !get(width) || !get(flags))
+            throw std::runtime_error("Truncated header");
+        print_delta = flags & lb::PRINT_DELTA;
+        print_severity = flags & lb::PRINT_SEVERITY;
+        scale = 0;
+        for(auto r = resolution; r >= 10 && r % 10 == 0; r /= 10)
+            ++scale;
+    }
+    //! converts all frames and returns the number of messages written
+    uint64_t run() {
+        uint64_t thread, len;
+        while(get(thread)) {
+            if(!get(len))
+                throw std::runtime_error("Truncated frame");
+            if(thread >= threads.size())
+                threads.resize(thread + 1);
+            auto& ts = threads[thread];
+            auto ofs = ts.pending.size();
+            ts.pending.resize(ofs + len);
+            if(!is.read(reinterpret_cast<char*>(ts.pending.data() + ofs), len))
+                throw std::runtime_error("Truncated frame");
+            auto used = decode(ts, ts.pending.data(), ts.pending.data() + ts.pending.size());
+            ts.pending.erase(ts.pending.begin(), ts.pending.begin() + used);
+        }
+        return count;
+    }
+
+private:
+    bool get(uint64_t& v) {
+        v = 0;
+        for(unsigned shift = 0; shift < 64; shift += 7) {
+            auto c = is.get();
+            if(c == std::char_traits<char>::eof())
+                return false;
+            v |= static_cast<uint64_t>(c & 0x7f) << shift;
+            if(!(c & 0x80))
+                return true;
+        }
+        return false;
+    }
+    //! decodes all complete records and returns the number of bytes consumed
+    size_t decode(thread_state& ts, uint8_t const* begin, uint8_t const* end) {
+        auto p = begin;
+        uint64_t len;
+        while(p < end) {
+            auto q = p;
+            if(!lb::get(q, end, len) || static_cast<uint64_t>(end - q) < len)
+                break;
+            dispatch(ts, q, q + len);
+            p = q + len;
+        }
+        return p - begin;
+    }
+
+    static uint64_t next(uint8_t const*& p, uint8_t const* end) {
+        uint64_t v;
+        if(!lb::get(p, end, v))
+            throw std::runtime_error("Truncated log record");
+        return v;
+    }
+
+    static std::string next_string(uint8_t const*& p, uint8_t const* end) {
+        auto len = next(p, end);
+        if(static_cast<uint64_t>(end - p) < len)
+            throw std::runtime_error("Truncated log record");
+        std::string ret(reinterpret_cast<char const*>(p), len);
+        p += len;
+        return ret;
+    }
+
+    std::string const& str(thread_state const& ts, uint64_t id) const {
+        if(id >= ts.strings.size())
+            throw std::runtime_error("Unknown string id in log record");
+        return ts.strings[id];
+    }
+
+    void dispatch(thread_state& ts, uint8_t const* p, uint8_t const* end) {
+        if(p == end)
+            throw std::runtime_error("Empty log record");
+        switch(*p++) {
+        case lb::STRING: {
+            auto id = next(p, end);
+            if(id >= ts.strings.size())
+                ts.strings.resize(id + 1);
+            ts.strings[id] = next_string(p, end);
+        } break;
+        case lb::SITE: {
+            auto id = next(p, end);
+            if(id >= ts.sites.size())
+                ts.sites.resize(id + 1);
+            auto& s = ts.sites[id];
+            s.severity = next(p, end);
+            s.verbosity = next(p, end);
+            s.type = next(p, end);
+            s.file = next(p, end);
+            s.line = next(p, end);
+            s.id = next(p, end);
+            s.format = 0;
+        } break;
+        case lb::FORMAT: {
+            auto id = next(p, end);
+            if(id >= ts.sites.size())
+                ts.sites.resize(id + 1);
+            auto& s = ts.sites[id];
+            s.severity = next(p, end);
+            s.verbosity = next(p, end);
+            s.type = 0;
+            s.file = next(p, end);
+            s.line = next(p, end);
+            s.id = 0;
+            s.format = next(p, end);
+        } break;
+        case lb::ARGS: {
+            auto id = next(p, end);
+            if(id >= ts.sites.size() || !ts.sites[id].format)
+                throw std::runtime_error("Unknown site id in log record");
+            auto& s = ts.sites[id];
+            auto& type = str(ts, next(p, end));
+            auto time = next(p, end);
+            auto delta = next(p, end);
+            write(ts, s, type, time, delta, 0, format(str(ts, s.format), p, end));
+        } break;
+        case lb::DROPPED:
+            os << "[" << next(p, end) << " messages dropped as the log buffer was full]\n";
+            break;
+        case lb::CYCLE:
+            ts.cycle_base = next(p, end);
+            break;
+        case lb::MESSAGE: {
+            auto id = next(p, end);
+            if(id >= ts.sites.size())
+                throw std::runtime_error("Unknown site id in log record");
+            auto time = next(p, end);
+            auto delta = next(p, end);
+            auto proc = next(p, end);
+            auto& s = ts.sites[id];
+            write(ts, s, str(ts, s.type), time, delta, proc, next_string(p, end));
+        } break;
+        default:
+            throw std::runtime_error("Unknown log record");
+        }
+    }
+    //! decodes the arguments of an ARGS record and applies the format string to them
+    static std::string format(std::string const& fmt_str, uint8_t const*& p, uint8_t const* end) {
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        for(auto count = next(p, end); count; --count) {
+            if(p == end)
+                throw std::runtime_error("Truncated log record");
+            switch(*p++) {
+            case lb::INT: {
+                int64_t v;
+                if(!lb::get_signed(p, end, v))
+                    throw std::runtime_error("Truncated log record");
+                store.push_back(static_cast<long long>(v));
+            } break;
+            case lb::UINT:
+                store.push_back(static_cast<unsigned long long>(next(p, end)));
+                break;
+            case lb::DOUBLE: {
+                double v;
+                if(end - p < static_cast<std::ptrdiff_t>(sizeof(double)))
+                    throw std::runtime_error("Truncated log record");
+                memcpy(&v, p, sizeof(double));
+                p += sizeof(double);
+                store.push_back(v);
+            } break;
+            case lb::BOOL:
+                store.push_back(next(p, end) != 0);
+                break;
+            case lb::CHAR:
+                store.push_back(static_cast<char>(next(p, end)));
+                break;
+            case lb::STRING_ARG:
+                store.push_back(next_string(p, end));
+                break;
+            case lb::POINTER:
+                store.push_back(reinterpret_cast<void const*>(static_cast<uintptr_t>(next(p, end))));
+                break;
+            default:
+                throw std::runtime_error("Unknown argument type in log record");
+            }
+        }
+        try {
+            return fmt::vformat(fmt_str, store);
+        } catch(fmt::format_error& e) {
+            return fmt::format("{} [{}]", fmt_str, e.what());
+        }
+    }
+    //! the same scaling as the SCC report handler uses
+    std::string time2string(uint64_t val) const {
+        static const std::array<const char*, 6> time_units{"fs", "ps", "ns", "us", "ms", "s "};
+        static const std::array<uint64_t, 6> multiplier{
+            1ULL, 1000ULL, 1000ULL * 1000, 1000ULL * 1000 * 1000, 1000ULL * 1000 * 1000 * 1000, 1000ULL * 1000 * 1000 * 1000 * 1000};
+        std::ostringstream oss;
+        if(!val)
+            return "0 s ";
+        auto sc = scale;
+        auto tu = sc / 3;
+        while(tu < 5 && (val % 10) == 0) {
+            val /= 10;
+            sc++;
+            tu += (0 == (sc % 3));
+        }
+        for(sc %= 3; sc != 0; sc--)
+            val *= 10;
+        auto const fs_val = val * multiplier[tu];
+        for(int j = multiplier.size() - 1; j >= static_cast<int>(tu); --j) {
+            if(fs_val >= multiplier[j]) {
+                const auto i = val / multiplier[j - tu];
+                const auto f = val % multiplier[j - tu];
+                oss << i << '.' << std::setw(3 * (j - tu)) << std::setfill('0') << std::right << f << ' ' << time_units[j];
+                break;
+            }
+        }
+        return oss.str();
+    }
+    //! the names of the spdlog levels the reports are mapped to
+    static char const* level_name(site const& s) {
+        switch(s.severity) {
+        case 0:
+            return s.verbosity == 400 || s.verbosity == 500 ? "trace" : s.verbosity == 300 ? "debug" : "info";
+        case 1:
+            return "warning";
+        case 2:
+            return "error";
+        default:
+            return "critical";
+        }
+    }
+
+    void write(thread_state const& ts, site const& s, std::string const& type, uint64_t time, uint64_t delta, uint64_t proc,
+               std::string const& msg) {
+        if(print_severity)
+            os << "[" << std::setw(8) << std::setfill(' ') << level_name(s) << "] ";
+        if(ts.cycle_base) {
+            os << "[" << std::setw(7) << std::setfill(' ') << time / ts.cycle_base;
+            if(print_delta)
+                os << "(" << std::setw(5) << delta << ")";
+            os << "]";
+        } else {
+            os << "[" << std::setw(20) << std::setfill(' ') << time2string(time);
+            if(print_delta)
+                os << "(" << std::setw(5) << delta << ")";
+            os << "]";
+        }
+        if(s.id)
+            os << " (" << "IWEF"[s.severity & 3] << s.id - 1 << ") " << type << ": ";
+        else if(width == std::numeric_limits<unsigned>::max())
+            os << " " << type << ": ";
+        else if(width < 7)
+            os << " " << type << ": ";
+        else if(type.size() > width)
+            os << " " << type.substr(0, 3) << "..." << type.substr(type.size() - (width - 6)) << ": ";
+        else
+            os << " " << type << std::string(width - type.size(), ' ') << ": ";
+        os << msg;
+        if(s.severity > 0) {
+            if(s.line)
+                os << "\n         [FILE:" << str(ts, s.file) << ":" << s.line << "]";
+            if(proc)
+                os << "\n         [PROCESS:" << str(ts, proc) << "]";
+        }
+        os << "\n";
+        ++count;
+    }
+
+    std::istream& is;
+    std::ostream& os;
+    uint64_t resolution{1000}, width{24};
+    unsigned scale{0};
+    bool print_delta{false}, print_severity{true};
+    std::vector<thread_state> threads;
+    uint64_t count{0};
+};
+
+void usage(char const* prog) { std::cerr << "Usage: " << prog << " <binary log> [<output file>]\n"; }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if(argc < 2 || argc > 3 || argv[1][0] == '-') {
+        usage(argv[0]);
+        return 1;
+    }
+    std::ifstream ifs(argv[1], std::ios::in | std::ios::binary);
+    if(!ifs.is_open()) {
+        std::cerr << "Could not open " << argv[1] << "\n";
+        return 2;
+    }
+    std::ofstream ofs;
+    if(argc == 3) {
+        ofs.open(argv[2]);
+        if(!ofs.is_open()) {
+            std::cerr << "Could not open " << argv[2] << "\n";
+            return 2;
+        }
+    }
+    try {
+        decoder dec(ifs, argc == 3 ? static_cast<std::ostream&>(ofs) : std::cout);
+        auto count = dec.run();
+        if(argc == 3)
+            std::cerr << "converted " << count << " messages\n";
+    } catch(std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+    return 0;
+}
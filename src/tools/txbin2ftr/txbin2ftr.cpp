@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************
+ *
+ * converts a binary transaction database written by scv_tr_binary into FTR. Using the timing index the conversion
+ * can be limited to the transactions starting in a time window without reading the data before it.
+ */
+
+#include <ftr/ftr_writer.h>
+#include <util/scv_binary_reader.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+namespace txb = util::scv_binary;
+
+ftr::event_type to_event(txb::event_type event) {
+    switch(event) {
+    case txb::BEGIN:
+        return ftr::event_type::BEGIN;
+    case txb::END:
+        return ftr::event_type::END;
+    default:
+        return ftr::event_type::RECORD;
+    }
+}
+
+ftr::data_type to_type(txb::data_type type) {
+    switch(type) {
+    case txb::ENUMERATION:
+        return ftr::data_type::ENUMERATION;
+    case txb::BOOLEAN:
+        return ftr::data_type::BOOLEAN;
+    case txb::UNSIGNED:
+        return ftr::data_type::UNSIGNED;
+    case txb::POINTER:
+        return ftr::data_type::POINTER;
+    case txb::STRING_TYPE:
+        return ftr::data_type::STRING;
+    case txb::FLOATING_POINT_NUMBER:
+        return ftr::data_type::FLOATING_POINT_NUMBER;
+    case txb::BIT_VECTOR:
+        return ftr::data_type::BIT_VECTOR;
+    case txb::LOGIC_VECTOR:
+        return ftr::data_type::LOGIC_VECTOR;
+    default:
+        return ftr::data_type::INTEGER;
+    }
+}
+
+template <bool COMPRESSED>
+uint64_t convert(util::scv_binary_reader const& rd, std::string const& out_name, uint64_t from, uint64_t to) {
+    ftr::ftr_writer<COMPRESSED> wr(out_name);
+    if(!wr.cw.enc.ofs.is_open())
+        throw std::runtime_error("Could not open " + out_name);
+    wr.writeInfo(static_cast<int8_t>(rd.get_time_resolution()));
+    for(auto& s : rd.get_streams())
+        wr.writeStream(s.id, s.name, s.kind);
+    for(auto& g : rd.get_generators())
+        wr.writeGenerator(g.id, g.name, g.stream);
+    auto const windowed = from > 0 || to < std::numeric_limits<uint64_t>::max();
+    // the transactions started within the window, only tracked if a window is given
+    std::unordered_set<uint64_t> open, converted;
+    uint64_t count = 0;
+    util::scv_binary_reader::record rec;
+    for(auto offset = rd.seek(from); rd.next(offset, rec);) {
+        switch(rec.type) {
+        case txb::TX_BEGIN:
+            if(rec.time > to) {
+                if(open.empty())
+                    return count;
+                continue;
+            }
+            if(windowed) {
+                open.insert(rec.id);
+                converted.insert(rec.id);
+            }
+            wr.startTransaction(rec.id, rec.generator, rec.stream, rec.time);
+            ++count;
+            break;
+        case txb::ATTRIBUTE:
+            if(windowed && !open.count(rec.id))
+                continue;
+            if(txb::is_string_type(rec.data_type))
+                wr.writeAttribute(rec.id, to_event(rec.event), *rec.name, to_type(rec.data_type), rec.string_value(rd));
+            else if(rec.data_type == txb::BOOLEAN)
+                wr.writeAttribute(rec.id, to_event(rec.event), *rec.name, to_type(rec.data_type), rec.value != 0);
+            else if(rec.data_type == txb::FLOATING_POINT_NUMBER)
+                wr.writeAttribute(rec.id, to_event(rec.event), *rec.name, to_type(rec.data_type), rec.double_value());
+            else
+                wr.writeAttribute(rec.id, to_event(rec.event), *rec.name, to_type(rec.data_type), static_cast<long long>(rec.value));
+            break;
+        case txb::TX_END:
+            if(windowed && !open.erase(rec.id))
+                continue;
+            wr.endTransaction(rec.id, rec.time);
+            break;
+        case txb::RELATION:
+            if(windowed && (!converted.count(rec.id) || !converted.count(rec.id2)))
+                continue;
+            wr.writeRelation(*rec.name, rec.stream, rec.id, rec.stream2, rec.id2);
+            break;
+        }
+    }
+    return count;
+}
+
+void usage(char const* prog) {
+    std::cerr << "Usage: " << prog << " [-l] [-c] [-f <from>] [-t <to>] <input database> [<output.ftr>]\n"
+              << "  -l          list the streams and generators of the input database\n"
+              << "  -c          write a compressed FTR file\n"
+              << "  -f <from>   convert only transactions starting at or after from (in ps)\n"
+              << "  -t <to>     convert only transactions starting at or before to (in ps)\n";
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t from = 0, to = std::numeric_limits<uint64_t>::max();
+    bool list = false, compressed = false;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i) {
+        if(!strcmp(argv[i], "-l"))
+            list = true;
+        else if(!strcmp(argv[i], "-c"))
+            compressed = true;
+        else if(!strcmp(argv[i], "-f") && i + 1 < argc)
+            from = strtoull(argv[++i], nullptr, 10);
+        else if(!strcmp(argv[i], "-t") && i + 1 < argc)
+            to = strtoull(argv[++i], nullptr, 10);
+        else if(argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else
+            files.emplace_back(argv[i]);
+    }
+    if(files.size() != (list ? 1U : 2U)) {
+        usage(argv[0]);
+        return 1;
+    }
+    try {
+        util::scv_binary_reader rd(files[0]);
+        if(list) {
+            for(auto& s : rd.get_streams()) {
+                std::cout << s.name << " (" << s.kind << ")\n";
+                for(auto& g : rd.get_generators())
+                    if(g.stream == s.id)
+                        std::cout << "    " << g.name << "\n";
+            }
+            std::cout << rd.get_timing_entries() << " transaction events up to " << rd.get_end_time() << "ps\n";
+            return 0;
+        }
+        auto count = compressed ? convert<true>(rd, files[1], from, to) : convert<false>(rd, files[1], from, to);
+        std::cerr << "converted " << count << " transactions\n";
+    } catch(std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+    return 0;
+}
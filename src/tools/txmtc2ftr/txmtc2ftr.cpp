@@ -0,0 +1,242 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************
+ *
+ * converts a sharded transaction database written by scv_tr_mtc (*.txmtc) into FTR. The blocks of all streams are merged in
+ * time order holding only one decoded block per stream in memory. Using the block index the conversion can be limited
+ * to the transactions starting in a time window without decoding the blocks before it.
+ */
+
+#include <ftr/ftr_writer.h>
+#include <util/scv_binary_format.h>
+#include <util/scv_mtc_reader.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+namespace mtc = util::scv_mtc;
+namespace txb = util::scv_binary;
+
+ftr::event_type to_event(mtc::event_type event) {
+    switch(event) {
+    case mtc::BEGIN:
+        return ftr::event_type::BEGIN;
+    case mtc::END:
+        return ftr::event_type::END;
+    default:
+        return ftr::event_type::RECORD;
+    }
+}
+
+ftr::data_type to_type(uint8_t type) {
+    switch(type) {
+    case txb::ENUMERATION:
+        return ftr::data_type::ENUMERATION;
+    case txb::BOOLEAN:
+        return ftr::data_type::BOOLEAN;
+    case txb::UNSIGNED:
+        return ftr::data_type::UNSIGNED;
+    case txb::POINTER:
+        return ftr::data_type::POINTER;
+    case txb::STRING_TYPE:
+        return ftr::data_type::STRING;
+    case txb::FLOATING_POINT_NUMBER:
+        return ftr::data_type::FLOATING_POINT_NUMBER;
+    case txb::BIT_VECTOR:
+        return ftr::data_type::BIT_VECTOR;
+    case txb::LOGIC_VECTOR:
+        return ftr::data_type::LOGIC_VECTOR;
+    default:
+        return ftr::data_type::INTEGER;
+    }
+}
+//! iterates over the records of the blocks [next_block, end_block) of one stream
+struct cursor {
+    uint64_t stream;
+    size_t next_block, end_block;
+    std::vector<util::scv_mtc_reader::record> recs;
+    size_t pos{0};
+
+    cursor(uint64_t stream, size_t first_block, size_t end_block)
+    : stream(stream)
+    , next_block(first_block)
+    , end_block(end_block) {}
+
+    util::scv_mtc_reader::record const& current() const { return recs[pos]; }
+    //! moves to the next record, returns false if the stream has no more records
+    bool advance(util::scv_mtc_reader const& rd) {
+        if(++pos < recs.size())
+            return true;
+        while(next_block < end_block) {
+            rd.read_block(rd.get_blocks()[next_block++], recs);
+            pos = 0;
+            if(recs.size())
+                return true;
+        }
+        return false;
+    }
+};
+
+struct later {
+    bool operator()(cursor const* a, cursor const* b) const {
+        return a->current().time != b->current().time ? a->current().time > b->current().time : a->stream > b->stream;
+    }
+};
+
+//! writes the relations between converted transactions, rel_streams maps the transactions to their stream if converted
+template <bool COMPRESSED>
+uint64_t write_relations(util::scv_mtc_reader const& rd, ftr::ftr_writer<COMPRESSED>& wr,
+                         std::unordered_map<uint64_t, uint64_t> const& rel_streams, uint64_t count) {
+    for(auto& r : rd.get_relations()) {
+        auto sink = rel_streams.at(r.sink), source = rel_streams.at(r.source);
+        if(sink != std::numeric_limits<uint64_t>::max() && source != std::numeric_limits<uint64_t>::max())
+            wr.writeRelation(rd.get_string(r.name), sink, r.sink, source, r.source);
+    }
+    return count;
+}
+
+template <bool COMPRESSED> uint64_t convert(util::scv_mtc_reader const& rd, std::string const& out_name, uint64_t from, uint64_t to) {
+    ftr::ftr_writer<COMPRESSED> wr(out_name);
+    if(!wr.cw.enc.ofs.is_open())
+        throw std::runtime_error("Could not open " + out_name);
+    wr.writeInfo(static_cast<int8_t>(rd.get_time_resolution()));
+    for(auto& s : rd.get_streams())
+        wr.writeStream(s.id, s.name, s.kind);
+    for(auto& g : rd.get_generators())
+        wr.writeGenerator(g.id, g.name, g.stream);
+    auto const windowed = from > 0 || to < std::numeric_limits<uint64_t>::max();
+    // one cursor per stream starting at the first block reaching into the window
+    auto& blocks = rd.get_blocks();
+    std::vector<cursor> cursors;
+    for(size_t i = 0; i < blocks.size();) {
+        auto j = i;
+        while(j < blocks.size() && blocks[j].stream == blocks[i].stream)
+            ++j;
+        auto first = i;
+        while(first < j && blocks[first].last_time < from)
+            ++first;
+        if(first < j && blocks[first].first_time <= to)
+            cursors.emplace_back(blocks[i].stream, first, j);
+        i = j;
+    }
+    std::priority_queue<cursor*, std::vector<cursor*>, later> queue;
+    for(auto& c : cursors)
+        if(c.advance(rd))
+            queue.push(&c);
+    // the streams of the transactions taking part in relations
+    std::unordered_map<uint64_t, uint64_t> rel_streams;
+    for(auto& r : rd.get_relations()) {
+        rel_streams.emplace(r.sink, std::numeric_limits<uint64_t>::max());
+        rel_streams.emplace(r.source, std::numeric_limits<uint64_t>::max());
+    }
+    // the transactions started within the window, only tracked if a window is given
+    std::unordered_set<uint64_t> open;
+    uint64_t count = 0;
+    while(queue.size()) {
+        auto* c = queue.top();
+        queue.pop();
+        auto& rec = c->current();
+        switch(rec.type) {
+        case mtc::TX_BEGIN: {
+            if(rec.time > to && open.empty())
+                return write_relations(rd, wr, rel_streams, count);
+            if(rec.time < from || rec.time > to)
+                break;
+            if(windowed)
+                open.insert(rec.id);
+            wr.startTransaction(rec.id, rec.generator, c->stream, rec.time);
+            auto it = rel_streams.find(rec.id);
+            if(it != rel_streams.end())
+                it->second = c->stream;
+            ++count;
+        } break;
+        case mtc::TX_END:
+            if(windowed && !open.erase(rec.id))
+                break;
+            wr.endTransaction(rec.id, rec.time);
+            break;
+        default:
+            if(windowed && !open.count(rec.id))
+                break;
+            if(rec.type == mtc::ATTR_STRING && rec.data_type == txb::BOOLEAN) // recorded as TRUE resp. FALSE
+                wr.writeAttribute(rec.id, to_event(rec.event), *rec.name, to_type(rec.data_type), rec.string_value(rd) == "TRUE");
+            else if(rec.type == mtc::ATTR_STRING)
+                wr.writeAttribute(rec.id, to_event(rec.event), *rec.name, to_type(rec.data_type), rec.string_value(rd));
+            else if(rec.type == mtc::ATTR_DOUBLE)
+                wr.writeAttribute(rec.id, to_event(rec.event), *rec.name, to_type(rec.data_type), rec.double_value());
+            else
+                wr.writeAttribute(rec.id, to_event(rec.event), *rec.name, to_type(rec.data_type), static_cast<long long>(rec.value));
+        }
+        if(c->advance(rd))
+            queue.push(c);
+    }
+    return write_relations(rd, wr, rel_streams, count);
+}
+
+void usage(char const* prog) {
+    std::cerr << "Usage: " << prog << " [-l] [-c] [-f <from>] [-t <to>] <input database> [<output.ftr>]\n"
+              << "  -l          list the streams and generators of the input database\n"
+              << "  -c          write a compressed FTR file\n"
+              << "  -f <from>   convert only transactions starting at or after from (in time units of the database)\n"
+              << "  -t <to>     convert only transactions starting at or before to (in time units of the database)\n";
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t from = 0, to = std::numeric_limits<uint64_t>::max();
+    bool list = false, compressed = false;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i) {
+        if(!strcmp(argv[i], "-l"))
+            list = true;
+        else if(!strcmp(argv[i], "-c"))
+            compressed = true;
+        else if(!strcmp(argv[i], "-f") && i + 1 < argc)
+            from = strtoull(argv[++i], nullptr, 10);
+        else if(!strcmp(argv[i], "-t") && i + 1 < argc)
+            to = strtoull(argv[++i], nullptr, 10);
+        else if(argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else
+            files.emplace_back(argv[i]);
+    }
+    if(files.size() != (list ? 1U : 2U)) {
+        usage(argv[0]);
+        return 1;
+    }
+    try {
+        util::scv_mtc_reader rd(files[0]);
+        if(!rd.is_complete())
+            std::cerr << files[0] << " has not been closed properly, reading the blocks written so far\n";
+        if(list) {
+            for(auto& s : rd.get_streams()) {
+                std::cout << s.name << " (" << s.kind << ")\n";
+                for(auto& g : rd.get_generators())
+                    if(g.stream == s.id)
+                        std::cout << "    " << g.name << "\n";
+            }
+            uint64_t end_time = 0;
+            for(auto& b : rd.get_blocks())
+                end_time = std::max(end_time, b.last_time);
+            std::cout << rd.get_blocks().size() << " transaction blocks up to " << end_time << " (time unit 1e"
+                      << rd.get_time_resolution() << "s)\n";
+            return 0;
+        }
+        auto count = compressed ? convert<true>(rd, files[1], from, to) : convert<false>(rd, files[1], from, to);
+        std::cerr << "converted " << count << " transactions\n";
+    } catch(std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+    return 0;
+}
@@ -54,9 +54,11 @@
 #include "scv_tr.h"
 
 #include "scv_report.h"
-#include <list>
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 namespace scv_tr {
 
 // ----------------------------------------------------------------------------
@@ -81,22 +83,64 @@ static void scv_tr_null_scv_tr_db_message() {
 
 using _scv_tr_void_function_t = void();
 
-class _scv_tr_callback_item_t {
+struct _scv_tr_callback_item_t {
+    int id;
+    void* callback_fp;
+    void* user_data_p;
+};
+
+// The callbacks of a class are kept as immutable snapshot in a flat vector. Registering or removing a callback
+// creates a new snapshot (copy on write) so that processing the callbacks needs neither checks for removed entries
+// nor any locking. Replaced snapshots are kept alive until the list is destroyed since they might still be iterated
+// by a callback currently being processed. As callbacks are registered and removed only a few times per simulation
+// this does not add up.
+class _scv_tr_callback_list {
 public:
-    _scv_tr_callback_item_t() {
-        id_counter++;
-        this->id = id_counter;
+    using snapshot_t = std::vector<_scv_tr_callback_item_t>;
+
+    _scv_tr_callback_list() { publish(new snapshot_t); }
+
+    const snapshot_t& get() const { return *current; }
+
+    int add(void* callback_fp, void* user_data_p) {
+        auto* next = new snapshot_t(*current);
+        next->push_back({++id_counter, callback_fp, user_data_p});
+        publish(next);
+        return id_counter;
+    }
+
+    bool remove(int id) {
+        auto it = std::find_if(current->begin(), current->end(), [id](const _scv_tr_callback_item_t& e) { return e.id == id; });
+        if(it == current->end())
+            return false;
+        auto* next = new snapshot_t(current->begin(), it);
+        next->insert(next->end(), it + 1, current->end());
+        publish(next);
+        return true;
     }
 
+private:
+    void publish(snapshot_t* next) {
+        snapshots.emplace_back(next);
+        current = next;
+    }
     static int id_counter;
-    int id;
-    void* callback_fp{nullptr};
-    void* user_data_p{nullptr};
+    snapshot_t* current{nullptr};
+    // all snapshots ever published, the last one being the current one
+    std::vector<std::unique_ptr<snapshot_t>> snapshots;
 };
 
-int _scv_tr_callback_item_t::id_counter = 0;
+int _scv_tr_callback_list::id_counter = 0;
 
-using _scv_tr_callback_list = std::list<_scv_tr_callback_item_t*>;
+static int _scv_tr_add_callback(_scv_tr_callback_list*& callback_list_p, void* callback_fp, void* user_data_p) {
+    if(callback_list_p == nullptr)
+        callback_list_p = new _scv_tr_callback_list;
+    return callback_list_p->add(callback_fp, user_data_p);
+}
+
+static bool _scv_tr_remove_callback(_scv_tr_callback_list* callback_list_p, int id) {
+    return callback_list_p != nullptr && callback_list_p->remove(id);
+}
 
 // ----------------------------------------------------------------------------
 
@@ -290,139 +334,53 @@ _scv_tr_handle_core::~_scv_tr_handle_core() = default;
 // ----------------------------------------------------------------------------
 
 template <class object_class_parameter_t, typename callback_reason_parameter_t, typename callback_function_parameter_t>
-static void process_callbacks(const object_class_parameter_t& obj, _scv_tr_callback_list* callback_list_p,
-                              callback_reason_parameter_t callback_reason) {
+static inline void process_callbacks(const object_class_parameter_t& obj, _scv_tr_callback_list* callback_list_p,
+                                     callback_reason_parameter_t callback_reason) {
     // This is a template function that processes callbacks for different
     // scv_tr_... classes.
 
-    if(callback_list_p != nullptr) {
-        bool need_cleanup = false;
-
-        auto i = callback_list_p->begin();
-
-        for(; i != callback_list_p->end(); i++) {
-            if((*i)->callback_fp == nullptr) {
-                // This callback has been removed, so we need to clean up after
-                // this iterator.  We can't remove it here because that would
-                // corrupt the iterator.
-                need_cleanup = true;
-            } else {
-                auto* my_callback_fp = (callback_function_parameter_t*)((*i)->callback_fp);
-
-                my_callback_fp(obj, callback_reason, (*i)->user_data_p);
-            }
-        }
-
-        while(need_cleanup == true) {
-            // Iterate on the list looking for items that have been marked as
-            // removed, and then remove them.
-
-            i = callback_list_p->begin();
-
-            for(; i != callback_list_p->end(); i++) {
-                if((*i)->callback_fp == nullptr) {
-                    delete *i;
-                    callback_list_p->erase(i);
-                    goto continue_label;
-                }
-            }
-            // If you get here, then there are no more items to remove.
-            need_cleanup = false;
-
-        continue_label:;
-        }
+    if(callback_list_p == nullptr)
+        return;
+    auto& cbs = callback_list_p->get();
+    if(cbs.size() == 1) {
+        // the usual case of a single database backend being registered
+        ((callback_function_parameter_t*)cbs[0].callback_fp)(obj, callback_reason, cbs[0].user_data_p);
+        return;
     }
+    for(auto& cb : cbs)
+        ((callback_function_parameter_t*)cb.callback_fp)(obj, callback_reason, cb.user_data_p);
 }
 
 // ----------------------------------------------------------------------------
 
-static void process_record_attribute_callbacks(const scv_tr_handle& obj, const char* attribute_name,
-                                               _scv_tr_callback_list* callback_list_p,
-                                               const scv_extensions_if* my_exts_p) {
+static inline void process_record_attribute_callbacks(const scv_tr_handle& obj, const char* attribute_name,
+                                                      _scv_tr_callback_list* callback_list_p,
+                                                      const scv_extensions_if* my_exts_p) {
     // This function processes record_attribute callbacks.
 
-    if(callback_list_p != nullptr) {
-        bool need_cleanup = false;
-
-        auto i = callback_list_p->begin();
-
-        for(; i != callback_list_p->end(); i++) {
-            if((*i)->callback_fp == nullptr) {
-                // This callback has been removed, so we need to clean up after
-                // this iterator.  We can't remove it here because that would
-                // corrupt the iterator.
-                need_cleanup = true;
-            } else {
-                auto* my_callback_fp = (scv_tr_handle::callback_record_attribute_function*)((*i)->callback_fp);
-                my_callback_fp(obj, attribute_name, my_exts_p, (*i)->user_data_p);
-            }
-        }
-
-        while(need_cleanup == true) {
-            // Iterate on the list looking for items that have been marked as
-            // removed, and then remove them.
-
-            i = callback_list_p->begin();
-
-            for(; i != callback_list_p->end(); i++) {
-                if((*i)->callback_fp == nullptr) {
-                    delete *i;
-                    callback_list_p->erase(i);
-                    goto continue_label;
-                }
-            }
-            // If you get here, then there are no more items to remove.
-            need_cleanup = false;
-
-        continue_label:;
-        }
+    if(callback_list_p == nullptr)
+        return;
+    auto& cbs = callback_list_p->get();
+    if(cbs.size() == 1) {
+        ((scv_tr_handle::callback_record_attribute_function*)cbs[0].callback_fp)(obj, attribute_name, my_exts_p,
+                                                                                 cbs[0].user_data_p);
+        return;
     }
+    for(auto& cb : cbs)
+        ((scv_tr_handle::callback_record_attribute_function*)cb.callback_fp)(obj, attribute_name, my_exts_p, cb.user_data_p);
 }
 
 // ----------------------------------------------------------------------------
 
-static void process_relation_callbacks(const scv_tr_handle& obj, const scv_tr_handle& obj_2,
-                                       _scv_tr_callback_list* callback_list_p,
-                                       scv_tr_relation_handle_t relation_handle) {
+static inline void process_relation_callbacks(const scv_tr_handle& obj, const scv_tr_handle& obj_2,
+                                              _scv_tr_callback_list* callback_list_p,
+                                              scv_tr_relation_handle_t relation_handle) {
     // This is a function that processes callbacks for scv_tr_handle:add_relation
 
-    if(callback_list_p != nullptr) {
-        bool need_cleanup = false;
-
-        auto i = callback_list_p->begin();
-
-        for(; i != callback_list_p->end(); i++) {
-            if((*i)->callback_fp == nullptr) {
-                // This callback has been removed, so we need to clean up after
-                // this iterator.  We can't remove it here because that would
-                // corrupt the iterator.
-                need_cleanup = true;
-            } else {
-                auto* my_callback_fp = (scv_tr_handle::callback_relation_function*)((*i)->callback_fp);
-
-                my_callback_fp(obj, obj_2, (*i)->user_data_p, relation_handle);
-            }
-        }
-
-        while(need_cleanup == true) {
-            // Iterate on the list looking for items that have been marked as
-            // removed, and then remove them.
-
-            i = callback_list_p->begin();
-
-            for(; i != callback_list_p->end(); i++) {
-                if((*i)->callback_fp == nullptr) {
-                    delete *i;
-                    callback_list_p->erase(i);
-                    goto continue_label;
-                }
-            }
-            // If you get here, then there are no more items to remove.
-            need_cleanup = false;
-
-        continue_label:;
-        }
-    }
+    if(callback_list_p == nullptr)
+        return;
+    for(auto& cb : callback_list_p->get())
+        ((scv_tr_handle::callback_relation_function*)cb.callback_fp)(obj, obj_2, cb.user_data_p, relation_handle);
 }
 
 // ----------------------------------------------------------------------------
@@ -461,18 +419,7 @@ scv_tr_db::~scv_tr_db() {
 // ----------------------------------------------------------------------------
 
 scv_tr_db::callback_h scv_tr_db::register_class_cb(scv_tr_db::callback_function* cbf, void* user_data_p) {
-    if(_scv_tr_db_core::callback_list_p == nullptr) {
-        _scv_tr_db_core::callback_list_p = new _scv_tr_callback_list;
-    }
-
-    auto* my_item_p = new _scv_tr_callback_item_t;
-
-    my_item_p->callback_fp = (void*)cbf;
-    my_item_p->user_data_p = (void*)user_data_p;
-
-    _scv_tr_db_core::callback_list_p->push_back(my_item_p);
-
-    return my_item_p->id;
+    return _scv_tr_add_callback(_scv_tr_db_core::callback_list_p, (void*)cbf, user_data_p);
 }
 
 // ----------------------------------------------------------------------------
@@ -525,21 +472,7 @@ const char* scv_tr_db::get_name() const {
 // ----------------------------------------------------------------------------
 
 void scv_tr_db::remove_callback(callback_h h) {
-    _scv_tr_callback_list* my_cb_list_p = _scv_tr_db_core::callback_list_p;
-
-    if(my_cb_list_p == nullptr)
-        return;
-
-    auto i = my_cb_list_p->begin();
-
-    for(; i != my_cb_list_p->end(); i++) {
-        if((*i)->id == h) {
-            // The entry gets deleted the next time callbacks get processed -
-            // you can't delete here because you might currently be in the middle of
-            // a callback, and that would screw up the list if the item were deleted.
-            (*i)->callback_fp = nullptr;
-        }
-    }
+    _scv_tr_remove_callback(_scv_tr_db_core::callback_list_p, h);
 }
 
 // ----------------------------------------------------------------------------
@@ -572,18 +505,7 @@ scv_tr_stream::~scv_tr_stream() {
 // ----------------------------------------------------------------------------
 
 scv_tr_stream::callback_h scv_tr_stream::register_class_cb(scv_tr_stream::callback_function* cbf, void* user_data_p) {
-    if(_scv_tr_stream_core::callback_list_p == nullptr) {
-        _scv_tr_stream_core::callback_list_p = new _scv_tr_callback_list;
-    }
-
-    auto* my_item_p = new _scv_tr_callback_item_t;
-
-    my_item_p->callback_fp = (void*)cbf;
-    my_item_p->user_data_p = (void*)user_data_p;
-
-    _scv_tr_stream_core::callback_list_p->push_back(my_item_p);
-
-    return my_item_p->id;
+    return _scv_tr_add_callback(_scv_tr_stream_core::callback_list_p, (void*)cbf, user_data_p);
 }
 
 // ----------------------------------------------------------------------------
@@ -629,21 +551,7 @@ const char* scv_tr_stream::get_stream_kind() const {
 // ----------------------------------------------------------------------------
 
 void scv_tr_stream::remove_callback(callback_h h) {
-    _scv_tr_callback_list* my_cb_list_p = _scv_tr_stream_core::callback_list_p;
-
-    if(my_cb_list_p == nullptr)
-        return;
-
-    auto i = my_cb_list_p->begin();
-
-    for(; i != my_cb_list_p->end(); i++) {
-        if((*i)->id == h) {
-            // The entry gets deleted the next time callbacks get processed -
-            // you can't delete here because you might currently be in the middle of
-            // a callback, and that would screw up the list if the item were deleted.
-            (*i)->callback_fp = nullptr;
-        }
-    }
+    _scv_tr_remove_callback(_scv_tr_stream_core::callback_list_p, h);
 }
 
 // ----------------------------------------------------------------------------
@@ -723,54 +631,21 @@ void scv_tr_handle::_record_attribute(const char* attribute_name, const scv_exte
 // ----------------------------------------------------------------------------
 
 scv_tr_handle::callback_h scv_tr_handle::register_class_cb(scv_tr_handle::callback_function* cbf, void* user_data_p) {
-    if(_scv_tr_handle_core::callback_list_p == nullptr) {
-        _scv_tr_handle_core::callback_list_p = new _scv_tr_callback_list;
-    }
-
-    auto* my_item_p = new _scv_tr_callback_item_t;
-
-    my_item_p->callback_fp = (void*)cbf;
-    my_item_p->user_data_p = (void*)user_data_p;
-
-    _scv_tr_handle_core::callback_list_p->push_back(my_item_p);
-
-    return my_item_p->id;
+    return _scv_tr_add_callback(_scv_tr_handle_core::callback_list_p, (void*)cbf, user_data_p);
 }
 
 // ----------------------------------------------------------------------------
 
 scv_tr_handle::callback_h
 scv_tr_handle::register_record_attribute_cb(scv_tr_handle::callback_record_attribute_function* cbf, void* user_data_p) {
-    if(_scv_tr_handle_core::callback_record_attribute_list_p == nullptr) {
-        _scv_tr_handle_core::callback_record_attribute_list_p = new _scv_tr_callback_list;
-    }
-
-    auto* my_item_p = new _scv_tr_callback_item_t;
-
-    my_item_p->callback_fp = (void*)cbf;
-    my_item_p->user_data_p = (void*)user_data_p;
-
-    _scv_tr_handle_core::callback_record_attribute_list_p->push_back(my_item_p);
-
-    return my_item_p->id;
+    return _scv_tr_add_callback(_scv_tr_handle_core::callback_record_attribute_list_p, (void*)cbf, user_data_p);
 }
 
 // ----------------------------------------------------------------------------
 
 scv_tr_handle::callback_h scv_tr_handle::register_relation_cb(scv_tr_handle::callback_relation_function* cbf,
                                                               void* user_data_p) {
-    if(_scv_tr_handle_core::callback_relation_list_p == nullptr) {
-        _scv_tr_handle_core::callback_relation_list_p = new _scv_tr_callback_list;
-    }
-
-    auto* my_item_p = new _scv_tr_callback_item_t;
-
-    my_item_p->callback_fp = (void*)cbf;
-    my_item_p->user_data_p = (void*)user_data_p;
-
-    _scv_tr_handle_core::callback_relation_list_p->push_back(my_item_p);
-
-    return my_item_p->id;
+    return _scv_tr_add_callback(_scv_tr_handle_core::callback_relation_list_p, (void*)cbf, user_data_p);
 }
 
 // ----------------------------------------------------------------------------
@@ -908,63 +783,11 @@ const scv_tr_generator_base& scv_tr_handle::get_scv_tr_generator_base() const {
 
 void scv_tr_handle::remove_callback(callback_h h) {
     // There are 3 callback lists in scv_tr_handle
-
-    {
-        _scv_tr_callback_list* my_cb_list_p = _scv_tr_handle_core::callback_list_p;
-
-        if(my_cb_list_p != nullptr) {
-            auto i = my_cb_list_p->begin();
-
-            for(; i != my_cb_list_p->end(); i++) {
-                if((*i)->id == h) {
-                    // The entry gets deleted the next time callbacks get processed -
-                    // you can't delete here because you might currently be in the middle
-                    // of a callback, and that would screw up the list if the item were
-                    // deleted.
-                    (*i)->callback_fp = nullptr;
-                    return;
-                }
-            }
-        }
-    }
-
-    {
-        _scv_tr_callback_list* my_cb_list_p = _scv_tr_handle_core::callback_relation_list_p;
-
-        if(my_cb_list_p != nullptr) {
-            auto i = my_cb_list_p->begin();
-
-            for(; i != my_cb_list_p->end(); i++) {
-                if((*i)->id == h) {
-                    // The entry gets deleted the next time callbacks get processed -
-                    // you can't delete here because you might currently be in the middle
-                    // of a callback, and that would screw up the list if the item were
-                    // deleted.
-                    (*i)->callback_fp = nullptr;
-                    return;
-                }
-            }
-        }
-    }
-
-    {
-        _scv_tr_callback_list* my_cb_list_p = _scv_tr_handle_core::callback_record_attribute_list_p;
-
-        if(my_cb_list_p != nullptr) {
-            auto i = my_cb_list_p->begin();
-
-            for(; i != my_cb_list_p->end(); i++) {
-                if((*i)->id == h) {
-                    // The entry gets deleted the next time callbacks get processed -
-                    // you can't delete here because you might currently be in the middle
-                    // of a callback, and that would screw up the list if the item were
-                    // deleted.
-                    (*i)->callback_fp = nullptr;
-                    return;
-                }
-            }
-        }
-    }
+    if(_scv_tr_remove_callback(_scv_tr_handle_core::callback_list_p, h))
+        return;
+    if(_scv_tr_remove_callback(_scv_tr_handle_core::callback_relation_list_p, h))
+        return;
+    _scv_tr_remove_callback(_scv_tr_handle_core::callback_record_attribute_list_p, h);
 }
 
 // ----------------------------------------------------------------------------
@@ -1085,18 +908,7 @@ scv_tr_generator_base::~scv_tr_generator_base() {
 // ----------------------------------------------------------------------------
 
 scv_tr_db::callback_h scv_tr_generator_base::register_class_cb(callback_function* cbf, void* user_data_p) {
-    if(_scv_tr_generator_core::callback_list_p == nullptr) {
-        _scv_tr_generator_core::callback_list_p = new _scv_tr_callback_list;
-    }
-
-    auto* my_item_p = new _scv_tr_callback_item_t;
-
-    my_item_p->callback_fp = (void*)cbf;
-    my_item_p->user_data_p = (void*)user_data_p;
-
-    _scv_tr_generator_core::callback_list_p->push_back(my_item_p);
-
-    return my_item_p->id;
+    return _scv_tr_add_callback(_scv_tr_generator_core::callback_list_p, (void*)cbf, user_data_p);
 }
 
 // ----------------------------------------------------------------------------
@@ -1201,21 +1013,7 @@ void scv_tr_generator_base::show(int details, int indent) const { this->print(st
 // ----------------------------------------------------------------------------
 
 void scv_tr_generator_base::remove_callback(callback_h h) {
-    _scv_tr_callback_list* my_cb_list_p = _scv_tr_generator_core::callback_list_p;
-
-    if(my_cb_list_p == nullptr)
-        return;
-
-    auto i = my_cb_list_p->begin();
-
-    for(; i != my_cb_list_p->end(); i++) {
-        if((*i)->id == h) {
-            // The entry gets deleted the next time callbacks get processed -
-            // you can't delete here because you might currently be in the middle of
-            // a callback, and that would screw up the list if the item were deleted.
-            (*i)->callback_fp = nullptr;
-        }
-    }
+    _scv_tr_remove_callback(_scv_tr_generator_core::callback_list_p, h);
 }
 
 // ----------------------------------------------------------------------------